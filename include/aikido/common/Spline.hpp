@@ -330,6 +330,41 @@ public:
       || ProblemVector::NeedsToAlign)
 };
 
+/// Computes the coefficients of the linear polynomial that starts at zero and
+/// reaches \c _displacement after \c _duration. This is the closed-form
+/// solution of the two-knot, two-coefficient \c SplineProblem with those
+/// constant constraints.
+///
+/// \param _displacement value of the polynomial at \c _duration
+/// \param _duration duration of the segment, must be positive
+/// \return coefficient matrix with one row per output, ordered by increasing
+/// power of time
+template <class Derived>
+Eigen::Matrix<typename Derived::Scalar, Eigen::Dynamic, Eigen::Dynamic>
+fitLinearSegment(
+    const Eigen::MatrixBase<Derived>& _displacement,
+    typename Derived::Scalar _duration);
+
+/// Computes the coefficients of the cubic Hermite polynomial that starts at
+/// zero with velocity \c _startVelocity and reaches \c _displacement with
+/// velocity \c _endVelocity after \c _duration. This is the closed-form
+/// solution of the two-knot, four-coefficient \c SplineProblem with those
+/// constant constraints.
+///
+/// \param _displacement value of the polynomial at \c _duration
+/// \param _startVelocity first derivative of the polynomial at zero
+/// \param _endVelocity first derivative of the polynomial at \c _duration
+/// \param _duration duration of the segment, must be positive
+/// \return coefficient matrix with one row per output, ordered by increasing
+/// power of time
+template <class Derived1, class Derived2, class Derived3>
+Eigen::Matrix<typename Derived1::Scalar, Eigen::Dynamic, Eigen::Dynamic>
+fitCubicHermiteSegment(
+    const Eigen::MatrixBase<Derived1>& _displacement,
+    const Eigen::MatrixBase<Derived2>& _startVelocity,
+    const Eigen::MatrixBase<Derived3>& _endVelocity,
+    typename Derived1::Scalar _duration);
+
 } // namespace common
 } // namespace aikido
 
@@ -484,5 +484,46 @@ Scalar SplineProblem<Scalar, Index, _NumCoefficients, _NumOutputs, _NumKnots>::
   }
 }
 
+template <class Derived>
+Eigen::Matrix<typename Derived::Scalar, Eigen::Dynamic, Eigen::Dynamic>
+fitLinearSegment(
+    const Eigen::MatrixBase<Derived>& _displacement,
+    typename Derived::Scalar _duration)
+{
+  using Scalar = typename Derived::Scalar;
+
+  Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> coefficients(
+      _displacement.size(), 2);
+  coefficients.col(0).setZero();
+  coefficients.col(1) = _displacement / _duration;
+  return coefficients;
+}
+
+template <class Derived1, class Derived2, class Derived3>
+Eigen::Matrix<typename Derived1::Scalar, Eigen::Dynamic, Eigen::Dynamic>
+fitCubicHermiteSegment(
+    const Eigen::MatrixBase<Derived1>& _displacement,
+    const Eigen::MatrixBase<Derived2>& _startVelocity,
+    const Eigen::MatrixBase<Derived3>& _endVelocity,
+    typename Derived1::Scalar _duration)
+{
+  using Scalar = typename Derived1::Scalar;
+
+  const Scalar duration2 = _duration * _duration;
+  const Scalar duration3 = duration2 * _duration;
+
+  Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> coefficients(
+      _displacement.size(), 4);
+  coefficients.col(0).setZero();
+  coefficients.col(1) = _startVelocity;
+  coefficients.col(2) = (3 * _displacement
+                         - (2 * _startVelocity + _endVelocity) * _duration)
+                        / duration2;
+  coefficients.col(3) = ((_startVelocity + _endVelocity) * _duration
+                         - 2 * _displacement)
+                        / duration3;
+  return coefficients;
+}
+
 } // namespace common
 } // namespace aikido
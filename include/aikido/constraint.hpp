@@ -1,6 +1,7 @@
 #include "constraint/CartesianProductProjectable.hpp"
 #include "constraint/CartesianProductSampleable.hpp"
 #include "constraint/CartesianProductTestable.hpp"
+#include "constraint/Clearance.hpp"
 #include "constraint/CyclicSampleable.hpp"
 #include "constraint/Differentiable.hpp"
 #include "constraint/DifferentiableIntersection.hpp"
@@ -13,6 +14,7 @@
 #include "constraint/Satisfied.hpp"
 #include "constraint/Testable.hpp"
 #include "constraint/TestableIntersection.hpp"
+#include "constraint/dart/CollisionClearance.hpp"
 #include "constraint/dart/CollisionFree.hpp"
 #include "constraint/dart/FrameDifferentiable.hpp"
 #include "constraint/dart/FramePairDifferentiable.hpp"
@@ -47,6 +49,7 @@ using uniform::SO2UniformSampler;
 using uniform::SO3UniformSampler;
 using uniform::SE2BoxConstraint;
 
+using dart::CollisionClearance;
 using dart::CollisionFree;
 using dart::CollisionFreeOutcome;
 using dart::FrameDifferentiable;
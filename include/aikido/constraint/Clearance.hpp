@@ -0,0 +1,37 @@
+#ifndef AIKIDO_CONSTRAINT_CLEARANCE_HPP_
+#define AIKIDO_CONSTRAINT_CLEARANCE_HPP_
+
+#include "aikido/common/pointers.hpp"
+#include "../statespace/StateSpace.hpp"
+
+namespace aikido {
+namespace constraint {
+
+AIKIDO_DECLARE_POINTERS(Clearance)
+
+/// Lower bound on how far a state is from violating a constraint. It lets
+/// feasibility checkers skip the states that are known to be feasible
+/// instead of testing them one by one.
+class Clearance
+{
+public:
+  virtual ~Clearance() = default;
+
+  /// Returns a radius r such that every state whose displacement from
+  /// \c _state, expressed in the tangent space by \c StateSpace::logMap(),
+  /// is at most r in every dimension satisfies the constraint. Returns zero
+  /// if no such radius is known, e.g. because \c _state is in contact.
+  ///
+  /// \param _state state to compute the clearance of
+  /// \return clearance of \c _state in the infinity norm
+  virtual double getClearance(
+      const statespace::StateSpace::State* _state) const = 0;
+
+  /// Returns StateSpace in which this clearance is defined.
+  virtual statespace::StateSpacePtr getStateSpace() const = 0;
+};
+
+} // namespace constraint
+} // namespace aikido
+
+#endif // AIKIDO_CONSTRAINT_CLEARANCE_HPP_
@@ -0,0 +1,98 @@
+#ifndef AIKIDO_CONSTRAINT_DART_COLLISIONCLEARANCE_HPP_
+#define AIKIDO_CONSTRAINT_DART_COLLISIONCLEARANCE_HPP_
+
+#include <memory>
+#include <vector>
+#include <Eigen/Dense>
+#include <dart/collision/CollisionDetector.hpp>
+#include <dart/collision/CollisionGroup.hpp>
+#include <dart/collision/DistanceFilter.hpp>
+#include <dart/collision/DistanceOption.hpp>
+#include "aikido/common/pointers.hpp"
+#include "aikido/constraint/Clearance.hpp"
+#include "aikido/statespace/dart/MetaSkeletonStateSpace.hpp"
+
+namespace aikido {
+namespace constraint {
+namespace dart {
+
+AIKIDO_DECLARE_POINTERS(CollisionClearance)
+
+/// Clearance of a metaskeleton configuration from collision, computed with
+/// distance queries between and within collision groups.
+///
+/// The minimum distance between the checked groups is converted into a
+/// clearance in configuration space with per-joint displacement bounds: the
+/// bound of a joint is the largest distance that any point of the checked
+/// bodies can move when that joint moves by one unit, e.g. the reach of the
+/// bodies beyond a revolute joint. Moving every joint by at most r then moves
+/// any point by at most r times the sum of the bounds.
+///
+/// The collision detector must support distance queries (e.g.
+/// FCLCollisionDetector). Register the same checks as the \c CollisionFree
+/// constraint it accompanies.
+class CollisionClearance : public Clearance
+{
+public:
+  /// \param _metaSkeletonStateSpace state space on which the clearance is
+  /// defined
+  /// \param _metaskeleton MetaSkeleton to compute distances with
+  /// \param _collisionDetector collision detector used to compute distances
+  /// \param _displacementBounds displacement bound for each dimension of
+  /// \c _metaSkeletonStateSpace
+  /// \param _distanceOptions options passed to \c _collisionDetector
+  CollisionClearance(
+      statespace::dart::MetaSkeletonStateSpacePtr _metaSkeletonStateSpace,
+      ::dart::dynamics::MetaSkeletonPtr _metaskeleton,
+      std::shared_ptr<::dart::collision::CollisionDetector> _collisionDetector,
+      const Eigen::VectorXd& _displacementBounds,
+      ::dart::collision::DistanceOption _distanceOptions
+      = ::dart::collision::DistanceOption(
+          false,
+          0.0,
+          std::make_shared<::dart::collision::BodyNodeDistanceFilter>()));
+
+  // Documentation inherited.
+  double getClearance(
+      const statespace::StateSpace::State* _state) const override;
+
+  // Documentation inherited.
+  statespace::StateSpacePtr getStateSpace() const override;
+
+  /// Returns the minimum distance between the checked groups at \c _state.
+  /// \param _state state to compute the distance at
+  double getDistance(const statespace::StateSpace::State* _state) const;
+
+  /// Computes distances between group1 and group2.
+  /// \param _group1 First collision group.
+  /// \param _group2 Second collision group.
+  void addPairwiseCheck(
+      std::shared_ptr<::dart::collision::CollisionGroup> _group1,
+      std::shared_ptr<::dart::collision::CollisionGroup> _group2);
+
+  /// Computes distances within group.
+  /// \param _group Collision group.
+  void addSelfCheck(std::shared_ptr<::dart::collision::CollisionGroup> _group);
+
+private:
+  using CollisionGroup = ::dart::collision::CollisionGroup;
+
+  aikido::statespace::dart::MetaSkeletonStateSpacePtr mMetaSkeletonStateSpace;
+  ::dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
+  std::shared_ptr<::dart::collision::CollisionDetector> mCollisionDetector;
+  ::dart::collision::DistanceOption mDistanceOptions;
+
+  /// Sum of the displacement bounds.
+  double mDisplacementBound;
+
+  std::vector<std::pair<std::shared_ptr<CollisionGroup>,
+                        std::shared_ptr<CollisionGroup>>>
+      mGroupsToPairwiseCheck;
+  std::vector<std::shared_ptr<CollisionGroup>> mGroupsToSelfCheck;
+};
+
+} // namespace dart
+} // namespace constraint
+} // namespace aikido
+
+#endif // AIKIDO_CONSTRAINT_DART_COLLISIONCLEARANCE_HPP_
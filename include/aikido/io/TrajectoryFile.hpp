@@ -0,0 +1,84 @@
+#ifndef AIKIDO_IO_TRAJECTORYFILE_HPP_
+#define AIKIDO_IO_TRAJECTORYFILE_HPP_
+
+#include <cstdint>
+#include <string>
+#include "aikido/statespace/StateSpace.hpp"
+#include "aikido/trajectory/Interpolated.hpp"
+#include "aikido/trajectory/PackedSpline.hpp"
+#include "aikido/trajectory/Spline.hpp"
+
+namespace aikido {
+namespace io {
+
+/// Version of the binary trajectory format written by \c writeTrajectory().
+constexpr std::uint32_t TRAJECTORY_FILE_VERSION = 1;
+
+/// Writes a spline trajectory to a binary file that can be read back with
+/// \c readTrajectory().
+///
+/// The file starts with a fixed-size header holding the format version, the
+/// kind of trajectory, and a signature of the state space, followed by the
+/// knot times and the coefficients of all segments in the layout of
+/// \c trajectory::PackedSpline. All arrays are 8-byte aligned and stored in
+/// the byte order of the writing machine.
+///
+/// Only the state spaces supported by \c trajectory::PackedSpline can be
+/// written, since the coefficients are stored in their log-map coordinates.
+///
+/// \param[in] path Path of the file to write.
+/// \param[in] trajectory Trajectory to write.
+/// \throws std::invalid_argument if the state space is not supported.
+/// \throws std::runtime_error if the file cannot be written.
+void writeTrajectory(
+    const std::string& path, const trajectory::PackedSpline& trajectory);
+
+/// Writes a spline trajectory to a binary file. This converts \c trajectory to
+/// a \c trajectory::PackedSpline and writes that.
+///
+/// \param[in] path Path of the file to write.
+/// \param[in] trajectory Trajectory to write.
+/// \throws std::invalid_argument if the state space is not supported.
+/// \throws std::runtime_error if the file cannot be written.
+void writeTrajectory(
+    const std::string& path, const trajectory::Spline& trajectory);
+
+/// Writes an interpolated trajectory to a binary file that can be read back
+/// with \c readTrajectory(). Geodesic interpolation is linear in the supported
+/// state spaces, so this writes a spline with one linear segment per pair of
+/// consecutive waypoints. Reading it back produces the same values between
+/// the first and the last waypoint, but the derivatives of the spline do not
+/// drop to zero at or outside of them.
+///
+/// Only trajectories that use a \c statespace::GeodesicInterpolator in a
+/// state space supported by \c trajectory::PackedSpline, and that have at
+/// least two waypoints at increasing times, can be written.
+///
+/// \param[in] path Path of the file to write.
+/// \param[in] trajectory Trajectory to write.
+/// \throws std::invalid_argument if the state space, the interpolator or the
+/// waypoints are not supported.
+/// \throws std::runtime_error if the file cannot be written.
+void writeTrajectory(
+    const std::string& path, const trajectory::Interpolated& trajectory);
+
+/// Maps a trajectory file written by \c writeTrajectory() into memory.
+///
+/// The returned trajectory views the segments in the mapped file without
+/// copying them, and keeps the file mapped for as long as it exists. It
+/// produces the same values as the spline that was written.
+///
+/// \param[in] path Path of the file to read.
+/// \param[in] stateSpace State space of the trajectory. Its signature must
+/// match the one stored in the file.
+/// \return Trajectory backed by the mapped file.
+/// \throws std::invalid_argument if \c stateSpace does not match the file.
+/// \throws std::runtime_error if the file cannot be mapped, has an unknown
+/// version, or is malformed.
+trajectory::PackedSplinePtr readTrajectory(
+    const std::string& path, statespace::ConstStateSpacePtr stateSpace);
+
+} // namespace io
+} // namespace aikido
+
+#endif // AIKIDO_IO_TRAJECTORYFILE_HPP_
@@ -12,5 +12,8 @@
 #include "planner/ompl/StateSampler.hpp"
 #include "planner/ompl/StateValidityChecker.hpp"
 #include "planner/ompl/dart.hpp"
+#include "planner/parabolic/OnlineShortcutTrajectory.hpp"
 #include "planner/parabolic/ParabolicSmoother.hpp"
 #include "planner/parabolic/ParabolicTimer.hpp"
+#include "planner/scurve/SCurveTimer.hpp"
+#include "planner/toppra/ToppraTimer.hpp"
@@ -0,0 +1,83 @@
+#ifndef AIKIDO_PLANNER_TRAJECTORYCOMPRESSION_HPP_
+#define AIKIDO_PLANNER_TRAJECTORYCOMPRESSION_HPP_
+
+#include <memory>
+#include <Eigen/Core>
+#include "../constraint/Testable.hpp"
+#include "../trajectory/Interpolated.hpp"
+#include "../trajectory/Spline.hpp"
+
+namespace aikido {
+namespace planner {
+
+/// Default resolution, as a fraction of a merged segment, at which
+/// \c compressTrajectory() checks the constraint along the segment.
+constexpr double DEFAULT_COMPRESSION_CHECK_RESOLUTION = 1e-2;
+
+/// Compresses an interpolated trajectory by dropping waypoints. Starting from
+/// the first waypoint, the next kept waypoint is a far one such that
+/// interpolating directly to it deviates from \c trajectory by at most
+/// \c tolerance along every dimension. It is found by doubling the number of
+/// skipped waypoints until the deviation is too large and then bisecting, so
+/// it is the farthest such waypoint unless a shorter skip fails where a longer
+/// one succeeds. The first and last waypoints are always kept, as are their
+/// times.
+///
+/// The deviation between two states is the log map of the state of
+/// \c trajectory relative to the state of the compressed trajectory. It is
+/// checked at each dropped waypoint and at the middle of each original
+/// segment, which is exact for a \c GeodesicInterpolator in a state space
+/// whose log map is linear, such as \c Rn and \c SO2.
+///
+/// \param trajectory trajectory to compress
+/// \param tolerance maximum deviation along each dimension of the state space
+/// \param constraint optional constraint that every new segment must satisfy.
+/// The kept waypoints are not checked, since they are states of
+/// \c trajectory.
+/// \param checkResolution resolution, as a fraction of a new segment, at which
+/// \c constraint is checked along it
+/// \return compressed trajectory with the same interpolator as \c trajectory
+/// \throws std::invalid_argument if \c tolerance does not match the dimension
+/// of the state space or is negative, if \c constraint is not in the state
+/// space of \c trajectory, or if \c checkResolution is not positive.
+std::unique_ptr<trajectory::Interpolated> compressTrajectory(
+    const trajectory::Interpolated& trajectory,
+    const Eigen::VectorXd& tolerance,
+    const constraint::TestablePtr& constraint = nullptr,
+    double checkResolution = DEFAULT_COMPRESSION_CHECK_RESOLUTION);
+
+/// Compresses a spline trajectory by merging consecutive segments. A run of
+/// segments is replaced by a single polynomial that matches the position and
+/// the derivatives of the run at both of its ends, up to the first derivative
+/// for splines of degree two and three and up to the second derivative for
+/// splines of higher degree, so the compressed trajectory is as smooth as
+/// \c trajectory at the segment boundaries. Runs are grown for as long as the
+/// merged polynomial deviates from \c trajectory by at most \c tolerance
+/// along every dimension, by doubling their length and then bisecting as in
+/// the \c Interpolated overload.
+///
+/// The deviation is measured as in the \c Interpolated overload, at the
+/// boundaries of the original segments and at evenly spaced times inside each
+/// of them.
+///
+/// \param trajectory trajectory to compress
+/// \param tolerance maximum deviation along each dimension of the state space
+/// \param constraint optional constraint that every merged segment must
+/// satisfy
+/// \param checkResolution resolution, as a fraction of a merged segment, at
+/// which \c constraint is checked along it
+/// \return compressed trajectory with the same start and end time as
+/// \c trajectory
+/// \throws std::invalid_argument if \c tolerance does not match the dimension
+/// of the state space or is negative, if \c constraint is not in the state
+/// space of \c trajectory, or if \c checkResolution is not positive.
+std::unique_ptr<trajectory::Spline> compressTrajectory(
+    const trajectory::Spline& trajectory,
+    const Eigen::VectorXd& tolerance,
+    const constraint::TestablePtr& constraint = nullptr,
+    double checkResolution = DEFAULT_COMPRESSION_CHECK_RESOLUTION);
+
+} // namespace planner
+} // namespace aikido
+
+#endif // AIKIDO_PLANNER_TRAJECTORYCOMPRESSION_HPP_
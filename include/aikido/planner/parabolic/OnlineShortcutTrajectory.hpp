@@ -0,0 +1,191 @@
+#ifndef AIKIDO_PLANNER_PARABOLIC_ONLINESHORTCUTTRAJECTORY_HPP_
+#define AIKIDO_PLANNER_PARABOLIC_ONLINESHORTCUTTRAJECTORY_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Eigen/Dense>
+#include "aikido/common/RNG.hpp"
+#include "aikido/constraint/Clearance.hpp"
+#include "aikido/constraint/Testable.hpp"
+#include "aikido/planner/parabolic/ParabolicSmoother.hpp"
+#include "aikido/trajectory/Spline.hpp"
+#include "aikido/trajectory/Trajectory.hpp"
+
+namespace ParabolicRamp {
+class DynamicPath;
+} // namespace ParabolicRamp
+
+namespace aikido {
+namespace planner {
+namespace parabolic {
+
+constexpr double DEFAULT_LEAD_TIME = 0.2;
+
+/// Trajectory that is shortcut in a background thread while it is being
+/// executed.
+///
+/// The trajectory starts out as \c _inputTrajectory, typically the output
+/// of \c computeParabolicTiming(), so execution can begin without waiting
+/// for smoothing. Once \c start() is called, a background thread repeatedly
+/// samples two times after the part of the trajectory that may already have
+/// been executed, plus a safety lead time, and tries to connect them with a
+/// time-optimal parabolic spline, as \c doShortcut() does. Each feasible
+/// shortcut is spliced into the trajectory only if it still starts after the
+/// lead time when it is ready, so the part of the trajectory that is being
+/// executed never changes. Only the segments after the start of the
+/// shortcut are replaced. The end time of the trajectory decreases as
+/// shortcuts are found.
+///
+/// The execution time is measured by the wall clock from the call to
+/// \c start(), which must therefore coincide with the start of execution.
+/// Evaluating the trajectory from any thread is safe while shortcutting.
+///
+/// \c _feasibilityCheck and \c _clearance are only used by the background
+/// thread, but that thread runs concurrently with the executor. For
+/// collision constraints, this means that they must be defined on a clone of
+/// the skeletons that the executor does not move (e.g. created with
+/// \c World::clone()).
+class OnlineShortcutTrajectory : public trajectory::Trajectory
+{
+public:
+  /// \param _inputTrajectory input trajectory with acceleration limits
+  /// \param _feasibilityCheck Check whether a position is feasible
+  /// \param _maxVelocity maximum velocity for each dimension
+  /// \param _maxAcceleration maximum acceleration for each dimension
+  /// \param _rng A random generator for sampling time in shortcut. It is
+  /// cloned, so it is not used by the background thread.
+  /// \param _leadTime how far ahead of the execution time shortcuts must
+  /// start
+  /// \param _timelimit The maximum time to allow for doing shortcut
+  /// \param _checkResolution the resolution in discretizing a segment in
+  /// checking the feasibility of the segment
+  /// \param _tolerance this tolerance is used in a piecewise linear
+  /// discretization that deviates no more than \c _tolerance
+  /// from the parabolic ramp along any axis, and then checks for
+  /// configuration and segment feasibility along that piecewise linear path.
+  /// \param _clearance If not nullptr, segments are only checked at
+  /// \c _checkResolution where the clearance of their ends does not prove
+  /// them feasible, as in \c doShortcut().
+  OnlineShortcutTrajectory(
+      const trajectory::Spline& _inputTrajectory,
+      aikido::constraint::TestablePtr _feasibilityCheck,
+      const Eigen::VectorXd& _maxVelocity,
+      const Eigen::VectorXd& _maxAcceleration,
+      const aikido::common::RNG& _rng,
+      double _leadTime = DEFAULT_LEAD_TIME,
+      double _timelimit = DEFAULT_TIMELIMT,
+      double _checkResolution = DEFAULT_CHECK_RESOLUTION,
+      double _tolerance = DEFAULT_TOLERANCE,
+      aikido::constraint::ClearancePtr _clearance = nullptr);
+
+  /// Stops shortcutting.
+  virtual ~OnlineShortcutTrajectory();
+
+  /// Starts shortcutting in a background thread. Call this when execution of
+  /// the trajectory starts.
+  ///
+  /// \throws std::logic_error if shortcutting has already been started.
+  void start();
+
+  /// Stops shortcutting and waits for the background thread to exit. The
+  /// trajectory keeps the shortcuts found so far.
+  ///
+  /// \throws any exception thrown while shortcutting.
+  void stop();
+
+  /// Waits until shortcutting runs out of time or reaches the end of the
+  /// trajectory.
+  ///
+  /// \throws any exception thrown while shortcutting.
+  void wait();
+
+  /// Returns the current trajectory. Later shortcuts do not modify it, so
+  /// the next shortcut copies the trajectory while it is still referenced.
+  std::shared_ptr<const trajectory::Spline> getSpline() const;
+
+  /// Returns the number of shortcuts spliced into the trajectory so far.
+  std::size_t getNumShortcuts() const;
+
+  // Documentation inherited.
+  statespace::ConstStateSpacePtr getStateSpace() const override;
+
+  // Documentation inherited.
+  std::size_t getNumDerivatives() const override;
+
+  // Documentation inherited.
+  double getStartTime() const override;
+
+  // Documentation inherited.
+  double getEndTime() const override;
+
+  // Documentation inherited.
+  double getDuration() const override;
+
+  // Documentation inherited.
+  void evaluate(
+      double _t, statespace::StateSpace::State* _state) const override;
+
+  // Documentation inherited.
+  void evaluateDerivative(
+      double _t, int _derivative, Eigen::VectorXd& _tangentVector) const
+      override;
+
+private:
+  /// Body of the background thread.
+  void run();
+
+  /// Replaces the ramps of the trajectory from \c _firstRamp on by
+  /// \c _suffix if it leaves the current trajectory at time \c _leaveTime,
+  /// relative to the start time, after the lead time.
+  bool commit(
+      double _leaveTime,
+      std::size_t _firstRamp,
+      const ParabolicRamp::DynamicPath& _suffix);
+
+  /// Returns the earliest time, relative to the start time, at which the
+  /// trajectory may still be modified.
+  double getSafeTime() const;
+
+  /// Joins the background thread and rethrows its exception, if any.
+  void join();
+
+  statespace::ConstStateSpacePtr mStateSpace;
+  double mStartTime;
+  aikido::constraint::TestablePtr mFeasibilityCheck;
+  std::unique_ptr<aikido::common::RNG> mRng;
+  double mLeadTime;
+  double mTimelimit;
+  double mCheckResolution;
+  double mTolerance;
+  aikido::constraint::ClearancePtr mClearance;
+
+  /// Only accessed by the background thread once it is started.
+  std::unique_ptr<ParabolicRamp::DynamicPath> mDynamicPath;
+
+  /// Index of the first segment of mSpline of each ramp of mDynamicPath,
+  /// followed by the number of segments. Only accessed by the background
+  /// thread once it is started.
+  std::vector<std::size_t> mRampSegments;
+
+  /// Protects mSpline, mNumShortcuts, and mError.
+  mutable std::mutex mMutex;
+  std::shared_ptr<trajectory::Spline> mSpline;
+  std::size_t mNumShortcuts;
+  std::exception_ptr mError;
+
+  std::chrono::steady_clock::time_point mExecutionStartTime;
+  std::atomic<bool> mStopRequested;
+  std::thread mThread;
+  bool mStarted;
+};
+
+} // namespace parabolic
+} // namespace planner
+} // namespace aikido
+
+#endif // ifndef AIKIDO_PLANNER_PARABOLIC_ONLINESHORTCUTTRAJECTORY_HPP_
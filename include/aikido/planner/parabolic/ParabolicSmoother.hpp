@@ -1,7 +1,9 @@
 #ifndef AIKIDO_PLANNER_PARABOLIC_PARABOLICSMOOTHER_HPP_
 #define AIKIDO_PLANNER_PARABOLIC_PARABOLICSMOOTHER_HPP_
 
+#include <vector>
 #include <Eigen/Dense>
+#include "aikido/constraint/Clearance.hpp"
 #include "aikido/planner/TrajectoryPostProcessor.hpp"
 #include "aikido/trajectory/Interpolated.hpp"
 #include "aikido/trajectory/Spline.hpp"
@@ -42,6 +44,10 @@ constexpr double DEFAULT_TOLERANCE = 1e-3;
 /// discretization that deviates no more than \c _tolerance
 /// from the parabolic ramp along any axis, and then checks for
 /// configuration and segment feasibility along that piecewise linear path.
+/// \param _clearance Optional lower bound on the distance of states to
+/// violating \c _feasibilityCheck. If given, the parts of a segment within
+/// the clearance of its checked states are skipped, so segments far from
+/// obstacles only cost a few checks.
 /// \return smoothed trajectory that satisfies acceleration constraints
 std::unique_ptr<trajectory::Spline> doShortcut(
     const trajectory::Spline& _inputTrajectory,
@@ -51,7 +57,53 @@ std::unique_ptr<trajectory::Spline> doShortcut(
     aikido::common::RNG& _rng,
     double _timelimit = DEFAULT_TIMELIMT,
     double _checkResolution = DEFAULT_CHECK_RESOLUTION,
-    double _tolerance = DEFAULT_TOLERANCE);
+    double _tolerance = DEFAULT_TOLERANCE,
+    aikido::constraint::ClearancePtr _clearance = nullptr);
+
+/// Shortcut waypoints in a trajectory using parabolic splines, checking
+/// several candidate shortcuts in parallel.
+///
+/// This function behaves like the single-testable overload, except that each
+/// iteration samples one candidate shortcut per element of
+/// \c _feasibilityChecks and checks them concurrently, one thread per
+/// testable. The feasible candidates that save the most time are committed as
+/// long as they do not modify the same part of the trajectory.
+///
+/// The testables are used from different threads at the same time, so they
+/// must not share mutable state. For collision constraints, this means that
+/// each testable must be defined on its own clone of the skeletons (e.g.
+/// created with \c World::clone()).
+///
+/// \param _inputTrajectory input piecewise Geodesic trajectory
+/// \param _feasibilityChecks one feasibility check per worker thread
+/// \param _maxVelocity maximum velocity for each dimension
+/// \param _maxAcceleration maximum acceleration for each dimension
+/// \param _rng A random generator for sampling time in shortcut.
+/// \param _timelimit The maximum time to allow for doing shortcut
+/// \param _checkResolution the resolution in discretizing a segment in
+/// checking the feasibility of the segment
+/// \param _tolerance this tolerance is used in a piecewise linear
+/// discretization that deviates no more than \c _tolerance
+/// from the parabolic ramp along any axis, and then checks for
+/// configuration and segment feasibility along that piecewise linear path.
+/// \param _clearances Optional lower bounds on the distance of states to
+/// violating the feasibility checks, see the single-testable overload. Either
+/// empty or one per element of \c _feasibilityChecks, defined on the same
+/// skeleton clone as it, since each thread queries its own clearance.
+/// \return smoothed trajectory that satisfies acceleration constraints
+/// \throws std::invalid_argument if \c _clearances is neither empty nor the
+/// same size as \c _feasibilityChecks
+std::unique_ptr<trajectory::Spline> doShortcut(
+    const trajectory::Spline& _inputTrajectory,
+    const std::vector<aikido::constraint::TestablePtr>& _feasibilityChecks,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    aikido::common::RNG& _rng,
+    double _timelimit = DEFAULT_TIMELIMT,
+    double _checkResolution = DEFAULT_CHECK_RESOLUTION,
+    double _tolerance = DEFAULT_TOLERANCE,
+    const std::vector<aikido::constraint::ClearancePtr>& _clearances
+    = std::vector<aikido::constraint::ClearancePtr>());
 
 /// Blend around waypoints in a trajectory using parabolic splines.
 ///
@@ -83,6 +135,8 @@ std::unique_ptr<trajectory::Spline> doShortcut(
 /// discretization that deviates no more than \c _tolerance
 /// from the parabolic ramp along any axis, and then checks for
 /// configuration and segment feasibility along that piecewise linear path.
+/// \param _clearance Optional lower bound on the distance of states to
+/// violating \c _feasibilityCheck, see \c doShortcut.
 /// \return smoothed trajectory that satisfies acceleration constraints
 std::unique_ptr<trajectory::Spline> doBlend(
     const trajectory::Spline& _inputTrajectory,
@@ -92,7 +146,8 @@ std::unique_ptr<trajectory::Spline> doBlend(
     double _blendRadius = DEFAULT_BLEND_RADIUS,
     int _blendIterations = DEFAULT_BLEND_ITERATIONS,
     double _checkResolution = DEFAULT_CHECK_RESOLUTION,
-    double _tolerance = DEFAULT_TOLERANCE);
+    double _tolerance = DEFAULT_TOLERANCE,
+    aikido::constraint::ClearancePtr _clearance = nullptr);
 
 /// Shortcut and blends waypoints in a trajectory using parabolic splines.
 ///
@@ -116,6 +171,8 @@ std::unique_ptr<trajectory::Spline> doBlend(
 /// discretization that deviates no more than \c _tolerance
 /// from the parabolic ramp along any axis, and then checks for
 /// configuration and segment feasibility along that piecewise linear path.
+/// \param _clearance Optional lower bound on the distance of states to
+/// violating \c _feasibilityCheck, see \c doShortcut.
 /// \return smoothed trajectory that satisfies acceleration constraints
 std::unique_ptr<trajectory::Spline> doShortcutAndBlend(
     const trajectory::Spline& _inputTrajectory,
@@ -127,7 +184,55 @@ std::unique_ptr<trajectory::Spline> doShortcutAndBlend(
     double _blendRadius = DEFAULT_BLEND_RADIUS,
     int _blendIterations = DEFAULT_BLEND_ITERATIONS,
     double _checkResolution = DEFAULT_CHECK_RESOLUTION,
-    double _tolerance = DEFAULT_TOLERANCE);
+    double _tolerance = DEFAULT_TOLERANCE,
+    aikido::constraint::ClearancePtr _clearance = nullptr);
+
+/// Shortcut and blends waypoints in a trajectory using parabolic splines,
+/// checking several candidate shortcuts in parallel.
+///
+/// This function behaves like the single-testable overload, except that
+/// shortcuts are checked concurrently against \c _shortcutChecks as in the
+/// parallel overload of \c doShortcut. Blends are checked against
+/// \c _feasibilityCheck. If \c _shortcutChecks is empty, shortcuts are
+/// checked serially against \c _feasibilityCheck instead.
+/// \param _inputTrajectory input piecewise Geodesic trajectory
+/// \param _shortcutChecks one feasibility check per shortcut thread, each
+/// equivalent to \c _feasibilityCheck
+/// \param _feasibilityCheck Check whether a position is feasible
+/// \param _maxVelocity maximum velocity for each dimension
+/// \param _maxAcceleration maximum acceleration for each dimension
+/// \param _rng A random generator for sampling time in shortcut.
+/// \param _timelimit The maximum time to allow for doing shortcut
+/// (unit in second)
+/// \param _blendRadius the radius used in doing blend
+/// \param _blendIterations the maximum iteration number in doing blend
+/// \param _checkResolution the resolution in discretizing a segment in
+/// checking the feasibility of the segment
+/// \param _tolerance this tolerance is used in a piecewise linear
+/// discretization that deviates no more than \c _tolerance
+/// from the parabolic ramp along any axis, and then checks for
+/// configuration and segment feasibility along that piecewise linear path.
+/// \param _clearance Optional lower bound on the distance of states to
+/// violating \c _feasibilityCheck, see \c doShortcut.
+/// \param _shortcutClearances Optional clearances used by the shortcut
+/// threads, either empty or one per element of \c _shortcutChecks, see the
+/// parallel overload of \c doShortcut.
+/// \return smoothed trajectory that satisfies acceleration constraints
+std::unique_ptr<trajectory::Spline> doShortcutAndBlend(
+    const trajectory::Spline& _inputTrajectory,
+    const std::vector<aikido::constraint::TestablePtr>& _shortcutChecks,
+    aikido::constraint::TestablePtr _feasibilityCheck,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    aikido::common::RNG& _rng,
+    double _timelimit = DEFAULT_TIMELIMT,
+    double _blendRadius = DEFAULT_BLEND_RADIUS,
+    int _blendIterations = DEFAULT_BLEND_ITERATIONS,
+    double _checkResolution = DEFAULT_CHECK_RESOLUTION,
+    double _tolerance = DEFAULT_TOLERANCE,
+    aikido::constraint::ClearancePtr _clearance = nullptr,
+    const std::vector<aikido::constraint::ClearancePtr>& _shortcutClearances
+    = std::vector<aikido::constraint::ClearancePtr>());
 
 /// Class for performing parabolic smoothing on trajectories
 class ParabolicSmoother : public aikido::planner::TrajectoryPostProcessor
@@ -181,6 +286,47 @@ public:
       const aikido::common::RNG& _rng,
       const aikido::constraint::TestablePtr& _collisionTestable) override;
 
+  /// Enables parallel shortcutting. Shortcuts are checked concurrently
+  /// against \c _feasibilityChecks, one thread per testable, instead of
+  /// against the testable passed to \c postprocess. Blending still uses the
+  /// testable passed to \c postprocess. Passing an empty vector restores
+  /// serial shortcutting.
+  ///
+  /// \param _feasibilityChecks Feasibility checks that are safe to use
+  /// concurrently, e.g. collision constraints on separate skeleton clones.
+  /// They must be equivalent to the testable passed to \c postprocess.
+  /// \param _clearances Optional clearances, either empty or one per element
+  /// of \c _feasibilityChecks and defined on the same skeleton clone as it.
+  /// \throws std::invalid_argument if an element is nullptr or if
+  /// \c _clearances is neither empty nor the same size as
+  /// \c _feasibilityChecks
+  void setShortcutFeasibilityChecks(
+      std::vector<aikido::constraint::TestablePtr> _feasibilityChecks,
+      std::vector<aikido::constraint::ClearancePtr> _clearances
+      = std::vector<aikido::constraint::ClearancePtr>());
+
+  /// Returns the feasibility checks used for parallel shortcutting.
+  const std::vector<aikido::constraint::TestablePtr>&
+  getShortcutFeasibilityChecks() const;
+
+  /// Returns the clearances used for parallel shortcutting.
+  const std::vector<aikido::constraint::ClearancePtr>&
+  getShortcutFeasibilityClearances() const;
+
+  /// Sets a lower bound on the distance of states to violating the testable
+  /// passed to \c postprocess. Segments are then only checked at full
+  /// resolution where this clearance does not prove them feasible. Parallel
+  /// shortcutting uses the clearances passed to
+  /// \c setShortcutFeasibilityChecks instead. Passing nullptr disables it.
+  ///
+  /// \param _clearance Clearance consistent with the testable passed to
+  /// \c postprocess, e.g. a \c constraint::dart::CollisionClearance with the
+  /// same collision checks.
+  void setFeasibilityClearance(aikido::constraint::ClearancePtr _clearance);
+
+  /// Returns the clearance used to skip feasibility checks.
+  aikido::constraint::ClearancePtr getFeasibilityClearance() const;
+
 private:
   /// Common logic to do shortcutting and/or blending on the input trajectory
   /// as dictated by mEnableShortcut and mEnableBlend.
@@ -215,6 +361,15 @@ private:
 
   /// Set to the value of \c _blendIterations.
   int mBlendIterations;
+
+  /// Feasibility checks used for parallel shortcutting.
+  std::vector<aikido::constraint::TestablePtr> mShortcutFeasibilityChecks;
+
+  /// Clearances used for parallel shortcutting.
+  std::vector<aikido::constraint::ClearancePtr> mShortcutFeasibilityClearances;
+
+  /// Clearance used to skip feasibility checks.
+  aikido::constraint::ClearancePtr mFeasibilityClearance;
 };
 
 } // namespace parabolic
@@ -1,6 +1,7 @@
 #ifndef AIKIDO_PLANNER_PARABOLIC_PARABOLICTIMER_HPP_
 #define AIKIDO_PLANNER_PARABOLIC_PARABOLICTIMER_HPP_
 
+#include <vector>
 #include <Eigen/Dense>
 #include "aikido/planner/TrajectoryPostProcessor.hpp"
 #include "aikido/trajectory/Interpolated.hpp"
@@ -60,6 +61,26 @@ std::unique_ptr<aikido::trajectory::Spline> computeParabolicTiming(
     const Eigen::VectorXd& _maxVelocity,
     const Eigen::VectorXd& _maxAcceleration);
 
+/// Computes the time-optimal timing of several trajectories that share a
+/// state space and velocity and acceleration bounds. Each output trajectory
+/// is the one \c computeParabolicTiming() computes for the corresponding
+/// input trajectory, but the bounds and the state space are validated once
+/// and the trajectories are retimed concurrently.
+///
+/// \param _inputTrajectories input piecewise Geodesic trajectories, which
+/// must all be defined in the same state space
+/// \param _maxVelocity maximum velocity for each dimension
+/// \param _maxAcceleration maximum acceleration for each dimension
+/// \param _numThreads maximum number of threads to retime with; zero uses one
+/// thread per hardware thread
+/// \return time optimal trajectories, in the order of \c _inputTrajectories
+std::vector<std::unique_ptr<aikido::trajectory::Spline>> computeParabolicTiming(
+    const std::vector<aikido::trajectory::ConstInterpolatedPtr>&
+        _inputTrajectories,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    std::size_t _numThreads = 0);
+
 /// Convert an interpolated trajectory to a piecewise linear spline trajectory
 /// This function requires the \c _inputTrajectory to use a \c
 /// GeodesicInterpolator.
@@ -0,0 +1,90 @@
+#ifndef AIKIDO_PLANNER_SCURVE_SCURVETIMER_HPP_
+#define AIKIDO_PLANNER_SCURVE_SCURVETIMER_HPP_
+
+#include <Eigen/Dense>
+#include "aikido/planner/TrajectoryPostProcessor.hpp"
+#include "aikido/trajectory/Interpolated.hpp"
+#include "aikido/trajectory/Spline.hpp"
+
+namespace aikido {
+namespace planner {
+namespace scurve {
+
+/// Computes the time-optimal jerk-limited timing of a trajectory consisting
+/// of a sequence of geodesics between waypoints under velocity, acceleration,
+/// and jerk bounds. The output is a spline of cubic polynomials that
+/// \b exactly follows the input path.
+///
+/// Each geodesic is timed with a seven-phase S-curve velocity profile:
+/// the jerk is piecewise constant, so the acceleration is continuous and
+/// piecewise linear. Like \c parabolic::computeParabolicTiming, the output
+/// starts and stops at rest at every waypoint, now also with zero
+/// acceleration. All dimensions of a geodesic share one profile, so the
+/// tightest of their limits, scaled by their displacement, governs it.
+///
+/// Consecutive duplicate waypoints are skipped. The output has no segments
+/// if all waypoints coincide.
+///
+/// \param _inputTrajectory input piecewise geodesic trajectory
+/// \param _maxVelocity maximum velocity for each dimension
+/// \param _maxAcceleration maximum acceleration for each dimension
+/// \param _maxJerk maximum jerk for each dimension
+/// \return time optimal trajectory that satisfies the bounds
+std::unique_ptr<aikido::trajectory::Spline> computeSCurveTiming(
+    const aikido::trajectory::Interpolated& _inputTrajectory,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    const Eigen::VectorXd& _maxJerk);
+
+/// Computes the time-optimal jerk-limited timing of a trajectory consisting
+/// of a sequence of geodesics between the waypoints of \c _inputTrajectory.
+///
+/// \copydetails computeSCurveTiming(const aikido::trajectory::Interpolated&, const Eigen::VectorXd&, const Eigen::VectorXd&, const Eigen::VectorXd&)
+std::unique_ptr<aikido::trajectory::Spline> computeSCurveTiming(
+    const aikido::trajectory::Spline& _inputTrajectory,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    const Eigen::VectorXd& _maxJerk);
+
+/// Class for performing jerk-limited retiming on trajectories.
+class SCurveTimer : public aikido::planner::TrajectoryPostProcessor
+{
+public:
+  /// \param _velocityLimits Maximum velocity for each dimension.
+  /// \param _accelerationLimits Maximum acceleration for each dimension.
+  /// \param _jerkLimits Maximum jerk for each dimension.
+  SCurveTimer(
+      const Eigen::VectorXd& _velocityLimits,
+      const Eigen::VectorXd& _accelerationLimits,
+      const Eigen::VectorXd& _jerkLimits);
+
+  /// Performs jerk-limited retiming on an input trajectory.
+  /// \copydoc TrajectoryPostProcessor::postprocess
+  std::unique_ptr<aikido::trajectory::Spline> postprocess(
+      const aikido::trajectory::Interpolated& _inputTraj,
+      const aikido::common::RNG& _rng,
+      const aikido::constraint::TestablePtr& _constraint = nullptr) override;
+
+  /// Performs jerk-limited retiming on an input *spline* trajectory.
+  /// \copydoc TrajectoryPostProcessor::postprocess
+  std::unique_ptr<aikido::trajectory::Spline> postprocess(
+      const aikido::trajectory::Spline& _inputTraj,
+      const aikido::common::RNG& _rng,
+      const aikido::constraint::TestablePtr& _constraint = nullptr) override;
+
+private:
+  /// Set to the value of \c _velocityLimits.
+  const Eigen::VectorXd mVelocityLimits;
+
+  /// Set to the value of \c _accelerationLimits.
+  const Eigen::VectorXd mAccelerationLimits;
+
+  /// Set to the value of \c _jerkLimits.
+  const Eigen::VectorXd mJerkLimits;
+};
+
+} // namespace scurve
+} // namespace planner
+} // namespace aikido
+
+#endif // ifndef AIKIDO_PLANNER_SCURVE_SCURVETIMER_HPP_
@@ -0,0 +1,117 @@
+#ifndef AIKIDO_PLANNER_TOPPRA_TOPPRATIMER_HPP_
+#define AIKIDO_PLANNER_TOPPRA_TOPPRATIMER_HPP_
+
+#include <Eigen/Dense>
+#include "aikido/constraint/Testable.hpp"
+#include "aikido/planner/TrajectoryPostProcessor.hpp"
+#include "aikido/trajectory/Interpolated.hpp"
+#include "aikido/trajectory/Spline.hpp"
+
+namespace aikido {
+namespace planner {
+namespace toppra {
+
+constexpr double DEFAULT_GRID_RESOLUTION = 1e-2;
+constexpr double DEFAULT_MAX_DEVIATION = 1e-2;
+
+/// Computes the time-optimal timing of a path through the waypoints of
+/// \c _inputTrajectory under velocity and acceleration bounds using
+/// time-optimal path parameterization by reachability analysis (TOPP-RA).
+///
+/// The geometric path follows the geodesics between the waypoints and turns
+/// at each waypoint along a quadratic blend that stays within
+/// \c _maxDeviation of them. Unlike \c parabolic::computeParabolicTiming, the
+/// output does not stop at the waypoints it blends; it only starts and ends at
+/// rest. If \c _constraint is given and a blend violates it, no waypoint is
+/// blended and the output stops at every waypoint where the path turns. The
+/// timing of the input trajectory is ignored.
+///
+/// The velocity and acceleration bounds are enforced at grid points along the
+/// path that are at most \c _gridResolution apart, at least two per geodesic
+/// or blend. The path parameter has piecewise constant acceleration between
+/// grid points, so the output is a spline of fourth-order polynomials that
+/// \b exactly follows the geometric path.
+///
+/// This function curently only supports \c RealVector, \c SO2, and compound
+/// state spaces of those types.
+///
+/// \param _inputTrajectory input trajectory whose waypoints define the path
+/// \param _maxVelocity maximum velocity for each dimension
+/// \param _maxAcceleration maximum acceleration for each dimension
+/// \param _gridResolution maximum distance between grid points along the path
+/// \param _maxDeviation maximum distance of the blends from the geodesics
+/// between the waypoints; zero stops at every waypoint where the path turns
+/// \param _constraint constraint that the blends must satisfy, or nullptr
+/// \return time optimal trajectory that satisfies the bounds at the grid
+/// \throws std::runtime_error if no timing satisfies the bounds
+std::unique_ptr<aikido::trajectory::Spline> computeToppraTiming(
+    const aikido::trajectory::Interpolated& _inputTrajectory,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    double _gridResolution = DEFAULT_GRID_RESOLUTION,
+    double _maxDeviation = DEFAULT_MAX_DEVIATION,
+    const aikido::constraint::Testable* _constraint = nullptr);
+
+/// Computes the time-optimal timing of a path through the waypoints of the
+/// spline \c _inputTrajectory under velocity and acceleration bounds using
+/// time-optimal path parameterization by reachability analysis (TOPP-RA).
+///
+/// \copydetails computeToppraTiming(const aikido::trajectory::Interpolated&, const Eigen::VectorXd&, const Eigen::VectorXd&, double, double, const aikido::constraint::Testable*)
+std::unique_ptr<aikido::trajectory::Spline> computeToppraTiming(
+    const aikido::trajectory::Spline& _inputTrajectory,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    double _gridResolution = DEFAULT_GRID_RESOLUTION,
+    double _maxDeviation = DEFAULT_MAX_DEVIATION,
+    const aikido::constraint::Testable* _constraint = nullptr);
+
+/// Class for performing TOPP-RA retiming on trajectories.
+class ToppraTimer : public aikido::planner::TrajectoryPostProcessor
+{
+public:
+  /// \param _velocityLimits Maximum velocity for each dimension.
+  /// \param _accelerationLimits Maximum acceleration for each dimension.
+  /// \param _gridResolution Maximum distance between grid points along the
+  /// path at which the limits are enforced.
+  /// \param _maxDeviation Maximum distance of the blends at the waypoints from
+  /// the geodesics between them.
+  ToppraTimer(
+      const Eigen::VectorXd& _velocityLimits,
+      const Eigen::VectorXd& _accelerationLimits,
+      double _gridResolution = DEFAULT_GRID_RESOLUTION,
+      double _maxDeviation = DEFAULT_MAX_DEVIATION);
+
+  /// Performs TOPP-RA retiming on an input trajectory. Blends that violate
+  /// \c _constraint are not used.
+  /// \copydoc TrajectoryPostProcessor::postprocess
+  std::unique_ptr<aikido::trajectory::Spline> postprocess(
+      const aikido::trajectory::Interpolated& _inputTraj,
+      const aikido::common::RNG& _rng,
+      const aikido::constraint::TestablePtr& _constraint = nullptr) override;
+
+  /// Performs TOPP-RA retiming on an input *spline* trajectory.
+  /// \copydoc TrajectoryPostProcessor::postprocess
+  std::unique_ptr<aikido::trajectory::Spline> postprocess(
+      const aikido::trajectory::Spline& _inputTraj,
+      const aikido::common::RNG& _rng,
+      const aikido::constraint::TestablePtr& _constraint = nullptr) override;
+
+private:
+  /// Set to the value of \c _velocityLimits.
+  const Eigen::VectorXd mVelocityLimits;
+
+  /// Set to the value of \c _accelerationLimits.
+  const Eigen::VectorXd mAccelerationLimits;
+
+  /// Set to the value of \c _gridResolution.
+  const double mGridResolution;
+
+  /// Set to the value of \c _maxDeviation.
+  const double mMaxDeviation;
+};
+
+} // namespace toppra
+} // namespace planner
+} // namespace aikido
+
+#endif // ifndef AIKIDO_PLANNER_TOPPRA_TOPPRATIMER_HPP_
@@ -2,8 +2,10 @@
 #define AIKIDO_PLANNER_VECTORFIELD_BODYNODEPOSEVECTORFIELD_HPP_
 
 #include <dart/dynamics/BodyNode.hpp>
+#include <aikido/planner/vectorfield/BoundedLeastSquaresSolver.hpp>
 #include <aikido/planner/vectorfield/VectorField.hpp>
 #include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
+#include <aikido/trajectory/SplineCursor.hpp>
 
 namespace aikido {
 namespace planner {
@@ -23,6 +25,8 @@ AIKIDO_DECLARE_POINTERS(BodyNodePoseVectorField)
 class BodyNodePoseVectorField : public VectorField
 {
 public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   /// Constructor.
   ///
   /// \param[in] metaSkeletonStateSpace MetaSkeleton state space.
@@ -96,6 +100,21 @@ public:
   dart::dynamics::ConstBodyNodePtr getBodyNode() const;
 
 protected:
+  /// Returns the pose of the body node at \c state.
+  ///
+  /// The pose and the Jacobian are cached for the last positions they were
+  /// computed at, so evaluating the velocity and the status of the same
+  /// state only computes forward kinematics once.
+  ///
+  /// \param[in] state State to compute the pose at.
+  /// \return Pose of the body node.
+  const Eigen::Isometry3d& computeBodyNodePose(
+      const aikido::statespace::StateSpace::State* state) const;
+
+  /// Returns the world Jacobian of the body node at the positions of the last
+  /// call to computeBodyNodePose().
+  const dart::math::Jacobian& computeBodyNodeJacobian() const;
+
   /// Meta skeleton state space.
   aikido::statespace::dart::MetaSkeletonStateSpacePtr mMetaSkeletonStateSpace;
 
@@ -111,6 +130,12 @@ protected:
   /// Padding of joint limits.
   double mJointLimitPadding;
 
+  /// Joint positions lower limits.
+  Eigen::VectorXd mPositionLowerLimits;
+
+  /// Joint positions upper limits.
+  Eigen::VectorXd mPositionUpperLimits;
+
   /// Joint velocities lower limits.
   Eigen::VectorXd mVelocityLowerLimits;
 
@@ -119,6 +144,40 @@ protected:
 
   /// Enfoce joint velocity limits
   bool mEnforceJointVelocityLimits;
+
+  /// Solver for joint velocities. Its workspace is reused by every call to
+  /// evaluateVelocity().
+  mutable BoundedLeastSquaresSolver mJointVelocitySolver;
+
+private:
+  /// Kinematics of the body node at the positions they were last computed at.
+  struct KinematicsCache
+  {
+    /// Whether mPose is computed at mPositions.
+    bool mHasPose = false;
+
+    /// Whether mJacobian is computed at mPositions.
+    bool mHasJacobian = false;
+
+    /// Positions of the MetaSkeleton.
+    Eigen::VectorXd mPositions;
+
+    /// Pose of the body node.
+    Eigen::Isometry3d mPose;
+
+    /// World Jacobian of the body node.
+    dart::math::Jacobian mJacobian;
+  };
+
+  /// Buffer for the positions of the evaluated state.
+  mutable Eigen::VectorXd mPositions;
+
+  /// Kinematics cache.
+  mutable KinematicsCache mKinematicsCache;
+
+  /// Cursor for evaluating spline trajectories in evaluateTrajectory(). It
+  /// refers to the last evaluated spline.
+  mutable std::unique_ptr<aikido::trajectory::SplineCursor> mSplineCursor;
 };
 
 } // namespace vectorfield
@@ -0,0 +1,97 @@
+#ifndef AIKIDO_PLANNER_VECTORFIELD_BOUNDEDLEASTSQUARESSOLVER_HPP_
+#define AIKIDO_PLANNER_VECTORFIELD_BOUNDEDLEASTSQUARESSOLVER_HPP_
+
+#include <vector>
+#include <Eigen/Dense>
+
+namespace aikido {
+namespace planner {
+namespace vectorfield {
+
+/// Solver for small damped least-squares problems with box constraints,
+///
+///   minimize 0.5 * |A x - b|^2 + 0.5 * damping^2 * |x|^2
+///   subject to lower <= x <= upper,
+///
+/// such as mapping a twist to joint velocities through a Jacobian. Without
+/// active bounds, the solution is the damped pseudoinverse solution. Bounds
+/// are handled with an active set method: variables are clamped to the bound
+/// that blocks the step towards the unconstrained solution of the free
+/// variables, and released when the gradient points into the box.
+///
+/// The workspace is kept between calls, so solving many problems of the
+/// same size does not allocate.
+class BoundedLeastSquaresSolver
+{
+public:
+  /// Constructor.
+  ///
+  /// \param[in] damping Damping factor. It keeps the problem well conditioned
+  /// near singularities of \c A. It must be positive. The default barely
+  /// changes the solution along singular values of \c A above 0.1.
+  explicit BoundedLeastSquaresSolver(double damping = 1e-3);
+
+  /// Solves the problem.
+  ///
+  /// \param[in] A Matrix with one column per variable.
+  /// \param[in] b Target vector with one element per row of \c A.
+  /// \param[in] lower Lower bounds. Elements may be negative infinity.
+  /// \param[in] upper Upper bounds. Elements may be positive infinity.
+  /// \param[out] x Solution.
+  /// \return Whether the active set method converged to a finite solution.
+  /// \throws std::invalid_argument if the sizes do not match or a lower bound
+  /// is greater than the corresponding upper bound.
+  bool solve(
+      const Eigen::Ref<const Eigen::MatrixXd>& A,
+      const Eigen::Ref<const Eigen::VectorXd>& b,
+      const Eigen::Ref<const Eigen::VectorXd>& lower,
+      const Eigen::Ref<const Eigen::VectorXd>& upper,
+      Eigen::VectorXd& x);
+
+  /// Returns the damping factor.
+  double getDamping() const;
+
+private:
+  /// Bound a variable is clamped to.
+  enum class Bound
+  {
+    NONE,
+    LOWER,
+    UPPER
+  };
+
+  /// Solves the unconstrained problem over the free variables, with the
+  /// others fixed at their current values, and stores the result in
+  /// mFreeSolution.
+  void solveFree(const Eigen::VectorXd& x);
+
+  /// Damping factor.
+  double mDamping;
+
+  /// A^T A + damping^2 I.
+  Eigen::MatrixXd mNormalMatrix;
+
+  /// A^T b.
+  Eigen::VectorXd mNormalVector;
+
+  /// Bound each variable is clamped to.
+  std::vector<Bound> mBounds;
+
+  /// Indices of the free variables.
+  std::vector<Eigen::Index> mFree;
+
+  /// Workspace for the problem over the free variables.
+  Eigen::MatrixXd mFreeMatrix;
+  Eigen::VectorXd mFreeVector;
+  Eigen::VectorXd mFreeSolution;
+  Eigen::LDLT<Eigen::MatrixXd> mFreeDecomposition;
+
+  /// Gradient of the objective.
+  Eigen::VectorXd mGradient;
+};
+
+} // namespace vectorfield
+} // namespace planner
+} // namespace aikido
+
+#endif // AIKIDO_PLANNER_VECTORFIELD_BOUNDEDLEASTSQUARESSOLVER_HPP_
@@ -0,0 +1,166 @@
+#ifndef AIKIDO_PLANNER_VECTORFIELD_COMPOSITEBODYNODEPOSEVECTORFIELD_HPP_
+#define AIKIDO_PLANNER_VECTORFIELD_COMPOSITEBODYNODEPOSEVECTORFIELD_HPP_
+
+#include <vector>
+#include <dart/dynamics/BodyNode.hpp>
+#include <aikido/planner/vectorfield/BodyNodePoseVectorField.hpp>
+#include <aikido/planner/vectorfield/BoundedLeastSquaresSolver.hpp>
+#include <aikido/planner/vectorfield/VectorField.hpp>
+#include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
+
+namespace aikido {
+namespace planner {
+namespace vectorfield {
+
+AIKIDO_DECLARE_POINTERS(CompositeBodyNodePoseVectorField)
+
+/// This class is a vector field that moves several BodyNodes of one
+/// MetaSkeleton at once, e.g. both end-effectors in a bimanual task.
+///
+/// Each BodyNode follows the Cartesian vector field of a component
+/// BodyNodePoseVectorField. The desired twists and world Jacobians of all
+/// components are stacked and solved for joint velocities jointly, so the
+/// shared joints are coordinated instead of being planned one arm at a time.
+///
+/// Components may reach their goals at different times, e.g. when the arms
+/// move different distances. A component that has reached its goal region,
+/// i.e. whose status caches, is held in place with a zero twist while any
+/// other component has not. A component whose status is CACHE_AND_TERMINATE
+/// is held until planning ends. Held components keep reporting their cached
+/// status, so the planner caches once every component has reached its goal
+/// region and terminates with caching once every component is done. Planning
+/// terminates as soon as any component reports TERMINATE, e.g. because it
+/// deviated from its path or moved past its goal region.
+class CompositeBodyNodePoseVectorField : public VectorField
+{
+public:
+  /// Constructor.
+  ///
+  /// \param[in] vectorFields Vector fields of the BodyNodes to move. They must
+  /// share the same MetaSkeleton and MetaSkeleton state space.
+  /// \param[in] maxStepSize The maximum step size used to guarantee
+  /// that the integrator does not step out of joint limits.
+  /// \param[in] jointLimitPadding If less then this distance to joint
+  /// limit, velocity is bounded in that direction to 0.
+  /// \param[in] enforceJointVelocityLimits Whether joint velocity limits
+  /// are considered in computation.
+  /// \throws std::invalid_argument if \c vectorFields is empty, contains
+  /// \c nullptr or the vector fields do not share a MetaSkeleton, if
+  /// \c maxStepSize is not positive or if \c jointLimitPadding is negative.
+  CompositeBodyNodePoseVectorField(
+      std::vector<BodyNodePoseVectorFieldPtr> vectorFields,
+      double maxStepSize,
+      double jointLimitPadding,
+      bool enforceJointVelocityLimits = false);
+
+  // Documentation inherited.
+  bool evaluateVelocity(
+      const aikido::statespace::StateSpace::State* state,
+      Eigen::VectorXd& qd) const override;
+
+  // Documentation inherited.
+  VectorFieldPlannerStatus evaluateStatus(
+      const aikido::statespace::StateSpace::State* state) const override;
+
+  // Documentation inherited.
+  bool evaluateTrajectory(
+      const aikido::trajectory::Trajectory& trajectory,
+      const aikido::constraint::Testable* constraint,
+      double evalStepSize,
+      double& evalTimePivot,
+      bool includeEndTime) const override;
+
+  /// Returns the number of component vector fields.
+  std::size_t getNumVectorFields() const;
+
+  /// Returns a component vector field.
+  ///
+  /// \param[in] index Index of the vector field.
+  ConstBodyNodePoseVectorFieldPtr getVectorField(std::size_t index) const;
+
+  /// Returns meta skeleton.
+  dart::dynamics::ConstMetaSkeletonPtr getMetaSkeleton() const;
+
+protected:
+  /// Sets the MetaSkeleton to \c state and computes the pose of each
+  /// BodyNode, unless they were already computed at the same positions.
+  ///
+  /// \param[in] state State to compute the poses at.
+  void computeBodyNodePoses(
+      const aikido::statespace::StateSpace::State* state) const;
+
+  /// Evaluates the status of each component at the computed poses.
+  ///
+  /// \return Whether any component has not reached its goal region yet.
+  bool computeComponentStatuses() const;
+
+  /// Returns whether a component is held in place.
+  ///
+  /// \param[in] status Status of the component.
+  /// \param[in] isWaiting Whether any component has not reached its goal
+  /// region yet.
+  static bool isHeld(VectorFieldPlannerStatus status, bool isWaiting);
+
+  /// Component vector fields.
+  std::vector<BodyNodePoseVectorFieldPtr> mVectorFields;
+
+  /// Meta skeleton state space.
+  aikido::statespace::dart::MetaSkeletonStateSpacePtr mMetaSkeletonStateSpace;
+
+  /// Meta Skeleton
+  dart::dynamics::MetaSkeletonPtr mMetaSkeleton;
+
+  /// Maximum step size of integrator.
+  double mMaxStepSize;
+
+  /// Padding of joint limits.
+  double mJointLimitPadding;
+
+  /// Joint positions lower limits.
+  Eigen::VectorXd mPositionLowerLimits;
+
+  /// Joint positions upper limits.
+  Eigen::VectorXd mPositionUpperLimits;
+
+  /// Joint velocities lower limits.
+  Eigen::VectorXd mVelocityLowerLimits;
+
+  /// Joint velocities upper limits.
+  Eigen::VectorXd mVelocityUpperLimits;
+
+  /// Enfoce joint velocity limits
+  bool mEnforceJointVelocityLimits;
+
+  /// Solver for joint velocities.
+  mutable BoundedLeastSquaresSolver mJointVelocitySolver;
+
+private:
+  /// Positions of the evaluated state.
+  mutable Eigen::VectorXd mPositions;
+
+  /// Positions mPoses were computed at.
+  mutable Eigen::VectorXd mPosePositions;
+
+  /// Whether mPoses were computed at mPosePositions.
+  mutable bool mHasPoses;
+
+  /// Pose of the BodyNode of each component.
+  mutable std::vector<Eigen::Isometry3d,
+                      Eigen::aligned_allocator<Eigen::Isometry3d>>
+      mPoses;
+
+  /// Status of each component at mPoses.
+  mutable std::vector<VectorFieldPlannerStatus> mStatuses;
+
+  /// Stacked desired twists of the components.
+  mutable Eigen::VectorXd mDesiredTwists;
+
+  /// Stacked world Jacobians of the components.
+  mutable Eigen::MatrixXd mJacobians;
+};
+
+} // namespace vectorfield
+} // namespace planner
+} // namespace aikido
+
+#endif // AIKIDO_PLANNER_VECTORFIELD_COMPOSITEBODYNODEPOSEVECTORFIELD_HPP_
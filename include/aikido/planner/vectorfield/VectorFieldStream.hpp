@@ -0,0 +1,177 @@
+#ifndef AIKIDO_PLANNER_VECTORFIELD_VECTORFIELDSTREAM_HPP_
+#define AIKIDO_PLANNER_VECTORFIELD_VECTORFIELDSTREAM_HPP_
+
+#include <memory>
+#include <string>
+#include <Eigen/Dense>
+#include <aikido/constraint/Testable.hpp>
+#include <aikido/planner/PlanningResult.hpp>
+#include <aikido/planner/vectorfield/VectorField.hpp>
+#include <aikido/statespace/StateSpace.hpp>
+#include <aikido/trajectory/Spline.hpp>
+
+namespace aikido {
+namespace planner {
+namespace vectorfield {
+
+namespace detail {
+class VectorFieldIntegrator;
+} // namespace detail
+
+/// Follows a vector field with a fixed step size and yields the resulting
+/// trajectory one segment at a time, so execution can start before the
+/// vector field has terminated.
+///
+/// Unlike followVectorField(), which integrates adaptively until the vector
+/// field terminates, each call to next() integrates only as many fixed steps
+/// as needed to release one more segment. A segment is released once the
+/// trajectory has been integrated and checked against the constraint for at
+/// least a look-ahead horizon past its end. After the first call, which
+/// fills the horizon, every call therefore costs about one integration step.
+///
+/// Termination is handled as in followVectorField(): when the vector field
+/// terminates or the constraint is violated, the remaining segments up to the
+/// last state the vector field asked to cache are released, and the stream
+/// ends. Segments that have already been released are never retracted.
+///
+/// Integration sets the positions of any MetaSkeleton the vector field
+/// operates on.
+class VectorFieldStream
+{
+public:
+  /// Fixed-step integration method.
+  enum class Method
+  {
+    /// Forward Euler, one vector field evaluation per step.
+    EULER,
+    /// Classical fourth-order Runge-Kutta, four evaluations per step.
+    RK4
+  };
+
+  /// Constructor.
+  ///
+  /// \param[in] vectorField Vector field to follow.
+  /// \param[in] startState Start state.
+  /// \param[in] constraint Constraint to be satisfied.
+  /// \param[in] stepSize Fixed integration step size.
+  /// \param[in] lookAheadTime How far past the end of a segment the
+  /// trajectory must be checked before the segment is released.
+  /// \param[in] checkConstraintResolution Resolution used in checking
+  /// constraint satisfaction in generated trajectory.
+  /// \param[in] method Integration method.
+  /// \param[in] maxTime Integration time after which the stream ends.
+  /// \throws std::invalid_argument if an argument is invalid.
+  VectorFieldStream(
+      std::shared_ptr<const VectorField> vectorField,
+      const aikido::statespace::StateSpace::State* startState,
+      aikido::constraint::ConstTestablePtr constraint,
+      double stepSize,
+      double lookAheadTime,
+      double checkConstraintResolution,
+      Method method = Method::RK4,
+      double maxTime = 10.0);
+
+  ~VectorFieldStream();
+
+  /// Integrates until the next segment can be released and returns it.
+  ///
+  /// Consecutive segments are contiguous in time and space. The first
+  /// segment starts at time zero at the start state.
+  ///
+  /// \param[out] planningResult Information about why the stream ended, set
+  /// when \c nullptr is returned.
+  /// \return Next segment, or \c nullptr if the stream has ended.
+  std::unique_ptr<aikido::trajectory::Spline> next(
+      planner::PlanningResult* planningResult = nullptr);
+
+  /// Returns whether next() will return no more segments.
+  bool isDone() const;
+
+  /// Returns whether the stream ended because of an error, in which case
+  /// the trajectory ends at the last released segment.
+  bool hasFailed() const;
+
+  /// Returns the number of segments released so far.
+  std::size_t getNumSegments() const;
+
+private:
+  /// Advances the integration by one step.
+  void integrateStep();
+
+  /// Stops integrating and keeps the knots up to the last cached one.
+  void finishIntegration(const std::string& message);
+
+  /// Stops integrating and discards the segments that were not released.
+  void failIntegration(const std::string& message);
+
+  /// Returns whether the next segment may be released.
+  bool canRelease() const;
+
+  /// Vector field to follow.
+  std::shared_ptr<const VectorField> mVectorField;
+
+  /// Constraint to be satisfied.
+  aikido::constraint::ConstTestablePtr mConstraint;
+
+  /// Integration step size.
+  double mStepSize;
+
+  /// Horizon that must be checked past a segment before it is released.
+  double mLookAheadTime;
+
+  /// Resolution used in checking constraint satisfaction.
+  double mConstraintCheckResolution;
+
+  /// Integration method.
+  Method mMethod;
+
+  /// Integration time after which the stream ends.
+  double mMaxTime;
+
+  /// Integrator that stores the knots and checks the trajectory.
+  std::unique_ptr<detail::VectorFieldIntegrator> mIntegrator;
+
+  /// Whether the start state has been passed to the integrator.
+  bool mStarted;
+
+  /// Whether the integration is still running.
+  bool mIntegrating;
+
+  /// Whether the stream ended because of an error.
+  bool mFailed;
+
+  /// Number of knots that can be released after the integration ended.
+  std::size_t mNumFinalKnots;
+
+  /// Number of segments released so far.
+  std::size_t mNumSegments;
+
+  /// Time up to which the trajectory has been checked after the integration
+  /// ended.
+  double mEvaluationTimePivot;
+
+  /// Why the stream ended.
+  std::string mMessage;
+
+  /// Current integration time.
+  double mTime;
+
+  /// Current position in configuration space.
+  Eigen::VectorXd mPosition;
+
+  /// Workspace for the integration methods.
+  Eigen::VectorXd mStagePosition;
+  Eigen::VectorXd mK1;
+  Eigen::VectorXd mK2;
+  Eigen::VectorXd mK3;
+  Eigen::VectorXd mK4;
+
+  /// Start state of the segment being released.
+  aikido::statespace::StateSpace::ScopedState mSegmentStartState;
+};
+
+} // namespace vectorfield
+} // namespace planner
+} // namespace aikido
+
+#endif // AIKIDO_PLANNER_VECTORFIELD_VECTORFIELDSTREAM_HPP_
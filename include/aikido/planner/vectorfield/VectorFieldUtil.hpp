@@ -3,6 +3,7 @@
 
 #include <dart/dynamics/BodyNode.hpp>
 #include <aikido/common/Spline.hpp>
+#include <aikido/planner/vectorfield/BoundedLeastSquaresSolver.hpp>
 #include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
 #include <aikido/trajectory/Interpolated.hpp>
 #include <aikido/trajectory/Spline.hpp>
@@ -13,6 +14,9 @@ namespace vectorfield {
 
 /// Compute joint velocity from a given twist.
 ///
+/// The joint velocities minimize the error to the desired twist within the
+/// joint velocity bounds, see \c BoundedLeastSquaresSolver.
+///
 /// \param[out] jointVelocity Calculated joint velocities.
 /// \param[in] desiredTwist Desired twist, which consists of angular velocity
 /// and linear velocity.
@@ -39,6 +43,75 @@ bool computeJointVelocityFromTwist(
     bool enforceJointVelocityLimits,
     double stepSize);
 
+/// Compute joint velocity from a given twist, reusing the workspace of
+/// \c solver.
+///
+/// \param[out] jointVelocity Calculated joint velocities.
+/// \param[in] desiredTwist Desired twist, which consists of angular velocity
+/// and linear velocity.
+/// \param[in] metaSkeleton MetaSkeleton to plan with
+/// \param[in] bodyNode Body node of the end-effector.
+/// \param[in] jointLimitPadding If less then this distance to joint
+/// limit, velocity is bounded in that direction to 0.
+/// \param[in] jointVelocityLowerLimits Joint velocity lower bounds.
+/// \param[in] jointVelocityUpperLimits Joint velocity upper bounds.
+/// \param[in] enforceJointVelocityLimits Whether joint velocity limits are
+/// considered in computation.
+/// \param[in] stepSize Step size in second. It is used in evaluating
+/// position bounds violation. It assumes that whether moving the time of
+/// stepSize by maximum joint velocity will reach the limit.
+/// \param[in] solver Solver used to compute the joint velocities.
+/// \return Whether a joint velocity is found
+bool computeJointVelocityFromTwist(
+    Eigen::VectorXd& jointVelocity,
+    const Eigen::Vector6d& desiredTwist,
+    const dart::dynamics::MetaSkeletonPtr metaSkeleton,
+    const dart::dynamics::BodyNodePtr bodyNode,
+    double jointLimitPadding,
+    const Eigen::VectorXd& jointVelocityLowerLimits,
+    const Eigen::VectorXd& jointVelocityUpperLimits,
+    bool enforceJointVelocityLimits,
+    double stepSize,
+    BoundedLeastSquaresSolver& solver);
+
+/// Compute joint velocity from a given twist and the Jacobian of the
+/// end-effector, without accessing the MetaSkeleton.
+///
+/// Several end-effectors can be moved at once by stacking their twists in
+/// \c desiredTwist and their Jacobians in \c jacobian, in the same order.
+///
+/// \param[out] jointVelocity Calculated joint velocities.
+/// \param[in] desiredTwist Desired twist, which consists of angular velocity
+/// and linear velocity.
+/// \param[in] jacobian World Jacobian of the end-effector.
+/// \param[in] positions Joint positions the Jacobian is computed at.
+/// \param[in] positionLowerLimits Joint position lower bounds.
+/// \param[in] positionUpperLimits Joint position upper bounds.
+/// \param[in] jointLimitPadding If less then this distance to joint
+/// limit, velocity is bounded in that direction to 0.
+/// \param[in] jointVelocityLowerLimits Joint velocity lower bounds.
+/// \param[in] jointVelocityUpperLimits Joint velocity upper bounds.
+/// \param[in] enforceJointVelocityLimits Whether joint velocity limits are
+/// considered in computation.
+/// \param[in] stepSize Step size in second. It is used in evaluating
+/// position bounds violation. It assumes that whether moving the time of
+/// stepSize by maximum joint velocity will reach the limit.
+/// \param[in] solver Solver used to compute the joint velocities.
+/// \return Whether a joint velocity is found
+bool computeJointVelocityFromTwist(
+    Eigen::VectorXd& jointVelocity,
+    const Eigen::Ref<const Eigen::VectorXd>& desiredTwist,
+    const Eigen::Ref<const Eigen::MatrixXd>& jacobian,
+    const Eigen::VectorXd& positions,
+    const Eigen::VectorXd& positionLowerLimits,
+    const Eigen::VectorXd& positionUpperLimits,
+    double jointLimitPadding,
+    const Eigen::VectorXd& jointVelocityLowerLimits,
+    const Eigen::VectorXd& jointVelocityUpperLimits,
+    bool enforceJointVelocityLimits,
+    double stepSize,
+    BoundedLeastSquaresSolver& solver);
+
 /// Compute the twist in global coordinate that corresponds to the gradient of
 /// the geodesic distance between two transforms.
 ///
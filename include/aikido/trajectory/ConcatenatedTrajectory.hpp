@@ -0,0 +1,95 @@
+#ifndef AIKIDO_TRAJECTORY_CONCATENATEDTRAJECTORY_HPP_
+#define AIKIDO_TRAJECTORY_CONCATENATEDTRAJECTORY_HPP_
+
+#include <vector>
+#include "aikido/common/pointers.hpp"
+#include "Trajectory.hpp"
+
+namespace aikido {
+namespace trajectory {
+
+AIKIDO_DECLARE_POINTERS(ConcatenatedTrajectory)
+
+/// Trajectory that executes several trajectories one after the other. It
+/// starts at the start time of the first trajectory, and each following
+/// trajectory is shifted in time to start where the previous one ends. A time
+/// on the boundary between two trajectories belongs to the earlier one.
+///
+/// The trajectories are shared instead of copied, so splicing trajectories is
+/// cheap regardless of their size. They must not be modified while in use.
+/// This does not check that consecutive trajectories meet at the same state.
+class ConcatenatedTrajectory : public Trajectory
+{
+public:
+  /// Constructor.
+  ///
+  /// \param _trajectories trajectories to concatenate, in order
+  /// \throws std::invalid_argument if \c _trajectories is empty, contains a
+  /// null trajectory, or the trajectories are not in the same state space.
+  explicit ConcatenatedTrajectory(
+      std::vector<ConstTrajectoryPtr> _trajectories);
+
+  /// Gets the number of concatenated trajectories.
+  std::size_t getNumTrajectories() const;
+
+  /// Gets a concatenated trajectory.
+  ///
+  /// \param _index index of the trajectory
+  /// \return trajectory at index \c _index
+  /// \throws std::domain_error if \c _index is out of bounds.
+  ConstTrajectoryPtr getTrajectory(std::size_t _index) const;
+
+  /// Gets the time at which a concatenated trajectory starts within this
+  /// trajectory.
+  ///
+  /// \param _index index of the trajectory
+  /// \return start time of the trajectory at index \c _index
+  /// \throws std::domain_error if \c _index is out of bounds.
+  double getTrajectoryStartTime(std::size_t _index) const;
+
+  // Documentation inherited.
+  statespace::ConstStateSpacePtr getStateSpace() const override;
+
+  // Documentation inherited.
+  std::size_t getNumDerivatives() const override;
+
+  // Documentation inherited.
+  double getDuration() const override;
+
+  // Documentation inherited.
+  double getStartTime() const override;
+
+  // Documentation inherited.
+  double getEndTime() const override;
+
+  // Documentation inherited.
+  void evaluate(
+      double _t, statespace::StateSpace::State* _state) const override;
+
+  // Documentation inherited.
+  void evaluateDerivative(
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _tangentVector) const override;
+
+private:
+  /// Returns the index of the trajectory that contains time \c _t.
+  std::size_t getTrajectoryForTime(double _t) const;
+
+  std::vector<ConstTrajectoryPtr> mTrajectories;
+
+  /// Start time of each trajectory within this trajectory, followed by the end
+  /// time of this trajectory.
+  std::vector<double> mKnotTimes;
+
+  /// Time to add to a time within this trajectory to get the time within each
+  /// trajectory.
+  std::vector<double> mTimeOffsets;
+
+  std::size_t mNumDerivatives;
+};
+
+} // namespace trajectory
+} // namespace aikido
+
+#endif // ifndef AIKIDO_TRAJECTORY_CONCATENATEDTRAJECTORY_HPP_
@@ -1,6 +1,8 @@
 #ifndef AIKIDO_TRAJECTORY_PIECEWISELINEAR_TRAJECTORY_HPP_
 #define AIKIDO_TRAJECTORY_PIECEWISELINEAR_TRAJECTORY_HPP_
 
+#include <memory>
+#include <vector>
 #include "aikido/common/pointers.hpp"
 #include "../statespace/GeodesicInterpolator.hpp"
 #include "Trajectory.hpp"
@@ -10,7 +12,13 @@ namespace trajectory {
 
 AIKIDO_DECLARE_POINTERS(Interpolated)
 
+class InterpolatedBuilder;
+
 /// Trajectory that uses an \c Interpolator to interpolate between waypoints.
+///
+/// The states of the waypoints are stored in blocks of memory owned by the
+/// trajectory, so adding a waypoint does not allocate it individually. Use
+/// \c reserve() or an \c InterpolatedBuilder to allocate them all at once.
 class Interpolated : public Trajectory
 {
 public:
@@ -22,12 +30,23 @@ public:
       statespace::ConstStateSpacePtr _stateSpace,
       statespace::ConstInterpolatorPtr _interpolator);
 
-  /// Add a waypoint to the trajectory at the given time.
+  Interpolated(const Interpolated&) = delete;
+  Interpolated& operator=(const Interpolated&) = delete;
+
+  virtual ~Interpolated();
+
+  /// Add a waypoint to the trajectory at the given time. Adding waypoints in
+  /// order of time takes amortized constant time.
   ///
   /// \param _t time of the waypoint
   /// \param _state state at the waypoint
   void addWaypoint(double _t, const statespace::StateSpace::State* _state);
 
+  /// Reserves memory for waypoints, so that adding them does not reallocate.
+  ///
+  /// \param _numWaypoints total number of waypoints
+  void reserve(std::size_t _numWaypoints);
+
   /// Gets a waypoint.
   ///
   /// \param _index waypoint index
@@ -70,7 +89,18 @@ public:
       int _derivative,
       Eigen::VectorXd& _tangentVector) const override;
 
+  using Trajectory::sample;
+
+  // Documentation inherited
+  void sample(
+      const std::vector<double>& _times,
+      Eigen::MatrixXd* _positions,
+      Eigen::MatrixXd* _velocities = nullptr,
+      Eigen::MatrixXd* _accelerations = nullptr) const override;
+
 private:
+  friend class InterpolatedBuilder;
+
   /// Waypoint in the trajectory.
   struct Waypoint
   {
@@ -86,14 +116,46 @@ private:
     statespace::StateSpace::State* state;
   };
 
-  /// Get the index of the first waypoint whose time value is larger than _t.
-  /// Throws std::domain_error if _t is larger than last waypoint in the
-  /// trajectory.
-  int getWaypointIndexAfterTime(double _t) const;
+  /// Get the index of the first waypoint whose time value is not smaller than
+  /// _t. Returns the number of waypoints if _t is larger than the time of the
+  /// last waypoint in the trajectory.
+  std::size_t getWaypointIndexAfterTime(double _t) const;
+
+  /// Copies _state into a new waypoint state.
+  statespace::StateSpace::State* createWaypointState(
+      const statespace::StateSpace::State* _state);
+
+  /// Evaluates the state at time _t, given the index of the first waypoint
+  /// whose time value is not smaller than _t.
+  void evaluateAtIndex(
+      std::size_t _index,
+      double _t,
+      statespace::StateSpace::State* _state) const;
+
+  /// Evaluates a derivative at time _t, given the index of the first waypoint
+  /// whose time value is not smaller than _t.
+  void evaluateDerivativeAtIndex(
+      std::size_t _index,
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _tangentVector) const;
 
   statespace::ConstStateSpacePtr mStateSpace;
   statespace::ConstInterpolatorPtr mInterpolator;
   std::vector<Waypoint> mWaypoints;
+
+  /// Memory of the waypoint states. New states are placed in the last block,
+  /// and a block is never reallocated, so the states stay where they are.
+  std::vector<std::unique_ptr<char[]>> mStateBlocks;
+
+  /// Number of states that fit in the last block.
+  std::size_t mStateBlockCapacity;
+
+  /// Number of states in the last block.
+  std::size_t mStateBlockSize;
+
+  /// Number of bytes between consecutive states in a block.
+  std::size_t mStateStride;
 };
 
 } // namespace trajectory
@@ -0,0 +1,64 @@
+#ifndef AIKIDO_TRAJECTORY_INTERPOLATEDBUILDER_HPP_
+#define AIKIDO_TRAJECTORY_INTERPOLATEDBUILDER_HPP_
+
+#include <memory>
+#include "../statespace/Interpolator.hpp"
+#include "../statespace/StateSpace.hpp"
+#include "Interpolated.hpp"
+
+namespace aikido {
+namespace trajectory {
+
+/// Builds an \c Interpolated trajectory from waypoints that are already sorted
+/// by time, such as the states of a planned path.
+///
+/// Each waypoint is appended in amortized constant time, and the states are
+/// copied into blocks of memory shared by all waypoints. Reserving the number
+/// of waypoints up front places all of them in a single block.
+class InterpolatedBuilder
+{
+public:
+  /// Constructor.
+  ///
+  /// \param _stateSpace state space of the trajectory
+  /// \param _interpolator interpolator used to interpolate between waypoints
+  /// \param _numWaypoints number of waypoints to reserve memory for
+  InterpolatedBuilder(
+      statespace::ConstStateSpacePtr _stateSpace,
+      statespace::ConstInterpolatorPtr _interpolator,
+      std::size_t _numWaypoints = 0);
+
+  /// Reserves memory for waypoints, so that adding them does not reallocate.
+  ///
+  /// \param _numWaypoints total number of waypoints
+  void reserve(std::size_t _numWaypoints);
+
+  /// Appends a waypoint after the waypoints added so far.
+  ///
+  /// \param _t time of the waypoint
+  /// \param _state state at the waypoint, which is copied
+  /// \throws std::invalid_argument if \c _t is not after the time of the
+  /// previous waypoint.
+  void addWaypoint(double _t, const statespace::StateSpace::State* _state);
+
+  /// Gets the number of waypoints added so far.
+  std::size_t getNumWaypoints() const;
+
+  /// Returns the trajectory through the waypoints added so far. Afterwards,
+  /// the builder is empty and can be used to build another trajectory.
+  ///
+  /// \return interpolated trajectory
+  std::unique_ptr<Interpolated> finalize();
+
+private:
+  statespace::ConstStateSpacePtr mStateSpace;
+  statespace::ConstInterpolatorPtr mInterpolator;
+
+  /// Trajectory under construction.
+  std::unique_ptr<Interpolated> mTrajectory;
+};
+
+} // namespace trajectory
+} // namespace aikido
+
+#endif // ifndef AIKIDO_TRAJECTORY_INTERPOLATEDBUILDER_HPP_
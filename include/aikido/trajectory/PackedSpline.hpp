@@ -0,0 +1,237 @@
+#ifndef AIKIDO_TRAJECTORY_PACKEDSPLINE_HPP_
+#define AIKIDO_TRAJECTORY_PACKEDSPLINE_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "aikido/common/pointers.hpp"
+#include "Spline.hpp"
+#include "Trajectory.hpp"
+
+namespace aikido {
+namespace trajectory {
+
+AIKIDO_DECLARE_POINTERS(PackedSpline)
+
+/// Polynomial spline trajectory that stores all of its segments in one
+/// contiguous block of memory. It represents the same trajectories as
+/// \c Spline, but only in state spaces where \c compose and \c expMap reduce
+/// to vector addition: \c Rn, \c SO2, and \c CartesianProduct spaces
+/// consisting of those types.
+///
+/// In those spaces the start state of a segment is folded into the constant
+/// coefficient of its polynomial, so a segment is a (num dimensions) x
+/// (num coefficients) column-major block of the shared buffer. Evaluation is a
+/// Horner scheme over whole columns of that block followed by a single
+/// \c expMap, with no per-segment state.
+///
+/// Use \c PackedSpline(const Spline&) and \c toSpline() to convert from and to
+/// \c Spline. A \c PackedSpline can also view segments stored in that layout
+/// in an external buffer, e.g. a memory-mapped file, without copying them.
+class PackedSpline : public Trajectory
+{
+public:
+  /// Constructs an empty trajectory.
+  ///
+  /// \param _stateSpace state space this trajectory is defined in
+  /// \param _startTime start time of the trajectory
+  /// \throws std::invalid_argument if \c _stateSpace is not supported.
+  PackedSpline(
+      statespace::ConstStateSpacePtr _stateSpace, double _startTime = 0.);
+
+  /// Constructs a trajectory with the same segments as a \c Spline.
+  ///
+  /// \param _spline spline to copy
+  /// \throws std::invalid_argument if the state space of \c _spline is not
+  /// supported.
+  explicit PackedSpline(const Spline& _spline);
+
+  /// Constructs a trajectory that evaluates segments stored in external
+  /// arrays without copying them. The arrays hold the same values as
+  /// \c getWaypointTime() and \c getSegmentCoefficients() and must not be
+  /// modified while this trajectory exists. Segments cannot be added to it.
+  ///
+  /// \param _stateSpace state space this trajectory is defined in
+  /// \param _knotTimes \c _numSegments + 1 start times of the segments,
+  /// followed by the end time of the trajectory
+  /// \param _columnOffsets \c _numSegments + 1 indices of the first
+  /// coefficient column of each segment in \c _coefficients, followed by the
+  /// total number of columns
+  /// \param _coefficients column-major coefficients of all segments
+  /// \param _numSegments number of segments
+  /// \param _buffer owner of the arrays, which this trajectory keeps alive
+  /// \throws std::invalid_argument if \c _stateSpace is not supported, an
+  /// array is nullptr, the knot times are not increasing, or a segment has no
+  /// coefficients.
+  PackedSpline(
+      statespace::ConstStateSpacePtr _stateSpace,
+      const double* _knotTimes,
+      const std::uint64_t* _columnOffsets,
+      const double* _coefficients,
+      std::size_t _numSegments,
+      std::shared_ptr<const void> _buffer = nullptr);
+
+  /// Returns whether a state space is supported by this trajectory.
+  ///
+  /// \param _stateSpace state space to check
+  static bool isSupported(const statespace::StateSpace* _stateSpace);
+
+  /// Add a segment to the end of this trajectory. See
+  /// \c Spline::addSegment() for the meaning of the arguments.
+  ///
+  /// \param _coefficients polynomial coefficients
+  /// \param _duration duration of this segment, must be positive
+  /// \param _startState start state of the segment
+  /// \throws std::logic_error if this trajectory views external arrays.
+  void addSegment(
+      const Eigen::MatrixXd& _coefficients,
+      double _duration,
+      const statespace::StateSpace::State* _startState);
+
+  /// Reserves memory for segments, so that adding them does not reallocate.
+  ///
+  /// \param _numSegments total number of segments
+  /// \param _numCoefficients number of coefficients per segment
+  /// \throws std::logic_error if this trajectory views external arrays.
+  void reserve(std::size_t _numSegments, std::size_t _numCoefficients);
+
+  /// Gets the number of segments in this spline.
+  ///
+  /// \return number of segments in this spline
+  std::size_t getNumSegments() const;
+
+  /// Gets the polynomial coefficients of a segment. Unlike
+  /// \c Spline::getSegmentCoefficients(), the constant coefficients include
+  /// the start position of the segment.
+  ///
+  /// \param _index segment index
+  /// \return view of the coefficients of the segment at index \c _index
+  Eigen::Map<const Eigen::MatrixXd> getSegmentCoefficients(
+      std::size_t _index) const;
+
+  /// Gets the time of a waypoint, i.e. the start time of a segment or, for
+  /// index \c getNumSegments(), the end time of the trajectory.
+  ///
+  /// \param _index waypoint index
+  /// \return time of the waypoint at index \c _index
+  double getWaypointTime(std::size_t _index) const;
+
+  /// Converts this trajectory to a \c Spline. The start state of each segment
+  /// is the state at the start of the segment, and the constant coefficients
+  /// of the segments are zero.
+  ///
+  /// \return spline with the same segments as this trajectory
+  std::unique_ptr<Spline> toSpline() const;
+
+  // Documentation inherited.
+  statespace::ConstStateSpacePtr getStateSpace() const override;
+
+  // Documentation inherited.
+  std::size_t getNumDerivatives() const override;
+
+  // Documentation inherited.
+  double getStartTime() const override;
+
+  // Documentation inherited.
+  double getEndTime() const override;
+
+  // Documentation inherited.
+  double getDuration() const override;
+
+  // Documentation inherited.
+  void evaluate(
+      double _t, statespace::StateSpace::State* _state) const override;
+
+  // Documentation inherited.
+  void evaluateDerivative(
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _tangentVector) const override;
+
+  using Trajectory::sample;
+
+  // Documentation inherited.
+  void sample(
+      const std::vector<double>& _times,
+      Eigen::MatrixXd* _positions,
+      Eigen::MatrixXd* _velocities = nullptr,
+      Eigen::MatrixXd* _accelerations = nullptr) const override;
+
+  /// Evaluates a derivative of a polynomial with Horner's scheme, for all rows
+  /// of \c _coefficients at once. See \c Spline::addSegment() for the layout
+  /// of \c _coefficients. Derivatives of order higher than the polynomial are
+  /// zero.
+  ///
+  /// \param _coefficients polynomial coefficients
+  /// \param _t time parameter
+  /// \param _derivative order of derivative, or zero for the value
+  /// \param[out] _out output vector
+  static void evaluatePolynomial(
+      const Eigen::Ref<const Eigen::MatrixXd>& _coefficients,
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _out);
+
+private:
+  /// Returns the index of the segment that contains time \c _t. A time on the
+  /// boundary belongs to the earlier segment, as in \c Spline.
+  std::size_t getSegmentForTime(double _t) const;
+
+  /// Throws std::logic_error if this trajectory views external arrays.
+  void checkNotView() const;
+
+  /// Returns the arrays of the segments, which are either owned by this
+  /// trajectory or external.
+  const double* getCoefficients() const;
+  const std::uint64_t* getColumnOffsets() const;
+  const double* getKnotTimes() const;
+
+  /// Evaluates a derivative of the polynomial of a segment.
+  ///
+  /// \param _segment segment index
+  /// \param _t time parameter, relative to the start of the segment
+  /// \param _derivative order of derivative, or zero for the position
+  /// \param[out] _out output vector
+  void evaluatePolynomial(
+      std::size_t _segment,
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _out) const;
+
+  statespace::ConstStateSpacePtr mStateSpace;
+
+  /// Dimension of the state space.
+  Eigen::Index mDimension;
+
+  /// Maximum number of non-zero derivatives of the segments.
+  std::size_t mNumDerivatives;
+
+  /// Number of segments.
+  std::size_t mNumSegments;
+
+  /// Coefficients of all segments, one column-major block per segment. The
+  /// constant coefficient includes the start position of the segment.
+  std::vector<double> mCoefficients;
+
+  /// Index of the first coefficient column of each segment in mCoefficients,
+  /// followed by the total number of columns.
+  std::vector<std::uint64_t> mColumnOffsets;
+
+  /// Start time of each segment, followed by the end time of the trajectory.
+  std::vector<double> mKnotTimes;
+
+  /// External arrays in the layout of mCoefficients, mColumnOffsets, and
+  /// mKnotTimes, which are empty if this trajectory views them. mKnotTimeView
+  /// is nullptr if this trajectory owns its arrays.
+  const double* mCoefficientView;
+  const std::uint64_t* mColumnOffsetView;
+  const double* mKnotTimeView;
+
+  /// Keeps the external arrays alive, if any.
+  std::shared_ptr<const void> mBuffer;
+};
+
+} // namespace trajectory
+} // namespace aikido
+
+#endif // ifndef AIKIDO_TRAJECTORY_PACKEDSPLINE_HPP_
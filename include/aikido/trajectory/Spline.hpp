@@ -1,6 +1,8 @@
 #ifndef AIKIDO_TRAJECTORY_SPLINETRAJECTORY2_HPP_
 #define AIKIDO_TRAJECTORY_SPLINETRAJECTORY2_HPP_
 
+#include <atomic>
+#include <functional>
 #include "aikido/common/pointers.hpp"
 #include "Trajectory.hpp"
 
@@ -76,11 +78,39 @@ public:
   /// \param _duration duration of this segment, must be positive
   void addSegment(const Eigen::MatrixXd& _coefficients, double _duration);
 
+  /// Removes the segment at index \c _index and all segments after it, e.g.
+  /// to replace the end of the trajectory with new segments.
+  ///
+  /// \param _index index of the first segment to remove
+  /// \throws std::domain_error if \c _index is greater than the number of
+  /// segments
+  void removeSegments(std::size_t _index);
+
   /// Gets the number of segments in this spline.
   ///
   /// \return number of segments in this spline
   std::size_t getNumSegments() const;
 
+  /// Gets the polynomial coefficients of a segment, in the tangent space of
+  /// its start state. See \c addSegment() for their layout.
+  ///
+  /// \param _index segment index
+  /// \return coefficients of the segment at index \c _index
+  const Eigen::MatrixXd& getSegmentCoefficients(std::size_t _index) const;
+
+  /// Gets the start state of a segment.
+  ///
+  /// \param _index segment index
+  /// \return start state of the segment at index \c _index
+  const statespace::StateSpace::State* getSegmentStartState(
+      std::size_t _index) const;
+
+  /// Gets the duration of a segment.
+  ///
+  /// \param _index segment index
+  /// \return duration of the segment at index \c _index
+  double getSegmentDuration(std::size_t _index) const;
+
   // Documentation inherited.
   statespace::ConstStateSpacePtr getStateSpace() const override;
 
@@ -106,6 +136,15 @@ public:
       int _derivative,
       Eigen::VectorXd& _tangentVector) const override;
 
+  using Trajectory::sample;
+
+  // Documentation inherited.
+  void sample(
+      const std::vector<double>& _times,
+      Eigen::MatrixXd* _positions,
+      Eigen::MatrixXd* _velocities = nullptr,
+      Eigen::MatrixXd* _accelerations = nullptr) const override;
+
   /// Gets the number of waypoints.
   /// \return The number of waypoints
   std::size_t getNumWaypoints() const;
@@ -132,22 +171,65 @@ public:
       int _derivative,
       Eigen::VectorXd& _tangentVector) const;
 
+  /// Function called by \c visitWaypoints() with the index, the time, the
+  /// state, and the first derivative of a waypoint.
+  using WaypointVisitor = std::function<void(
+      std::size_t,
+      double,
+      const statespace::StateSpace::State*,
+      const Eigen::VectorXd&)>;
+
+  /// Visits all waypoints in order. This produces the same values as calling
+  /// \c getWaypointTime(), \c getWaypoint(), and \c getWaypointDerivative()
+  /// with \c _derivative = 1 for each index, but takes time linear in the
+  /// number of waypoints. The state and tangent vector passed to \c _visitor
+  /// are reused for every waypoint and must be copied to be kept.
+  ///
+  /// \param _visitor function called once per waypoint
+  void visitWaypoints(const WaypointVisitor& _visitor) const;
+
 private:
+  friend class SplineCursor;
+
   struct PolynomialSegment
   {
     statespace::StateSpace::State* mStartState;
     Eigen::MatrixXd mCoefficients;
     double mDuration;
+
+    /// Time at which the segment starts.
+    double mStartTime;
+
+    /// Coefficients of the derivatives of the polynomial. The (n - 1)-th
+    /// matrix holds the coefficients of the n-th derivative.
+    std::vector<Eigen::MatrixXd> mDerivativeCoefficients;
   };
 
-  static Eigen::VectorXd evaluatePolynomial(
-      const Eigen::MatrixXd& _coefficients, double _t, int _derivative);
+  /// Evaluates a derivative of the polynomial of a segment with Horner's
+  /// scheme. Derivatives of order higher than the polynomial are zero.
+  ///
+  /// \param _segment segment to evaluate
+  /// \param _t time parameter, relative to the start of the segment
+  /// \param _derivative order of derivative, or zero for the value
+  /// \param[out] _out output vector
+  static void evaluatePolynomial(
+      const PolynomialSegment& _segment,
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _out);
 
   std::pair<std::size_t, double> getSegmentForTime(double _t) const;
 
   statespace::ConstStateSpacePtr mStateSpace;
   double mStartTime;
   std::vector<PolynomialSegment> mSegments;
+
+  /// Sum of the durations of all segments.
+  double mDuration;
+
+  /// Segment found by the last call to getSegmentForTime(). Consecutive
+  /// evaluations usually fall into the same or the next segment.
+  mutable std::atomic<std::size_t> mSegmentHint;
 };
 
 } // namespace trajectory
@@ -0,0 +1,79 @@
+#ifndef AIKIDO_TRAJECTORY_SPLINECURSOR_HPP_
+#define AIKIDO_TRAJECTORY_SPLINECURSOR_HPP_
+
+#include <Eigen/Core>
+#include "../statespace/StateSpace.hpp"
+#include "Spline.hpp"
+
+namespace aikido {
+namespace trajectory {
+
+/// Evaluates a \c Spline at a sequence of non-decreasing times, such as when
+/// sampling a trajectory for collision checking.
+///
+/// The cursor remembers the segment of the last query and only moves forward
+/// from it, so a sweep over the trajectory looks up each segment once instead
+/// of searching from the start for every sample. The workspace is reused, so
+/// evaluation does not allocate. Querying a time before the previous one is
+/// allowed, but restarts the segment search.
+///
+/// The cursor refers to the spline it was created or last reset with, which
+/// must outlive it and must not be modified while it is in use.
+class SplineCursor
+{
+public:
+  /// Constructor.
+  ///
+  /// \param _spline spline to evaluate
+  explicit SplineCursor(const Spline& _spline);
+
+  /// Evaluates the state of the spline at time \c _t. Produces the same
+  /// result as \c Spline::evaluate().
+  ///
+  /// \param _t time parameter
+  /// \param[out] _state output state of the spline at time \c _t
+  void evaluate(double _t, statespace::StateSpace::State* _state);
+
+  /// Evaluates the derivative of the spline at time \c _t. Produces the same
+  /// result as \c Spline::evaluateDerivative().
+  ///
+  /// \param _t time parameter
+  /// \param _derivative order of derivative
+  /// \param[out] _tangentVector output tangent vector
+  void evaluateDerivative(
+      double _t, int _derivative, Eigen::VectorXd& _tangentVector);
+
+  /// Forgets the segment of the last query.
+  void reset();
+
+  /// Rebinds the cursor to another spline, reusing its workspace.
+  ///
+  /// \param _spline spline to evaluate
+  /// \throw std::invalid_argument if \c _spline is not in the state space of
+  /// the current spline
+  void reset(const Spline& _spline);
+
+private:
+  /// Moves the cursor to the segment that contains time \c _t.
+  void seek(double _t);
+
+  /// Spline to evaluate.
+  const Spline* mSpline;
+
+  /// Whether the cursor is at a segment.
+  bool mValid;
+
+  /// Index of the current segment.
+  std::size_t mSegmentIndex;
+
+  /// Workspace for the polynomial value.
+  Eigen::VectorXd mTangentVector;
+
+  /// Workspace for the state relative to the segment start state.
+  statespace::StateSpace::ScopedState mRelativeState;
+};
+
+} // namespace trajectory
+} // namespace aikido
+
+#endif // AIKIDO_TRAJECTORY_SPLINECURSOR_HPP_
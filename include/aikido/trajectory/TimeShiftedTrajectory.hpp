@@ -0,0 +1,74 @@
+#ifndef AIKIDO_TRAJECTORY_TIMESHIFTEDTRAJECTORY_HPP_
+#define AIKIDO_TRAJECTORY_TIMESHIFTEDTRAJECTORY_HPP_
+
+#include "aikido/common/pointers.hpp"
+#include "Trajectory.hpp"
+
+namespace aikido {
+namespace trajectory {
+
+AIKIDO_DECLARE_POINTERS(TimeShiftedTrajectory)
+
+/// View of a trajectory that is shifted in time. Evaluating the view at time
+/// \c t evaluates the underlying trajectory at time \c t minus the offset.
+///
+/// The view shares the underlying trajectory instead of copying it, so it is
+/// cheap to create regardless of the size of the trajectory.
+class TimeShiftedTrajectory : public Trajectory
+{
+public:
+  /// Constructor.
+  ///
+  /// \param _trajectory trajectory to shift
+  /// \param _timeOffset time added to the times of \c _trajectory
+  TimeShiftedTrajectory(ConstTrajectoryPtr _trajectory, double _timeOffset);
+
+  /// Gets the underlying trajectory.
+  ConstTrajectoryPtr getTrajectory() const;
+
+  /// Gets the time added to the times of the underlying trajectory.
+  double getTimeOffset() const;
+
+  // Documentation inherited.
+  statespace::ConstStateSpacePtr getStateSpace() const override;
+
+  // Documentation inherited.
+  std::size_t getNumDerivatives() const override;
+
+  // Documentation inherited.
+  double getDuration() const override;
+
+  // Documentation inherited.
+  double getStartTime() const override;
+
+  // Documentation inherited.
+  double getEndTime() const override;
+
+  // Documentation inherited.
+  void evaluate(
+      double _t, statespace::StateSpace::State* _state) const override;
+
+  // Documentation inherited.
+  void evaluateDerivative(
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _tangentVector) const override;
+
+  using Trajectory::sample;
+
+  // Documentation inherited.
+  void sample(
+      const std::vector<double>& _times,
+      Eigen::MatrixXd* _positions,
+      Eigen::MatrixXd* _velocities = nullptr,
+      Eigen::MatrixXd* _accelerations = nullptr) const override;
+
+private:
+  ConstTrajectoryPtr mTrajectory;
+  double mTimeOffset;
+};
+
+} // namespace trajectory
+} // namespace aikido
+
+#endif // ifndef AIKIDO_TRAJECTORY_TIMESHIFTEDTRAJECTORY_HPP_
@@ -1,6 +1,7 @@
 #ifndef AIKIDO_TRAJECTORY_TRAJECTORY_HPP_
 #define AIKIDO_TRAJECTORY_TRAJECTORY_HPP_
 
+#include <vector>
 #include <Eigen/Core>
 #include "aikido/common/pointers.hpp"
 #include <aikido/trajectory/TrajectoryMetadata.hpp>
@@ -71,11 +72,77 @@ public:
   virtual void evaluateDerivative(
       double _t, int _derivative, Eigen::VectorXd& _tangentVector) const = 0;
 
+  /// Evaluates the trajectory at each of \c _times. The i-th column of each
+  /// output matrix holds the sample at \c _times[i]: positions are the
+  /// \c logMap of the state, and velocities and accelerations are the first
+  /// and second derivatives, as returned by \c evaluateDerivative(). Outputs
+  /// that are \c nullptr are not computed.
+  ///
+  /// This produces the same values as calling \c evaluate() and
+  /// \c evaluateDerivative() for each time, but implementations may share
+  /// work between samples. Sampling is fastest when \c _times is
+  /// non-decreasing.
+  ///
+  /// \param _times times to sample the trajectory at
+  /// \param[out] _positions (dimension) x (number of times) matrix of positions
+  /// \param[out] _velocities (dimension) x (number of times) matrix of
+  /// velocities
+  /// \param[out] _accelerations (dimension) x (number of times) matrix of
+  /// accelerations
+  virtual void sample(
+      const std::vector<double>& _times,
+      Eigen::MatrixXd* _positions,
+      Eigen::MatrixXd* _velocities = nullptr,
+      Eigen::MatrixXd* _accelerations = nullptr) const;
+
+  /// Evaluates the trajectory at \c _numSamples times, starting at
+  /// \c _startTime and spaced \c _timeStep apart. See the other overload of
+  /// this function for the layout of the outputs.
+  ///
+  /// \param _startTime time of the first sample
+  /// \param _timeStep time between consecutive samples, must be non-negative
+  /// \param _numSamples number of samples
+  /// \param[out] _positions (dimension) x \c _numSamples matrix of positions
+  /// \param[out] _velocities (dimension) x \c _numSamples matrix of velocities
+  /// \param[out] _accelerations (dimension) x \c _numSamples matrix of
+  /// accelerations
+  void sample(
+      double _startTime,
+      double _timeStep,
+      std::size_t _numSamples,
+      Eigen::MatrixXd* _positions,
+      Eigen::MatrixXd* _velocities = nullptr,
+      Eigen::MatrixXd* _accelerations = nullptr) const;
+
   /// Trajectory metadata
   TrajectoryMetadata metadata;
+
+protected:
+  /// Fills the outputs of \c sample() one value at a time. The outputs that
+  /// are not \c nullptr are resized, and for each of \c _times,
+  /// \c _evaluate(t, order, tangentVector) is called once per output in
+  /// increasing order: 0 for the \c logMap of the state, 1 for the velocity
+  /// and 2 for the acceleration.
+  ///
+  /// \param _dimension dimension of the state space
+  /// \param _times times to sample the trajectory at
+  /// \param[out] _positions matrix of positions, or \c nullptr
+  /// \param[out] _velocities matrix of velocities, or \c nullptr
+  /// \param[out] _accelerations matrix of accelerations, or \c nullptr
+  /// \param _evaluate function that evaluates one value
+  template <typename Evaluate>
+  static void sampleWith(
+      std::size_t _dimension,
+      const std::vector<double>& _times,
+      Eigen::MatrixXd* _positions,
+      Eigen::MatrixXd* _velocities,
+      Eigen::MatrixXd* _accelerations,
+      Evaluate&& _evaluate);
 };
 
 } // namespace trajectory
 } // namespace aikido
 
+#include "detail/Trajectory-impl.hpp"
+
 #endif // ifndef AIKIDO_TRAJECTORY_TRAJECTORY_HPP_
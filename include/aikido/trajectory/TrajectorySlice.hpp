@@ -0,0 +1,82 @@
+#ifndef AIKIDO_TRAJECTORY_TRAJECTORYSLICE_HPP_
+#define AIKIDO_TRAJECTORY_TRAJECTORYSLICE_HPP_
+
+#include "aikido/common/pointers.hpp"
+#include "Trajectory.hpp"
+
+namespace aikido {
+namespace trajectory {
+
+AIKIDO_DECLARE_POINTERS(TrajectorySlice)
+
+/// View of the part of a trajectory between two times. The view keeps the
+/// times of the underlying trajectory, so it starts at the start of the window
+/// rather than at zero; wrap it in a \c TimeShiftedTrajectory to change that.
+/// Times outside of the window are clamped to it.
+///
+/// The view shares the underlying trajectory instead of copying it, so it is
+/// cheap to create regardless of the size of the trajectory.
+class TrajectorySlice : public Trajectory
+{
+public:
+  /// Constructor.
+  ///
+  /// \param _trajectory trajectory to slice
+  /// \param _startTime start time of the slice
+  /// \param _endTime end time of the slice
+  /// \throws std::invalid_argument if \c _trajectory is null, if
+  /// \c _startTime is not strictly less than \c _endTime, or if the window is
+  /// not contained in the time range of \c _trajectory.
+  TrajectorySlice(
+      ConstTrajectoryPtr _trajectory, double _startTime, double _endTime);
+
+  /// Gets the underlying trajectory.
+  ConstTrajectoryPtr getTrajectory() const;
+
+  // Documentation inherited.
+  statespace::ConstStateSpacePtr getStateSpace() const override;
+
+  // Documentation inherited.
+  std::size_t getNumDerivatives() const override;
+
+  // Documentation inherited.
+  double getDuration() const override;
+
+  // Documentation inherited.
+  double getStartTime() const override;
+
+  // Documentation inherited.
+  double getEndTime() const override;
+
+  // Documentation inherited.
+  void evaluate(
+      double _t, statespace::StateSpace::State* _state) const override;
+
+  // Documentation inherited.
+  void evaluateDerivative(
+      double _t,
+      int _derivative,
+      Eigen::VectorXd& _tangentVector) const override;
+
+  using Trajectory::sample;
+
+  // Documentation inherited.
+  void sample(
+      const std::vector<double>& _times,
+      Eigen::MatrixXd* _positions,
+      Eigen::MatrixXd* _velocities = nullptr,
+      Eigen::MatrixXd* _accelerations = nullptr) const override;
+
+private:
+  /// Clamps \c _t to the window of this slice.
+  double clampTime(double _t) const;
+
+  ConstTrajectoryPtr mTrajectory;
+  double mStartTime;
+  double mEndTime;
+};
+
+} // namespace trajectory
+} // namespace aikido
+
+#endif // ifndef AIKIDO_TRAJECTORY_TRAJECTORYSLICE_HPP_
@@ -0,0 +1,47 @@
+#ifndef AIKIDO_TRAJECTORY_DETAIL_TRAJECTORY_IMPL_HPP_
+#define AIKIDO_TRAJECTORY_DETAIL_TRAJECTORY_IMPL_HPP_
+
+#include "aikido/trajectory/Trajectory.hpp"
+
+namespace aikido {
+namespace trajectory {
+
+//==============================================================================
+template <typename Evaluate>
+void Trajectory::sampleWith(
+    std::size_t _dimension,
+    const std::vector<double>& _times,
+    Eigen::MatrixXd* _positions,
+    Eigen::MatrixXd* _velocities,
+    Eigen::MatrixXd* _accelerations,
+    Evaluate&& _evaluate)
+{
+  const auto dimension = static_cast<Eigen::Index>(_dimension);
+  const auto numSamples = static_cast<Eigen::Index>(_times.size());
+
+  // Outputs indexed by the order of the derivative they hold.
+  Eigen::MatrixXd* const outputs[] = {_positions, _velocities, _accelerations};
+  for (const auto output : outputs)
+  {
+    if (output)
+      output->resize(dimension, numSamples);
+  }
+
+  Eigen::VectorXd tangentVector;
+  for (Eigen::Index i = 0; i < numSamples; ++i)
+  {
+    for (int order = 0; order < 3; ++order)
+    {
+      if (!outputs[order])
+        continue;
+
+      _evaluate(_times[i], order, tangentVector);
+      outputs[order]->col(i) = tangentVector;
+    }
+  }
+}
+
+} // namespace trajectory
+} // namespace aikido
+
+#endif // AIKIDO_TRAJECTORY_DETAIL_TRAJECTORY_IMPL_HPP_
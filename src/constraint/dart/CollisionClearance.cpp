@@ -0,0 +1,111 @@
+#include "aikido/constraint/dart/CollisionClearance.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <dart/collision/DistanceResult.hpp>
+
+namespace aikido {
+namespace constraint {
+namespace dart {
+
+//==============================================================================
+CollisionClearance::CollisionClearance(
+    statespace::dart::MetaSkeletonStateSpacePtr _metaSkeletonStateSpace,
+    ::dart::dynamics::MetaSkeletonPtr _metaskeleton,
+    std::shared_ptr<::dart::collision::CollisionDetector> _collisionDetector,
+    const Eigen::VectorXd& _displacementBounds,
+    ::dart::collision::DistanceOption _distanceOptions)
+  : mMetaSkeletonStateSpace(std::move(_metaSkeletonStateSpace))
+  , mMetaSkeleton(std::move(_metaskeleton))
+  , mCollisionDetector(std::move(_collisionDetector))
+  , mDistanceOptions(std::move(_distanceOptions))
+{
+  if (!mMetaSkeletonStateSpace)
+    throw std::invalid_argument("_metaSkeletonStateSpace is nullptr.");
+
+  if (!mMetaSkeleton)
+    throw std::invalid_argument("_metaskeleton is nullptr.");
+
+  if (!mCollisionDetector)
+    throw std::invalid_argument("_collisionDetector is nullptr.");
+
+  if (static_cast<std::size_t>(_displacementBounds.size())
+      != mMetaSkeletonStateSpace->getDimension())
+    throw std::invalid_argument("_displacementBounds has wrong dimension.");
+
+  if ((_displacementBounds.array() < 0.).any())
+    throw std::invalid_argument("_displacementBounds must be non-negative.");
+
+  mDisplacementBound = _displacementBounds.sum();
+}
+
+//==============================================================================
+double CollisionClearance::getClearance(
+    const statespace::StateSpace::State* _state) const
+{
+  const double distance = getDistance(_state);
+  if (distance <= 0.)
+    return 0.;
+
+  // Nothing that is checked can move, so the state is never in collision.
+  if (mDisplacementBound == 0.)
+    return std::numeric_limits<double>::infinity();
+
+  return distance / mDisplacementBound;
+}
+
+//==============================================================================
+statespace::StateSpacePtr CollisionClearance::getStateSpace() const
+{
+  return mMetaSkeletonStateSpace;
+}
+
+//==============================================================================
+double CollisionClearance::getDistance(
+    const statespace::StateSpace::State* _state) const
+{
+  auto skelStatePtr = static_cast<const aikido::statespace::dart::
+                                      MetaSkeletonStateSpace::State*>(_state);
+  mMetaSkeletonStateSpace->setState(mMetaSkeleton.get(), skelStatePtr);
+
+  double minDistance = std::numeric_limits<double>::infinity();
+  ::dart::collision::DistanceResult distanceResult;
+  for (const auto& groups : mGroupsToPairwiseCheck)
+  {
+    minDistance = std::min(
+        minDistance,
+        mCollisionDetector->distance(
+            groups.first.get(),
+            groups.second.get(),
+            mDistanceOptions,
+            &distanceResult));
+  }
+
+  for (const auto& group : mGroupsToSelfCheck)
+  {
+    minDistance = std::min(
+        minDistance,
+        mCollisionDetector->distance(
+            group.get(), mDistanceOptions, &distanceResult));
+  }
+  return minDistance;
+}
+
+//==============================================================================
+void CollisionClearance::addPairwiseCheck(
+    std::shared_ptr<::dart::collision::CollisionGroup> _group1,
+    std::shared_ptr<::dart::collision::CollisionGroup> _group2)
+{
+  mGroupsToPairwiseCheck.emplace_back(std::move(_group1), std::move(_group2));
+}
+
+//==============================================================================
+void CollisionClearance::addSelfCheck(
+    std::shared_ptr<::dart::collision::CollisionGroup> _group)
+{
+  mGroupsToSelfCheck.emplace_back(std::move(_group));
+}
+
+} // namespace dart
+} // namespace constraint
+} // namespace aikido
@@ -159,42 +159,6 @@ void extractJointTrajectoryPoint(
   }
 }
 
-//==============================================================================
-void extractTrajectoryPoint(
-    const std::shared_ptr<const MetaSkeletonStateSpace>& space,
-    const aikido::trajectory::TrajectoryPtr& trajectory,
-    double timeFromStart,
-    trajectory_msgs::JointTrajectoryPoint& waypoint)
-{
-  const auto numDerivatives = std::min<int>(trajectory->getNumDerivatives(), 1);
-  const auto timeAbsolute = trajectory->getStartTime() + timeFromStart;
-  const int numDof = space->getDimension();
-  DART_UNUSED(numDof);
-
-  Eigen::VectorXd tangentVector;
-  auto state = space->createState();
-  trajectory->evaluate(timeAbsolute, state);
-  space->logMap(state, tangentVector);
-
-  assert(tangentVector.size() == numDof);
-
-  waypoint.time_from_start = ::ros::Duration(timeFromStart);
-  waypoint.positions.assign(
-      tangentVector.data(), tangentVector.data() + tangentVector.size());
-
-  assert(0 <= numDerivatives && numDerivatives <= 2);
-  const std::array<std::vector<double>*, 2> derivatives{
-      &waypoint.velocities, &waypoint.accelerations};
-  for (int iDerivative = 1; iDerivative <= numDerivatives; ++iDerivative)
-  {
-    trajectory->evaluateDerivative(timeAbsolute, iDerivative, tangentVector);
-    assert(tangentVector.size() == numDof);
-
-    derivatives[iDerivative - 1]->assign(
-        tangentVector.data(), tangentVector.data() + tangentVector.size());
-  }
-}
-
 //==============================================================================
 // The rows of inVector is reordered in outVector.
 void reorder(
@@ -495,15 +459,36 @@ trajectory_msgs::JointTrajectory toRosJointTrajectory(
     jointTrajectory.joint_names.emplace_back(jointDofName);
   }
 
-  // Evaluate trajectory at each timestep and insert it into jointTrajectory
-  jointTrajectory.points.reserve(numWaypoints);
+  // Evaluate trajectory at all timesteps at once. Accelerations are not
+  // included.
+  std::vector<double> times;
+  times.reserve(numWaypoints);
   for (const auto timeFromStart : timeSequence)
+    times.emplace_back(trajectory->getStartTime() + timeFromStart);
+
+  const bool hasVelocities = trajectory->getNumDerivatives() > 0;
+  Eigen::MatrixXd positions;
+  Eigen::MatrixXd velocities;
+  trajectory->sample(
+      times, &positions, hasVelocities ? &velocities : nullptr, nullptr);
+
+  // Insert the samples into jointTrajectory
+  jointTrajectory.points.resize(numWaypoints);
+  for (std::size_t i = 0; i < numWaypoints; ++i)
   {
-    trajectory_msgs::JointTrajectoryPoint waypoint;
+    auto& waypoint = jointTrajectory.points[i];
+    const auto position = positions.col(i);
 
-    extractTrajectoryPoint(space, trajectory, timeFromStart, waypoint);
+    waypoint.time_from_start = ::ros::Duration(timeSequence[i]);
+    waypoint.positions.assign(
+        position.data(), position.data() + position.size());
 
-    jointTrajectory.points.emplace_back(waypoint);
+    if (hasVelocities)
+    {
+      const auto velocity = velocities.col(i);
+      waypoint.velocities.assign(
+          velocity.data(), velocity.data() + velocity.size());
+    }
   }
 
   return jointTrajectory;
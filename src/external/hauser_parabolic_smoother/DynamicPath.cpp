@@ -90,11 +90,13 @@ inline bool SolveMinTime(const Vector& x0,const Vector& dx0,const Vector& x1,con
     if(res < 0) return false;
     CombineRamps(ramps,out.ramps);
   }
+  out.UpdateRampStartTimes();
   PARABOLIC_RAMP_ASSERT(out.IsValid());
   return true;
 }
 
 DynamicPath::DynamicPath()
+  :rampStartTimes(1,0)
 {}
 
 void DynamicPath::Init(const Vector& _velMax,const Vector& _accMax)
@@ -113,11 +115,20 @@ void DynamicPath::SetJointLimits(const Vector& _xMin,const Vector& _xMax)
   if(!velMax.empty() && !xMin.empty()) PARABOLIC_RAMP_ASSERT(xMin.size() == velMax.size());
 }
 
+void DynamicPath::UpdateRampStartTimes(std::size_t first)
+{
+  assert(first == 0 || first < rampStartTimes.size());
+  assert(first <= ramps.size());
+  rampStartTimes.resize(ramps.size()+1);
+  if(first == 0) rampStartTimes[0] = 0;
+  for(std::size_t i=first;i<ramps.size();i++)
+    rampStartTimes[i+1] = rampStartTimes[i]+ramps[i].endTime;
+}
+
 Real DynamicPath::GetTotalTime() const
 {
-  Real t=0;
-  for(std::size_t i=0;i<ramps.size();i++) t+=ramps[i].endTime;
-  return t;
+  assert(rampStartTimes.size() == ramps.size()+1);
+  return rampStartTimes.back();
 }
 
 int DynamicPath::GetSegment(Real t,Real& u,bool& outOfBounds) const
@@ -127,53 +138,40 @@ int DynamicPath::GetSegment(Real t,Real& u,bool& outOfBounds) const
     outOfBounds = true;
     return 0;
   }
-  for(std::size_t i=0;i<ramps.size();i++) {
-    if(t <= ramps[i].endTime) {
-      u = t;
-      outOfBounds = false;
-      return (int)i;
-    }
-    t -= ramps[i].endTime;
+  assert(rampStartTimes.size() == ramps.size()+1);
+  //first ramp that ends at or after t
+  std::vector<Real>::const_iterator end = std::lower_bound(rampStartTimes.begin()+1,rampStartTimes.end(),t);
+  if(end == rampStartTimes.end()) {
+    u = t-rampStartTimes.back();
+    outOfBounds = true;
+    return (int)ramps.size() - 1;
   }
-  u = t;
-  outOfBounds = true;
-  return (int)ramps.size() - 1;
+  int i = (int)(end-rampStartTimes.begin()) - 1;
+  u = Min(t-rampStartTimes[i],ramps[i].endTime);
+  outOfBounds = false;
+  return i;
 }
 
 void DynamicPath::Evaluate(Real t,Vector& x) const
 {
   PARABOLIC_RAMP_ASSERT(!ramps.empty());
-  if(t < 0) {
-    x = ramps.front().x0;
-  }
-  else {
-    for(std::size_t i=0;i<ramps.size();i++) {
-      if(t <= ramps[i].endTime) {
-	ramps[i].Evaluate(t,x);
-	return;
-      }
-      t -= ramps[i].endTime;
-    }
-    x = ramps.back().x1;
-  }
+  Real u;
+  bool outOfBounds;
+  int i = GetSegment(t,u,outOfBounds);
+  if(!outOfBounds) ramps[i].Evaluate(u,x);
+  else if(t < 0) x = ramps.front().x0;
+  else x = ramps.back().x1;
 }
 
 void DynamicPath::Derivative(Real t,Vector& dx) const
 {
   PARABOLIC_RAMP_ASSERT(!ramps.empty());
-  if(t < 0) {
-    dx = ramps.front().dx0;
-  }
-  else {
-    for(std::size_t i=0;i<ramps.size();i++) {
-      if(t <= ramps[i].endTime) {
-	ramps[i].Derivative(t,dx);
-	return;
-      }
-      t -= ramps[i].endTime;
-    }
-    dx = ramps.back().dx1;
-  }
+  Real u;
+  bool outOfBounds;
+  int i = GetSegment(t,u,outOfBounds);
+  if(!outOfBounds) ramps[i].Derivative(u,dx);
+  else if(t < 0) dx = ramps.front().dx0;
+  else dx = ramps.back().dx1;
 }
 
 void DynamicPath::SetMilestones(const vector<Vector>& x)
@@ -197,6 +195,7 @@ void DynamicPath::SetMilestones(const vector<Vector>& x)
       PARABOLIC_RAMP_ASSERT(res);
     }
   }
+  UpdateRampStartTimes();
 }
 
 void DynamicPath::SetMilestones(const vector<Vector>& x,const vector<Vector>& dx)
@@ -238,6 +237,7 @@ void DynamicPath::SetMilestones(const vector<Vector>& x,const vector<Vector>& dx
       }
     }
   }
+  UpdateRampStartTimes();
 }
 
 void DynamicPath::GetMilestones(vector<Vector>& x,vector<Vector>& dx) const
@@ -288,6 +288,7 @@ void DynamicPath::Append(const Vector& x)
       ramps.insert(ramps.end(),tempRamps2.begin(),tempRamps2.end());
     }
   }
+  UpdateRampStartTimes();
 }
 
 void DynamicPath::Append(const Vector& x,const Vector& dx)
@@ -314,6 +315,7 @@ void DynamicPath::Append(const Vector& x,const Vector& dx)
     CombineRamps(tempRamps,tempRamps2);
     ramps.insert(ramps.end(),tempRamps2.begin(),tempRamps2.end());
   }
+  UpdateRampStartTimes();
 }
 
 void DynamicPath::Concat(const DynamicPath& suffix)
@@ -322,6 +324,7 @@ void DynamicPath::Concat(const DynamicPath& suffix)
   if(suffix.ramps.empty()) return;
   if(ramps.empty()) {
     *this=suffix;
+    UpdateRampStartTimes();
     return;
   }
   //double check continuity
@@ -352,6 +355,7 @@ void DynamicPath::Concat(const DynamicPath& suffix)
   PARABOLIC_RAMP_ASSERT(ramps.back().x1 == suffix.ramps.front().x0);
   PARABOLIC_RAMP_ASSERT(ramps.back().dx1 == suffix.ramps.front().dx0);
   ramps.insert(ramps.end(),suffix.ramps.begin(),suffix.ramps.end());
+  UpdateRampStartTimes();
 }
 
 void DynamicPath::Split(Real t,DynamicPath& before,DynamicPath& after) const
@@ -362,6 +366,8 @@ void DynamicPath::Split(Real t,DynamicPath& before,DynamicPath& after) const
   if(ramps.empty()) {
     before=*this;
     after=*this;
+    before.UpdateRampStartTimes();
+    after.UpdateRampStartTimes();
     return;
   }
   after.velMax = before.velMax = velMax;
@@ -413,6 +419,8 @@ void DynamicPath::Split(Real t,DynamicPath& before,DynamicPath& after) const
     temp.SetConstant(ramps.back().x1);
     after.ramps.push_back(temp);
   }
+  before.UpdateRampStartTimes();
+  after.UpdateRampStartTimes();
   PARABOLIC_RAMP_ASSERT(before.IsValid());
   PARABOLIC_RAMP_ASSERT(after.IsValid());
 }
@@ -623,6 +631,7 @@ bool DynamicPath::TryShortcut(Real t1,Real t2,RampFeasibilityChecker& check)
     intermediate.velMax = velMax;
     PARABOLIC_RAMP_ASSERT(intermediate.IsValid());
   }
+  intermediate.UpdateRampStartTimes();
   for(std::size_t i=0;i<intermediate.ramps.size();i++)
     if(!check.Check(intermediate.ramps[i])) return false;
 
@@ -655,6 +664,7 @@ bool DynamicPath::TryShortcut(Real t1,Real t2,RampFeasibilityChecker& check)
   if(delete_i1) {
     ramps.erase(ramps.begin()+i1);
   }
+  UpdateRampStartTimes();
   
   //check for consistency
   for(std::size_t i=0;i+1<ramps.size();i++) {
@@ -673,22 +683,18 @@ int DynamicPath::Shortcut(int numIters,RampFeasibilityChecker& check)
 int DynamicPath::Shortcut(int numIters,RampFeasibilityChecker& check,RandomNumberGeneratorBase* rng)
 {
   int shortcuts = 0;
-  vector<Real> rampStartTime(ramps.size()); 
-  Real endTime=0;
-  for(std::size_t i=0;i<ramps.size();i++) {
-    rampStartTime[i] = endTime;
-    endTime += ramps[i].endTime;
-  }
+  UpdateRampStartTimes();
+  Real endTime=rampStartTimes.back();
   Vector x0,x1,dx0,dx1;
   DynamicPath intermediate;
   for(int iters=0;iters<numIters;iters++) {
     Real t1=rng->Rand()*endTime,t2=rng->Rand()*endTime;
     if(t1 > t2) Swap(t1,t2);
-    int i1 = std::upper_bound(rampStartTime.begin(),rampStartTime.end(),t1)-rampStartTime.begin()-1;
-    int i2 = std::upper_bound(rampStartTime.begin(),rampStartTime.end(),t2)-rampStartTime.begin()-1;
+    int i1 = std::upper_bound(rampStartTimes.begin(),rampStartTimes.end()-1,t1)-rampStartTimes.begin()-1;
+    int i2 = std::upper_bound(rampStartTimes.begin(),rampStartTimes.end()-1,t2)-rampStartTimes.begin()-1;
     if(i1 == i2) continue; //same ramp
-    Real u1 = t1-rampStartTime[i1];
-    Real u2 = t2-rampStartTime[i2];
+    Real u1 = t1-rampStartTimes[i1];
+    Real u2 = t2-rampStartTimes[i2];
     PARABOLIC_RAMP_ASSERT(u1 >= 0);
     PARABOLIC_RAMP_ASSERT(u1 <= ramps[i1].endTime+EpsilonT);
     PARABOLIC_RAMP_ASSERT(u2 >= 0);
@@ -729,12 +735,8 @@ int DynamicPath::Shortcut(int numIters,RampFeasibilityChecker& check,RandomNumbe
     }
     
     //revise the timing
-    rampStartTime.resize(ramps.size());
-    endTime=0;
-    for(std::size_t i=0;i<ramps.size();i++) {
-      rampStartTime[i] = endTime;
-      endTime += ramps[i].endTime;
-    }
+    UpdateRampStartTimes();
+    endTime=rampStartTimes.back();
   }
   return shortcuts;
 }
@@ -759,6 +761,7 @@ int DynamicPath::ShortCircuit(RampFeasibilityChecker& check)
     i += (int)intermediate.ramps.size()-2;
     shortcuts++;
   }
+  UpdateRampStartTimes();
   return shortcuts;
 }
 
@@ -773,12 +776,8 @@ int DynamicPath::OnlineShortcut(Real leadTime,Real padTime,RampFeasibilityChecke
 {
   Timer timer;
   int shortcuts = 0;
-  vector<Real> rampStartTime(ramps.size()); 
-  Real endTime=0;
-  for(std::size_t i=0;i<ramps.size();i++) {
-    rampStartTime[i] = endTime;
-    endTime += ramps[i].endTime;
-  }
+  UpdateRampStartTimes();
+  Real endTime=rampStartTimes.back();
   Vector x0,x1,dx0,dx1;
   DynamicPath intermediate;
   while(1) {
@@ -789,11 +788,11 @@ int DynamicPath::OnlineShortcut(Real leadTime,Real padTime,RampFeasibilityChecke
 
     Real t1=starttime+Sqr(rng->Rand())*(endTime-starttime),t2=starttime+rng->Rand()*(endTime-starttime);
     if(t1 > t2) Swap(t1,t2);
-    int i1 = std::upper_bound(rampStartTime.begin(),rampStartTime.end(),t1)-rampStartTime.begin()-1;
-    int i2 = std::upper_bound(rampStartTime.begin(),rampStartTime.end(),t2)-rampStartTime.begin()-1;
+    int i1 = std::upper_bound(rampStartTimes.begin(),rampStartTimes.end()-1,t1)-rampStartTimes.begin()-1;
+    int i2 = std::upper_bound(rampStartTimes.begin(),rampStartTimes.end()-1,t2)-rampStartTimes.begin()-1;
     if(i1 == i2) continue; //same ramp
-    Real u1 = t1-rampStartTime[i1];
-    Real u2 = t2-rampStartTime[i2];
+    Real u1 = t1-rampStartTimes[i1];
+    Real u2 = t2-rampStartTimes[i2];
     PARABOLIC_RAMP_ASSERT(u1 >= 0);
     PARABOLIC_RAMP_ASSERT(u1 <= ramps[i1].endTime+EpsilonT);
     PARABOLIC_RAMP_ASSERT(u2 >= 0);
@@ -839,12 +838,8 @@ int DynamicPath::OnlineShortcut(Real leadTime,Real padTime,RampFeasibilityChecke
     }
     
     //revise the timing
-    rampStartTime.resize(ramps.size());
-    endTime=0;
-    for(std::size_t i=0;i<ramps.size();i++) {
-      rampStartTime[i] = endTime;
-      endTime += ramps[i].endTime;
-    }
+    UpdateRampStartTimes();
+    endTime=rampStartTimes.back();
   }
   return shortcuts;
 }
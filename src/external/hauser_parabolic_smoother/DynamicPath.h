@@ -116,7 +116,7 @@ class DynamicPath
   DynamicPath();
   void Init(const Vector& velMax,const Vector& accMax);
   void SetJointLimits(const Vector& qMin,const Vector& qMax);
-  inline void Clear() { ramps.clear(); }
+  inline void Clear() { ramps.clear(); rampStartTimes.assign(1,0); }
   inline bool Empty() const { return ramps.empty(); }
   Real GetTotalTime() const;
   int GetSegment(Real t,Real& u,bool& outOfBounds) const;
@@ -139,11 +139,23 @@ class DynamicPath
   int OnlineShortcut(Real leadTime,Real padTime,RampFeasibilityChecker& check,RandomNumberGeneratorBase* rng);
 
   bool IsValid() const;
+  /// Recomputes rampStartTimes.  Must be called after modifying ramps
+  /// directly, before the path is queried by time.  If only ramps[first] and
+  /// the ramps after it were modified, only their start times are recomputed.
+  void UpdateRampStartTimes(std::size_t first=0);
 
   /// The joint limits (optional), velocity bounds, and acceleration bounds
   Vector xMin,xMax,velMax,accMax;
-  /// The path is stored as a series of ramps
+  /// The path is stored as a series of ramps.  Any code that adds, removes,
+  /// or retimes ramps directly must call UpdateRampStartTimes before calling
+  /// GetTotalTime, GetSegment, Evaluate, Derivative, or TryShortcut, which
+  /// assert that rampStartTimes matches ramps.
   std::vector<ParabolicRampND> ramps;
+  /// rampStartTimes[i] is the time at which ramps[i] starts and the last
+  /// element is the total time, so segments are found by binary search.
+  /// Always holds ramps.size()+1 elements; kept up to date by the member
+  /// functions that modify ramps.
+  std::vector<Real> rampStartTimes;
 };
 
 } //namespace ParabolicRamp
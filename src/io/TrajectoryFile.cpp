@@ -0,0 +1,364 @@
+#include "aikido/io/TrajectoryFile.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include "aikido/statespace/CartesianProduct.hpp"
+#include "aikido/statespace/GeodesicInterpolator.hpp"
+#include "aikido/statespace/SO2.hpp"
+
+namespace aikido {
+namespace io {
+namespace {
+
+using statespace::StateSpace;
+
+/// Identifies a trajectory file.
+constexpr char FILE_MAGIC[8] = {'A', 'I', 'K', 'I', 'D', 'O', 'T', 'J'};
+
+/// Written in the byte order of the writing machine to detect a mismatch.
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/// Kind of trajectory stored in a file.
+enum class TrajectoryType : std::uint32_t
+{
+  SPLINE = 1
+};
+
+/// Fixed-size header at the start of a trajectory file. It is followed by the
+/// state space signature, padded to a multiple of 8 bytes, and the arrays of
+/// the trajectory. For SPLINE, these are mNumKnots knot times, mNumKnots
+/// column offsets and mNumColumns x mDimension coefficients, as in
+/// trajectory::PackedSpline.
+struct FileHeader
+{
+  char mMagic[8];
+  std::uint32_t mVersion;
+  std::uint32_t mByteOrderMark;
+  std::uint32_t mType;
+  std::uint32_t mSignatureSize;
+  std::uint64_t mDimension;
+  std::uint64_t mNumKnots;
+  std::uint64_t mNumColumns;
+  std::uint64_t mReserved[2];
+};
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader must be 64 bytes.");
+
+//==============================================================================
+std::uint64_t padToAlignment(std::uint64_t size)
+{
+  return (size + 7) / 8 * 8;
+}
+
+//==============================================================================
+/// Returns a string with one character per dimension of a state space
+/// supported by trajectory::PackedSpline: 'R' for a real vector space and 'S'
+/// for SO2.
+std::string getSignature(const StateSpace* stateSpace)
+{
+  if (dynamic_cast<const statespace::SO2*>(stateSpace))
+    return "S";
+
+  if (auto product
+      = dynamic_cast<const statespace::CartesianProduct*>(stateSpace))
+  {
+    std::string signature;
+    for (std::size_t i = 0; i < product->getNumSubspaces(); ++i)
+      signature += getSignature(product->getSubspace<>(i).get());
+    return signature;
+  }
+
+  return std::string(stateSpace->getDimension(), 'R');
+}
+
+//==============================================================================
+std::string getCheckedSignature(const StateSpace* stateSpace)
+{
+  if (!stateSpace)
+    throw std::invalid_argument("StateSpace is null.");
+
+  if (!trajectory::PackedSpline::isSupported(stateSpace))
+  {
+    throw std::invalid_argument(
+        "Trajectory files only support Rn, SO2, and CartesianProducts "
+        "consisting of those types.");
+  }
+
+  return getSignature(stateSpace);
+}
+
+//==============================================================================
+/// Writes a trajectory file. The arrays are written in order and must hold
+/// the numbers of values implied by the header.
+void writeFile(
+    const std::string& path,
+    TrajectoryType type,
+    const std::string& signature,
+    std::uint64_t dimension,
+    std::uint64_t numKnots,
+    std::uint64_t numColumns,
+    const std::vector<std::pair<const void*, std::size_t>>& arrays)
+{
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file)
+    throw std::runtime_error("Failed to open '" + path + "' for writing.");
+
+  FileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.mMagic, FILE_MAGIC, sizeof(FILE_MAGIC));
+  header.mVersion = TRAJECTORY_FILE_VERSION;
+  header.mByteOrderMark = BYTE_ORDER_MARK;
+  header.mType = static_cast<std::uint32_t>(type);
+  header.mSignatureSize = static_cast<std::uint32_t>(signature.size());
+  header.mDimension = dimension;
+  header.mNumKnots = numKnots;
+  header.mNumColumns = numColumns;
+
+  const std::string padding(
+      padToAlignment(signature.size()) - signature.size(), '\0');
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(signature.data(), signature.size());
+  file.write(padding.data(), padding.size());
+  for (const auto& array : arrays)
+    file.write(static_cast<const char*>(array.first), array.second);
+
+  file.close();
+  if (!file)
+    throw std::runtime_error("Failed to write '" + path + "'.");
+}
+
+//==============================================================================
+/// Read-only memory mapping of a file.
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::string& path)
+  {
+    try
+    {
+      mFile = boost::interprocess::file_mapping(
+          path.c_str(), boost::interprocess::read_only);
+      mRegion = boost::interprocess::mapped_region(
+          mFile, boost::interprocess::read_only);
+    }
+    catch (const boost::interprocess::interprocess_exception& e)
+    {
+      throw std::runtime_error(
+          "Failed to map '" + path + "': " + std::string(e.what()));
+    }
+  }
+
+  const char* getData() const
+  {
+    return static_cast<const char*>(mRegion.get_address());
+  }
+
+  std::size_t getSize() const
+  {
+    return mRegion.get_size();
+  }
+
+private:
+  boost::interprocess::file_mapping mFile;
+  boost::interprocess::mapped_region mRegion;
+};
+
+//==============================================================================
+/// Returns count * size, or throws if it exceeds limit.
+std::uint64_t getArraySize(
+    std::uint64_t count, std::uint64_t size, std::uint64_t limit)
+{
+  if (size != 0 && count > limit / size)
+    throw std::runtime_error("Trajectory file is malformed.");
+  return count * size;
+}
+
+} // namespace
+
+//==============================================================================
+void writeTrajectory(
+    const std::string& path, const trajectory::PackedSpline& trajectory)
+{
+  const auto stateSpace = trajectory.getStateSpace();
+  const auto signature = getCheckedSignature(stateSpace.get());
+  const auto dimension = stateSpace->getDimension();
+  const auto numSegments = trajectory.getNumSegments();
+
+  std::vector<double> knotTimes(numSegments + 1);
+  std::vector<std::uint64_t> columnOffsets(numSegments + 1, 0);
+  std::vector<double> coefficients;
+
+  for (std::size_t i = 0; i <= numSegments; ++i)
+    knotTimes[i] = trajectory.getWaypointTime(i);
+
+  for (std::size_t i = 0; i < numSegments; ++i)
+  {
+    const auto segment = trajectory.getSegmentCoefficients(i);
+    coefficients.insert(
+        coefficients.end(), segment.data(), segment.data() + segment.size());
+    columnOffsets[i + 1] = columnOffsets[i] + segment.cols();
+  }
+
+  writeFile(
+      path,
+      TrajectoryType::SPLINE,
+      signature,
+      dimension,
+      knotTimes.size(),
+      columnOffsets.back(),
+      {{knotTimes.data(), knotTimes.size() * sizeof(double)},
+       {columnOffsets.data(), columnOffsets.size() * sizeof(std::uint64_t)},
+       {coefficients.data(), coefficients.size() * sizeof(double)}});
+}
+
+//==============================================================================
+void writeTrajectory(
+    const std::string& path, const trajectory::Spline& trajectory)
+{
+  writeTrajectory(path, trajectory::PackedSpline(trajectory));
+}
+
+//==============================================================================
+void writeTrajectory(
+    const std::string& path, const trajectory::Interpolated& trajectory)
+{
+  const auto stateSpace = trajectory.getStateSpace();
+  getCheckedSignature(stateSpace.get());
+
+  if (!std::dynamic_pointer_cast<const statespace::GeodesicInterpolator>(
+          trajectory.getInterpolator()))
+  {
+    throw std::invalid_argument(
+        "Trajectory files only support GeodesicInterpolator.");
+  }
+
+  const auto numWaypoints = trajectory.getNumWaypoints();
+  if (numWaypoints < 2)
+  {
+    throw std::invalid_argument(
+        "Trajectory files only support interpolated trajectories with at "
+        "least two waypoints.");
+  }
+
+  // Geodesic interpolation moves along the log map of the difference of two
+  // waypoints at a constant rate, which is a linear segment.
+  trajectory::PackedSpline spline(stateSpace, trajectory.getStartTime());
+  spline.reserve(numWaypoints - 1, 2);
+
+  auto inverseState = stateSpace->createState();
+  auto relativeState = stateSpace->createState();
+  Eigen::MatrixXd coefficients
+      = Eigen::MatrixXd::Zero(stateSpace->getDimension(), 2);
+  Eigen::VectorXd tangentVector;
+
+  for (std::size_t i = 0; i + 1 < numWaypoints; ++i)
+  {
+    const auto startState = trajectory.getWaypoint(i);
+    const double duration
+        = trajectory.getWaypointTime(i + 1) - trajectory.getWaypointTime(i);
+
+    stateSpace->getInverse(startState, inverseState);
+    stateSpace->compose(
+        inverseState, trajectory.getWaypoint(i + 1), relativeState);
+    stateSpace->logMap(relativeState, tangentVector);
+    coefficients.col(1) = tangentVector / duration;
+
+    spline.addSegment(coefficients, duration, startState);
+  }
+
+  writeTrajectory(path, spline);
+}
+
+//==============================================================================
+trajectory::PackedSplinePtr readTrajectory(
+    const std::string& path, statespace::ConstStateSpacePtr stateSpace)
+{
+  const auto signature = getCheckedSignature(stateSpace.get());
+  const auto file = std::make_shared<const MappedFile>(path);
+  const auto fileSize = file->getSize();
+
+  if (fileSize < sizeof(FileHeader))
+    throw std::runtime_error("Trajectory file is malformed.");
+
+  FileHeader header;
+  std::memcpy(&header, file->getData(), sizeof(header));
+
+  if (std::memcmp(header.mMagic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+    throw std::runtime_error("'" + path + "' is not a trajectory file.");
+
+  if (header.mByteOrderMark != BYTE_ORDER_MARK)
+    throw std::runtime_error("Trajectory file has a different byte order.");
+
+  if (header.mVersion != TRAJECTORY_FILE_VERSION)
+  {
+    throw std::runtime_error(
+        "Unsupported trajectory file version "
+        + std::to_string(header.mVersion) + ".");
+  }
+
+  if (fileSize - sizeof(FileHeader) < header.mSignatureSize)
+    throw std::runtime_error("Trajectory file is malformed.");
+
+  const char* signatureData = file->getData() + sizeof(FileHeader);
+  if (header.mDimension != stateSpace->getDimension()
+      || std::string(signatureData, header.mSignatureSize) != signature)
+  {
+    throw std::invalid_argument(
+        "State space does not match the trajectory file.");
+  }
+
+  // The arrays are 8-byte aligned because the mapping is page aligned.
+  const auto arraysOffset
+      = sizeof(FileHeader) + padToAlignment(header.mSignatureSize);
+  const char* arrays = file->getData() + arraysOffset;
+  const std::uint64_t limit = std::numeric_limits<std::uint64_t>::max() / 4;
+
+  const auto numKnots = header.mNumKnots;
+  const auto numValues
+      = getArraySize(header.mNumColumns, header.mDimension, limit);
+  const auto knotsSize = getArraySize(numKnots, sizeof(double), limit);
+  const auto valuesSize = getArraySize(numValues, sizeof(double), limit);
+
+  if (static_cast<TrajectoryType>(header.mType) != TrajectoryType::SPLINE)
+  {
+    throw std::runtime_error(
+        "Trajectory file has an unknown trajectory type.");
+  }
+
+  if (numKnots < 1 || arraysOffset + 2 * knotsSize + valuesSize != fileSize)
+    throw std::runtime_error("Trajectory file is malformed.");
+
+  const auto knotTimes = reinterpret_cast<const double*>(arrays);
+  const auto columnOffsets
+      = reinterpret_cast<const std::uint64_t*>(arrays + knotsSize);
+  const auto coefficients
+      = reinterpret_cast<const double*>(arrays + 2 * knotsSize);
+  const auto numSegments = static_cast<std::size_t>(numKnots - 1);
+
+  // PackedSpline checks that the offsets increase, so evaluation never reads
+  // outside of the file if they end at the number of columns.
+  if (columnOffsets[numSegments] != header.mNumColumns)
+    throw std::runtime_error("Trajectory file is malformed.");
+
+  try
+  {
+    return std::make_shared<trajectory::PackedSpline>(
+        std::move(stateSpace),
+        knotTimes,
+        columnOffsets,
+        coefficients,
+        numSegments,
+        file);
+  }
+  catch (const std::invalid_argument&)
+  {
+    throw std::runtime_error("Trajectory file is malformed.");
+  }
+}
+
+} // namespace io
+} // namespace aikido
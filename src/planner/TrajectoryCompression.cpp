@@ -0,0 +1,419 @@
+#include <aikido/planner/TrajectoryCompression.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <Eigen/Dense>
+#include <dart/common/StlHelpers.hpp>
+#include <aikido/common/VanDerCorput.hpp>
+#include <aikido/trajectory/PackedSpline.hpp>
+
+namespace aikido {
+namespace planner {
+
+using statespace::StateSpace;
+
+namespace {
+
+/// Number of times inside each original spline segment at which the deviation
+/// of a merged segment is checked.
+constexpr int NUM_DEVIATION_SAMPLES_PER_SEGMENT = 8;
+
+//==============================================================================
+void checkArguments(
+    const trajectory::Trajectory& trajectory,
+    const Eigen::VectorXd& tolerance,
+    const constraint::TestablePtr& constraint,
+    double checkResolution)
+{
+  const auto stateSpace = trajectory.getStateSpace();
+
+  if (tolerance.size()
+      != static_cast<Eigen::Index>(stateSpace->getDimension()))
+  {
+    throw std::invalid_argument(
+        "Tolerance does not match the dimension of the state space.");
+  }
+
+  if ((tolerance.array() < 0.).any())
+    throw std::invalid_argument("Tolerance must be non-negative.");
+
+  if (constraint && constraint->getStateSpace() != stateSpace)
+  {
+    throw std::invalid_argument(
+        "StateSpace of constraint not equal to StateSpace of trajectory.");
+  }
+
+  if (checkResolution <= 0.)
+    throw std::invalid_argument("Check resolution must be positive.");
+}
+
+/// Checks how far states of a compressed trajectory deviate from the states
+/// of the original trajectory, reusing its workspace between checks.
+class DeviationChecker
+{
+public:
+  DeviationChecker(
+      statespace::ConstStateSpacePtr stateSpace,
+      const Eigen::VectorXd& tolerance)
+    : mStateSpace(std::move(stateSpace))
+    , mTolerance(tolerance)
+    , mInverse(mStateSpace->createState())
+    , mRelative(mStateSpace->createState())
+  {
+  }
+
+  /// Returns whether \c original is within the tolerance of \c compressed.
+  bool isWithinTolerance(
+      const StateSpace::State* original, const StateSpace::State* compressed)
+  {
+    mStateSpace->getInverse(compressed, mInverse);
+    mStateSpace->compose(mInverse, original, mRelative);
+    mStateSpace->logMap(mRelative, mDeviation);
+    return (mDeviation.array().abs() <= mTolerance.array()).all();
+  }
+
+private:
+  statespace::ConstStateSpacePtr mStateSpace;
+  Eigen::VectorXd mTolerance;
+  StateSpace::ScopedState mInverse;
+  StateSpace::ScopedState mRelative;
+  Eigen::VectorXd mDeviation;
+};
+
+//==============================================================================
+/// Evaluates the state of a segment of a spline at time \c t relative to the
+/// start of the segment.
+void evaluateSegment(
+    const trajectory::Spline& spline,
+    std::size_t index,
+    double t,
+    Eigen::VectorXd& tangentVector,
+    StateSpace::State* relativeState,
+    StateSpace::State* state)
+{
+  const auto stateSpace = spline.getStateSpace();
+  trajectory::PackedSpline::evaluatePolynomial(
+      spline.getSegmentCoefficients(index), t, 0, tangentVector);
+  stateSpace->expMap(tangentVector, relativeState);
+  stateSpace->compose(spline.getSegmentStartState(index), relativeState, state);
+}
+
+//==============================================================================
+/// Returns the coefficients of the polynomial of degree (2 * (number of rows
+/// of \c start) - 1) over [0, duration] whose n-th derivative is the n-th
+/// column of \c start at zero and the n-th column of \c end at \c duration.
+Eigen::MatrixXd fitHermitePolynomial(
+    const Eigen::MatrixXd& start, const Eigen::MatrixXd& end, double duration)
+{
+  const Eigen::Index numConstraints = start.cols();
+  const Eigen::Index numCoeffs = 2 * numConstraints;
+
+  Eigen::MatrixXd lhs = Eigen::MatrixXd::Zero(numCoeffs, numCoeffs);
+  Eigen::MatrixXd rhs(numCoeffs, start.rows());
+
+  for (Eigen::Index derivative = 0; derivative < numConstraints; ++derivative)
+  {
+    double factorial = 1.;
+    for (Eigen::Index i = 2; i <= derivative; ++i)
+      factorial *= i;
+    lhs(derivative, derivative) = factorial;
+
+    // n-th derivative of t^i at t = duration.
+    const Eigen::Index row = numConstraints + derivative;
+    for (Eigen::Index power = derivative; power < numCoeffs; ++power)
+    {
+      double factor = 1.;
+      for (Eigen::Index i = power - derivative + 1; i <= power; ++i)
+        factor *= i;
+      const auto exponent = static_cast<double>(power - derivative);
+      lhs(row, power) = factor * std::pow(duration, exponent);
+    }
+
+    rhs.row(derivative) = start.col(derivative).transpose();
+    rhs.row(row) = end.col(derivative).transpose();
+  }
+
+  return lhs.colPivHouseholderQr().solve(rhs).transpose();
+}
+
+//==============================================================================
+/// Returns the largest index in [lowest, highest] for which \c isValid
+/// returns true, assuming it does for \c lowest and for every index below one
+/// for which it does. The step from \c lowest is doubled until a check fails,
+/// and the boundary is then bisected. A run that is checked in time linear in
+/// its length is therefore found in O(n log n) rather than O(n^2) time.
+template <typename IsValid>
+std::size_t findLastValid(
+    std::size_t lowest, std::size_t highest, IsValid&& isValid)
+{
+  std::size_t valid = lowest;
+  std::size_t invalid = highest + 1;
+
+  std::size_t step = 1;
+  while (valid < highest)
+  {
+    const std::size_t next = std::min(valid + step, highest);
+    if (!isValid(next))
+    {
+      invalid = next;
+      break;
+    }
+    valid = next;
+    step *= 2;
+  }
+
+  while (invalid - valid > 1)
+  {
+    const std::size_t middle = valid + (invalid - valid) / 2;
+    if (isValid(middle))
+      valid = middle;
+    else
+      invalid = middle;
+  }
+
+  return valid;
+}
+
+} // namespace
+
+//==============================================================================
+std::unique_ptr<trajectory::Interpolated> compressTrajectory(
+    const trajectory::Interpolated& trajectory,
+    const Eigen::VectorXd& tolerance,
+    const constraint::TestablePtr& constraint,
+    double checkResolution)
+{
+  checkArguments(trajectory, tolerance, constraint, checkResolution);
+
+  const auto stateSpace = trajectory.getStateSpace();
+  const auto interpolator = trajectory.getInterpolator();
+  const auto numWaypoints = trajectory.getNumWaypoints();
+
+  auto compressed = dart::common::make_unique<trajectory::Interpolated>(
+      stateSpace, interpolator);
+  if (numWaypoints == 0)
+    return compressed;
+
+  DeviationChecker deviationChecker(stateSpace, tolerance);
+  const common::VanDerCorput vdc{1, false, false, checkResolution};
+  auto original = stateSpace->createState();
+  auto candidate = stateSpace->createState();
+
+  // Returns whether the waypoints between first and last can be dropped.
+  const auto canDropWaypoints
+      = [&](std::size_t first, std::size_t last) -> bool {
+    const auto from = trajectory.getWaypoint(first);
+    const auto to = trajectory.getWaypoint(last);
+    const double startTime = trajectory.getWaypointTime(first);
+    const double duration = trajectory.getWaypointTime(last) - startTime;
+
+    for (std::size_t i = first + 1; i <= last; ++i)
+    {
+      const double waypointTime = trajectory.getWaypointTime(i);
+      const double middleTime
+          = 0.5 * (trajectory.getWaypointTime(i - 1) + waypointTime);
+
+      trajectory.evaluate(middleTime, original);
+      interpolator->interpolate(
+          from, to, (middleTime - startTime) / duration, candidate);
+      if (!deviationChecker.isWithinTolerance(original, candidate))
+        return false;
+
+      if (i == last)
+        break;
+
+      interpolator->interpolate(
+          from, to, (waypointTime - startTime) / duration, candidate);
+      if (!deviationChecker.isWithinTolerance(
+              trajectory.getWaypoint(i), candidate))
+        return false;
+    }
+
+    if (constraint)
+    {
+      for (const auto alpha : vdc)
+      {
+        interpolator->interpolate(from, to, alpha, candidate);
+        if (!constraint->isSatisfied(candidate))
+          return false;
+      }
+    }
+    return true;
+  };
+
+  std::size_t first = 0;
+  compressed->addWaypoint(
+      trajectory.getWaypointTime(first), trajectory.getWaypoint(first));
+
+  while (first + 1 < numWaypoints)
+  {
+    // Adjacent waypoints are always connected by the original segment.
+    const std::size_t last = findLastValid(
+        first + 1, numWaypoints - 1, [&](std::size_t candidateLast) {
+          return canDropWaypoints(first, candidateLast);
+        });
+
+    compressed->addWaypoint(
+        trajectory.getWaypointTime(last), trajectory.getWaypoint(last));
+    first = last;
+  }
+
+  return compressed;
+}
+
+//==============================================================================
+std::unique_ptr<trajectory::Spline> compressTrajectory(
+    const trajectory::Spline& trajectory,
+    const Eigen::VectorXd& tolerance,
+    const constraint::TestablePtr& constraint,
+    double checkResolution)
+{
+  checkArguments(trajectory, tolerance, constraint, checkResolution);
+
+  const auto stateSpace = trajectory.getStateSpace();
+  const auto dimension = static_cast<Eigen::Index>(stateSpace->getDimension());
+  const auto numSegments = trajectory.getNumSegments();
+
+  auto compressed = dart::common::make_unique<trajectory::Spline>(
+      stateSpace, trajectory.getStartTime());
+
+  DeviationChecker deviationChecker(stateSpace, tolerance);
+  const common::VanDerCorput vdc{1, false, false, checkResolution};
+  Eigen::VectorXd tangentVector;
+  auto relativeState = stateSpace->createState();
+  auto inverseState = stateSpace->createState();
+  auto original = stateSpace->createState();
+  auto candidate = stateSpace->createState();
+
+  // Returns the coefficients of a polynomial that replaces the segments from
+  // first to last, relative to the start state of the first segment.
+  const auto mergeSegments = [&](std::size_t first, std::size_t last) {
+    Eigen::Index maxNumCoeffs = 0;
+    double duration = 0.;
+    for (std::size_t i = first; i <= last; ++i)
+    {
+      maxNumCoeffs = std::max(
+          maxNumCoeffs, trajectory.getSegmentCoefficients(i).cols());
+      duration += trajectory.getSegmentDuration(i);
+    }
+
+    // Match as many derivatives at the ends as the segments are smooth.
+    const Eigen::Index numConstraints
+        = maxNumCoeffs <= 2 ? 1 : (maxNumCoeffs <= 4 ? 2 : 3);
+    Eigen::MatrixXd start(dimension, numConstraints);
+    Eigen::MatrixXd end(dimension, numConstraints);
+
+    const auto& firstCoeffs = trajectory.getSegmentCoefficients(first);
+    const auto& lastCoeffs = trajectory.getSegmentCoefficients(last);
+    const double lastDuration = trajectory.getSegmentDuration(last);
+    for (Eigen::Index derivative = 1; derivative < numConstraints; ++derivative)
+    {
+      trajectory::PackedSpline::evaluatePolynomial(
+          firstCoeffs, 0., derivative, tangentVector);
+      start.col(derivative) = tangentVector;
+      trajectory::PackedSpline::evaluatePolynomial(
+          lastCoeffs, lastDuration, derivative, tangentVector);
+      end.col(derivative) = tangentVector;
+    }
+
+    // Positions relative to the start state of the first segment.
+    stateSpace->getInverse(
+        trajectory.getSegmentStartState(first), inverseState);
+    evaluateSegment(
+        trajectory, first, 0., tangentVector, relativeState, original);
+    stateSpace->compose(inverseState, original, candidate);
+    stateSpace->logMap(candidate, tangentVector);
+    start.col(0) = tangentVector;
+    evaluateSegment(
+        trajectory, last, lastDuration, tangentVector, relativeState, original);
+    stateSpace->compose(inverseState, original, candidate);
+    stateSpace->logMap(candidate, tangentVector);
+    end.col(0) = tangentVector;
+
+    return fitHermitePolynomial(start, end, duration);
+  };
+
+  // Evaluates the state of a merged segment into candidate.
+  const auto evaluateMerged = [&](const Eigen::MatrixXd& coefficients,
+                                  const StateSpace::State* startState,
+                                  double t) {
+    trajectory::PackedSpline::evaluatePolynomial(
+        coefficients, t, 0, tangentVector);
+    stateSpace->expMap(tangentVector, relativeState);
+    stateSpace->compose(startState, relativeState, candidate);
+  };
+
+  // Returns whether the merged segment stays within the tolerance of, and
+  // satisfies the constraint as well as, the segments from first to last.
+  const auto isValidMerge = [&](const Eigen::MatrixXd& coefficients,
+                                std::size_t first,
+                                std::size_t last) -> bool {
+    const auto startState = trajectory.getSegmentStartState(first);
+
+    double segmentStartTime = 0.;
+    for (std::size_t i = first; i <= last; ++i)
+    {
+      const double segmentDuration = trajectory.getSegmentDuration(i);
+      for (int isample = 0; isample <= NUM_DEVIATION_SAMPLES_PER_SEGMENT;
+           ++isample)
+      {
+        const double t = segmentDuration * isample
+                         / NUM_DEVIATION_SAMPLES_PER_SEGMENT;
+        evaluateSegment(
+            trajectory, i, t, tangentVector, relativeState, original);
+        evaluateMerged(coefficients, startState, segmentStartTime + t);
+        if (!deviationChecker.isWithinTolerance(original, candidate))
+          return false;
+      }
+      segmentStartTime += segmentDuration;
+    }
+
+    if (constraint)
+    {
+      const double duration = segmentStartTime;
+      for (const auto alpha : vdc)
+      {
+        evaluateMerged(coefficients, startState, alpha * duration);
+        if (!constraint->isSatisfied(candidate))
+          return false;
+      }
+    }
+    return true;
+  };
+
+  std::size_t first = 0;
+  while (first < numSegments)
+  {
+    // A single segment is kept as it is. The coefficients of the longest
+    // valid merge found so far are kept, so they are not fitted again.
+    std::size_t mergedLast = first;
+    Eigen::MatrixXd coefficients = trajectory.getSegmentCoefficients(first);
+    const std::size_t last = findLastValid(
+        first, numSegments - 1, [&](std::size_t candidateLast) -> bool {
+          Eigen::MatrixXd merged = mergeSegments(first, candidateLast);
+          if (!isValidMerge(merged, first, candidateLast))
+            return false;
+
+          if (candidateLast > mergedLast)
+          {
+            mergedLast = candidateLast;
+            coefficients = std::move(merged);
+          }
+          return true;
+        });
+
+    double duration = 0.;
+    for (std::size_t i = first; i <= last; ++i)
+      duration += trajectory.getSegmentDuration(i);
+
+    compressed->addSegment(
+        coefficients, duration, trajectory.getSegmentStartState(first));
+    first = last + 1;
+  }
+
+  return compressed;
+}
+
+} // namespace planner
+} // namespace aikido
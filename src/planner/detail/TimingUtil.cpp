@@ -0,0 +1,101 @@
+#include "TimingUtil.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SO2.hpp>
+
+using aikido::statespace::CartesianProduct;
+using aikido::statespace::R;
+using aikido::statespace::SO2;
+
+namespace aikido {
+namespace planner {
+namespace detail {
+
+//==============================================================================
+bool checkStateSpace(const statespace::StateSpace* _stateSpace)
+{
+  // TODO(JS): Generalize Rn<N> for arbitrary N.
+  if (dynamic_cast<const R<0>*>(_stateSpace) != nullptr)
+  {
+    return true;
+  }
+  else if (dynamic_cast<const R<1>*>(_stateSpace) != nullptr)
+  {
+    return true;
+  }
+  else if (dynamic_cast<const R<2>*>(_stateSpace) != nullptr)
+  {
+    return true;
+  }
+  else if (dynamic_cast<const R<3>*>(_stateSpace) != nullptr)
+  {
+    return true;
+  }
+  else if (dynamic_cast<const R<4>*>(_stateSpace) != nullptr)
+  {
+    return true;
+  }
+  else if (dynamic_cast<const R<5>*>(_stateSpace) != nullptr)
+  {
+    return true;
+  }
+  else if (dynamic_cast<const R<6>*>(_stateSpace) != nullptr)
+  {
+    return true;
+  }
+  else if (dynamic_cast<const R<Eigen::Dynamic>*>(_stateSpace) != nullptr)
+  {
+    return true;
+  }
+  else if (dynamic_cast<const SO2*>(_stateSpace) != nullptr)
+  {
+    return true;
+  }
+  else if (auto space = dynamic_cast<const CartesianProduct*>(_stateSpace))
+  {
+    for (std::size_t isubspace = 0; isubspace < space->getNumSubspaces();
+         ++isubspace)
+    {
+      if (!checkStateSpace(space->getSubspace<>(isubspace).get()))
+        return false;
+    }
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+//==============================================================================
+void checkLimits(
+    std::size_t _dimension,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration)
+{
+  if (static_cast<std::size_t>(_maxVelocity.size()) != _dimension)
+    throw std::invalid_argument("Velocity limits have wrong dimension.");
+
+  if (static_cast<std::size_t>(_maxAcceleration.size()) != _dimension)
+    throw std::invalid_argument("Acceleration limits have wrong dimension.");
+
+  for (std::size_t i = 0; i < _dimension; ++i)
+  {
+    if (_maxVelocity[i] <= 0.)
+      throw std::invalid_argument("Velocity limits must be positive.");
+    if (!std::isfinite(_maxVelocity[i]))
+      throw std::invalid_argument("Velocity limits must be finite.");
+
+    if (_maxAcceleration[i] <= 0.)
+      throw std::invalid_argument("Acceleration limits must be positive.");
+    if (!std::isfinite(_maxAcceleration[i]))
+      throw std::invalid_argument("Acceleration limits must be finite.");
+  }
+}
+
+} // namespace detail
+} // namespace planner
+} // namespace aikido
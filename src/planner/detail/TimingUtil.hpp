@@ -0,0 +1,32 @@
+#ifndef AIKIDO_PLANNER_DETAIL_TIMINGUTIL_HPP_
+#define AIKIDO_PLANNER_DETAIL_TIMINGUTIL_HPP_
+
+#include <Eigen/Dense>
+#include <aikido/statespace/StateSpace.hpp>
+
+namespace aikido {
+namespace planner {
+namespace detail {
+
+/// Check whether the state space is supported by the timers, i.e. whether it
+/// is Rn, SO2, or a CartesianProduct consisting of those types
+/// \param _stateSpace the state space to be checked
+/// \return whether the state space is supported
+bool checkStateSpace(const statespace::StateSpace* _stateSpace);
+
+/// Check whether velocity and acceleration limits are valid
+/// \param _dimension dimension of the state space
+/// \param _maxVelocity maximum velocity in each dimension
+/// \param _maxAcceleration maximum acceleration in each dimension
+/// \throws std::invalid_argument if the limits do not match \c _dimension or
+/// are not positive and finite
+void checkLimits(
+    std::size_t _dimension,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration);
+
+} // namespace detail
+} // namespace planner
+} // namespace aikido
+
+#endif // AIKIDO_PLANNER_DETAIL_TIMINGUTIL_HPP_
@@ -4,6 +4,7 @@
 #include <aikido/planner/ompl/GeometricStateSpace.hpp>
 #include <aikido/planner/ompl/MotionValidator.hpp>
 #include <aikido/planner/ompl/Planner.hpp>
+#include <aikido/trajectory/InterpolatedBuilder.hpp>
 
 #include <dart/dart.hpp>
 
@@ -174,9 +175,6 @@ trajectory::InterpolatedPtr planOMPL(
 
   if (solved)
   {
-    auto returnTraj = std::make_shared<trajectory::Interpolated>(
-        std::move(_sspace), std::move(_interpolator));
-
     // Get the path
     auto path = ompl_dynamic_pointer_cast<::ompl::geometric::PathGeometric>(
         _pdef->getSolutionPath());
@@ -187,15 +185,17 @@ trajectory::InterpolatedPtr planOMPL(
           "Trajectory");
     }
 
+    trajectory::InterpolatedBuilder builder(
+        std::move(_sspace), std::move(_interpolator), path->getStateCount());
     for (std::size_t idx = 0; idx < path->getStateCount(); ++idx)
     {
       const auto* st
           = static_cast<GeometricStateSpace::StateType*>(path->getState(idx));
       // Arbitrary timing
-      returnTraj->addWaypoint(idx, st->mState);
+      builder.addWaypoint(idx, st->mState);
     }
 
-    return returnTraj;
+    return trajectory::InterpolatedPtr(builder.finalize());
   }
   return nullptr;
 }
@@ -476,8 +476,9 @@ std::unique_ptr<trajectory::Interpolated> toInterpolatedTrajectory(
     const ::ompl::geometric::PathGeometric& _path,
     statespace::InterpolatorPtr _interpolator)
 {
-  auto returnInterpolated = dart::common::make_unique<trajectory::Interpolated>(
-      _interpolator->getStateSpace(), std::move(_interpolator));
+  auto stateSpace = _interpolator->getStateSpace();
+  trajectory::InterpolatedBuilder builder(
+      std::move(stateSpace), std::move(_interpolator), _path.getStateCount());
 
   for (std::size_t idx = 0; idx < _path.getStateCount(); ++idx)
   {
@@ -488,9 +489,9 @@ std::unique_ptr<trajectory::Interpolated> toInterpolatedTrajectory(
         _path.getState(idx));
 
     // Arbitrary timing
-    returnInterpolated->addWaypoint(idx, st->mState);
+    builder.addWaypoint(idx, st->mState);
   }
-  return returnInterpolated;
+  return builder.finalize();
 }
 //==============================================================================
 
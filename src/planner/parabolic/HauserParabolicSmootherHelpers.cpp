@@ -1,6 +1,12 @@
 #include "HauserParabolicSmootherHelpers.hpp"
+#include <algorithm>
+#include <cassert>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include <aikido/common/VanDerCorput.hpp>
 #include "Config.h"
 #include "HauserMath.h"
@@ -18,44 +24,49 @@ class SmootherFeasibilityCheckerBase
 {
 public:
   SmootherFeasibilityCheckerBase(
-      aikido::constraint::TestablePtr testable, double checkResolution)
+      aikido::constraint::TestablePtr testable,
+      double checkResolution,
+      aikido::constraint::ClearancePtr clearance = nullptr)
     : mTestable(std::move(testable))
+    , mClearance(std::move(clearance))
     , mCheckResolution(checkResolution)
     , mStateSpace(mTestable->getStateSpace())
     , mInterpolator(mStateSpace)
+    , mTangent(mStateSpace->getDimension())
+    , mTestState(mStateSpace->createState())
+    , mStartState(mStateSpace->createState())
+    , mGoalState(mStateSpace->createState())
+    , mPointClearance(0.0)
   {
-    // Do nothing
+    // Both ends of a segment have already been checked by calling
+    // ConfigFeasible(), thus they are excluded from the sequence. The
+    // sequence only depends on the resolution, so it is computed once here
+    // instead of on every call to SegmentFeasible().
+    aikido::common::VanDerCorput vdc{1, false, false, mCheckResolution};
+    mSegmentAlphas.reserve(vdc.getLength());
+    for (const auto alpha : vdc)
+      mSegmentAlphas.push_back(alpha);
   }
 
   bool ConfigFeasible(const ParabolicRamp::Vector& x) override
   {
-    Eigen::VectorXd eigX = toEigen(x);
-    auto state = mStateSpace->createState();
-    mStateSpace->expMap(eigX, state);
-    return mTestable->isSatisfied(state);
+    toState(x, mTestState);
+    return mTestable->isSatisfied(mTestState);
   }
 
   bool SegmentFeasible(
       const ParabolicRamp::Vector& a, const ParabolicRamp::Vector& b) override
   {
-    Eigen::VectorXd eigA = toEigen(a);
-    Eigen::VectorXd eigB = toEigen(b);
-
-    auto testState = mStateSpace->createState();
-    auto startState = mStateSpace->createState();
-    auto goalState = mStateSpace->createState();
-    mStateSpace->expMap(eigA, startState);
-    mStateSpace->expMap(eigB, goalState);
+    toState(a, mStartState);
+    toState(b, mGoalState);
 
-    // both ends of the segment have already been checked by calling
-    // ConfigFeasible(),
-    // thus it is no longer needed to check in SegmentFeasible()
-    aikido::common::VanDerCorput vdc{1, false, false, mCheckResolution};
+    if (mClearance)
+      return isSegmentFeasibleWithClearance(a, b);
 
-    for (const auto alpha : vdc)
+    for (const auto alpha : mSegmentAlphas)
     {
-      mInterpolator.interpolate(startState, goalState, alpha, testState);
-      if (!mTestable->isSatisfied(testState))
+      mInterpolator.interpolate(mStartState, mGoalState, alpha, mTestState);
+      if (!mTestable->isSatisfied(mTestState))
       {
         return false;
       }
@@ -64,12 +75,257 @@ public:
   }
 
 private:
+  /// Part of the segment between mStartState and mGoalState, delimited by
+  /// interpolation parameters, with the clearance of both ends.
+  struct Section
+  {
+    double mStart;
+    double mEnd;
+    double mStartClearance;
+    double mEndClearance;
+  };
+
+  /// Checks the segment from \c a to \c b by bisection. A section is
+  /// skipped once the clearance of its ends covers it, so only the parts of
+  /// the segment near obstacles are refined down to mCheckResolution.
+  bool isSegmentFeasibleWithClearance(
+      const ParabolicRamp::Vector& a, const ParabolicRamp::Vector& b)
+  {
+    // Every state of a section is within its length in the infinity norm
+    // from both ends of the section.
+    double length = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i)
+      length = std::max(length, std::abs(b[i] - a[i]));
+
+    const double startClearance = getEndpointClearance(a, mStartState);
+    const double endClearance = getEndpointClearance(b, mGoalState);
+
+    mSections.clear();
+    mSections.push_back(Section{0.0, 1.0, startClearance, endClearance});
+    while (!mSections.empty())
+    {
+      const Section section = mSections.back();
+      mSections.pop_back();
+
+      const double width = section.mEnd - section.mStart;
+      if (section.mStartClearance + section.mEndClearance >= width * length)
+        continue;
+      if (width <= mCheckResolution)
+        continue;
+
+      const double middle = 0.5 * (section.mStart + section.mEnd);
+      mInterpolator.interpolate(mStartState, mGoalState, middle, mTestState);
+      if (!mTestable->isSatisfied(mTestState))
+        return false;
+
+      const double middleClearance = mClearance->getClearance(mTestState);
+      mSections.push_back(
+          Section{section.mStart, middle, section.mStartClearance,
+                  middleClearance});
+      mSections.push_back(
+          Section{middle, section.mEnd, middleClearance,
+                  section.mEndClearance});
+    }
+    return true;
+  }
+
+  /// Returns the clearance of \c state, the state at \c x. Consecutive
+  /// segments of a ramp share an end, so the last result is reused.
+  double getEndpointClearance(
+      const ParabolicRamp::Vector& x,
+      const aikido::statespace::StateSpace::State* state)
+  {
+    if (x != mClearancePoint)
+    {
+      mClearancePoint = x;
+      mPointClearance = mClearance->getClearance(state);
+    }
+    return mPointClearance;
+  }
+
+  /// Maps \c x onto the tangent buffer and writes the corresponding state
+  /// to \c out without allocating.
+  void toState(
+      const ParabolicRamp::Vector& x,
+      aikido::statespace::StateSpace::State* out)
+  {
+    // StateSpace::expMap() takes an Eigen::VectorXd, so the mapped vector is
+    // copied into a buffer whose size never changes.
+    mTangent = Eigen::Map<const Eigen::VectorXd>(x.data(), x.size());
+    mStateSpace->expMap(mTangent, out);
+  }
+
   aikido::constraint::TestablePtr mTestable;
+  aikido::constraint::ClearancePtr mClearance;
   double mCheckResolution;
   aikido::statespace::StateSpacePtr mStateSpace;
   aikido::statespace::GeodesicInterpolator mInterpolator;
+  std::vector<double> mSegmentAlphas;
+  Eigen::VectorXd mTangent;
+  aikido::statespace::StateSpace::ScopedState mTestState;
+  aikido::statespace::StateSpace::ScopedState mStartState;
+  aikido::statespace::StateSpace::ScopedState mGoalState;
+  std::vector<Section> mSections;
+  ParabolicRamp::Vector mClearancePoint;
+  double mPointClearance;
+};
+
+/// Feasibility checker that accepts everything. It is used to splice a
+/// shortcut that has already been checked into a DynamicPath.
+class AlwaysFeasibleChecker : public ParabolicRamp::FeasibilityCheckerBase
+{
+public:
+  bool ConfigFeasible(const ParabolicRamp::Vector& /*x*/) override
+  {
+    return true;
+  }
+
+  bool SegmentFeasible(
+      const ParabolicRamp::Vector& /*a*/,
+      const ParabolicRamp::Vector& /*b*/) override
+  {
+    return true;
+  }
 };
 
+/// Threads that run one task per thread in rounds. The threads are started
+/// once and wait for the next round in between, so running a round does not
+/// create any threads. The calling thread runs task 0 of each round itself.
+class RoundWorkers
+{
+public:
+  /// Starts numTasks - 1 threads; run() calls task(i) for i < numTasks.
+  RoundWorkers(std::size_t numTasks, std::function<void(std::size_t)> task)
+    : mTask(std::move(task))
+    , mRound(0)
+    , mNumRoundTasks(0)
+    , mNumFinished(0)
+    , mStop(false)
+  {
+    mThreads.reserve(numTasks > 0 ? numTasks - 1 : 0);
+    for (std::size_t i = 1; i < numTasks; ++i)
+      mThreads.emplace_back(&RoundWorkers::work, this, i);
+  }
+
+  ~RoundWorkers()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mRoundStarted.notify_all();
+    for (auto& thread : mThreads)
+      thread.join();
+  }
+
+  /// Runs tasks 0 to numTasks - 1 concurrently and waits for them to finish.
+  void run(std::size_t numTasks)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mNumRoundTasks = numTasks;
+      mNumFinished = 0;
+      ++mRound;
+    }
+    mRoundStarted.notify_all();
+
+    if (numTasks > 0)
+      mTask(0);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mRoundFinished.wait(
+        lock, [this]() { return mNumFinished == mThreads.size(); });
+  }
+
+private:
+  void work(std::size_t index)
+  {
+    std::size_t round = 0;
+    while (true)
+    {
+      std::size_t numTasks;
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mRoundStarted.wait(
+            lock, [this, round]() { return mStop || mRound != round; });
+        if (mStop)
+          return;
+        round = mRound;
+        numTasks = mNumRoundTasks;
+      }
+
+      if (index < numTasks)
+        mTask(index);
+
+      {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mNumFinished;
+      }
+      mRoundFinished.notify_one();
+    }
+  }
+
+  std::function<void(std::size_t)> mTask;
+  std::vector<std::thread> mThreads;
+  std::mutex mMutex;
+  std::condition_variable mRoundStarted;
+  std::condition_variable mRoundFinished;
+  std::size_t mRound;
+  std::size_t mNumRoundTasks;
+  std::size_t mNumFinished;
+  bool mStop;
+};
+
+/// A shortcut between times t1 and t2 of a DynamicPath, evaluated
+/// speculatively by the parallel shortcutting loop.
+struct ShortcutCandidate
+{
+  double t1;
+  double t2;
+  int i1;
+  int i2;
+  ParabolicRamp::ParabolicRampND ramp;
+  bool feasible;
+};
+
+/// Computes the time-optimal ramp that shortcuts \c dynamicPath between
+/// \c t1 and \c t2 exactly as DynamicPath::TryShortcut() does, without
+/// checking its feasibility or modifying the path.
+bool solveShortcut(
+    const ParabolicRamp::DynamicPath& dynamicPath,
+    double t1,
+    double t2,
+    ShortcutCandidate& candidate)
+{
+  if (t1 > t2)
+    std::swap(t1, t2);
+
+  double u1, u2;
+  bool outOfBounds1, outOfBounds2;
+  const int i1 = dynamicPath.GetSegment(t1, u1, outOfBounds1);
+  const int i2 = dynamicPath.GetSegment(t2, u2, outOfBounds2);
+  if (i1 == i2)
+    return false;
+
+  u1 = std::min(u1, dynamicPath.ramps[i1].endTime);
+  u2 = std::min(u2, dynamicPath.ramps[i2].endTime);
+
+  ParabolicRamp::ParabolicRampND& ramp = candidate.ramp;
+  dynamicPath.ramps[i1].Evaluate(u1, ramp.x0);
+  dynamicPath.ramps[i2].Evaluate(u2, ramp.x1);
+  dynamicPath.ramps[i1].Derivative(u1, ramp.dx0);
+  dynamicPath.ramps[i2].Derivative(u2, ramp.dx1);
+  if (!ramp.SolveMinTime(dynamicPath.accMax, dynamicPath.velMax))
+    return false;
+
+  candidate.t1 = t1;
+  candidate.t2 = t2;
+  candidate.i1 = i1;
+  candidate.i2 = i2;
+  candidate.feasible = false;
+  return true;
+}
+
 bool needsBlend(const ParabolicRamp::ParabolicRampND& rampNd)
 {
   for (std::size_t idof = 0; idof < rampNd.dx1.size(); ++idof)
@@ -128,7 +384,8 @@ bool doShortcut(
     double timelimit,
     double checkResolution,
     double tolerance,
-    aikido::common::RNG& rng)
+    aikido::common::RNG& rng,
+    aikido::constraint::ClearancePtr clearance)
 {
   if (timelimit < 0.0)
     throw std::invalid_argument("Timelimit should be non-negative");
@@ -137,7 +394,7 @@ bool doShortcut(
   if (tolerance < 0.0)
     throw std::invalid_argument("Tolerance should be non-negative");
 
-  SmootherFeasibilityCheckerBase base(testable, checkResolution);
+  SmootherFeasibilityCheckerBase base(testable, checkResolution, clearance);
   ParabolicRamp::RampFeasibilityChecker feasibilityChecker(&base, tolerance);
 
   std::chrono::time_point<std::chrono::system_clock> startTime
@@ -162,13 +419,250 @@ bool doShortcut(
   return success;
 }
 
+bool doShortcut(
+    ParabolicRamp::DynamicPath& dynamicPath,
+    const std::vector<aikido::constraint::TestablePtr>& testables,
+    double timelimit,
+    double checkResolution,
+    double tolerance,
+    aikido::common::RNG& rng,
+    const std::vector<aikido::constraint::ClearancePtr>& clearances)
+{
+  if (testables.empty())
+    throw std::invalid_argument("At least one testable is required");
+  for (const auto& testable : testables)
+  {
+    if (!testable)
+      throw std::invalid_argument("Testable is nullptr");
+  }
+  if (!clearances.empty() && clearances.size() != testables.size())
+    throw std::invalid_argument(
+        "There should be one clearance per testable or none");
+  for (const auto& clearance : clearances)
+  {
+    if (!clearance)
+      throw std::invalid_argument("Clearance is nullptr");
+  }
+  if (timelimit < 0.0)
+    throw std::invalid_argument("Timelimit should be non-negative");
+  if (checkResolution <= 0.0)
+    throw std::invalid_argument("Check resolution should be positive");
+  if (tolerance < 0.0)
+    throw std::invalid_argument("Tolerance should be non-negative");
+
+  // convertToDynamicPath() never sets joint limits, so shortcuts are always
+  // a single ramp solved by ParabolicRampND::SolveMinTime().
+  assert(dynamicPath.xMin.empty());
+
+  const std::size_t numWorkers = testables.size();
+
+  // Each worker queries only its own testable and clearance, so the workers
+  // never wait on each other while checking.
+  std::vector<std::unique_ptr<SmootherFeasibilityCheckerBase>> bases;
+  std::vector<ParabolicRamp::RampFeasibilityChecker> feasibilityCheckers;
+  bases.reserve(numWorkers);
+  feasibilityCheckers.reserve(numWorkers);
+  for (std::size_t i = 0; i < numWorkers; ++i)
+  {
+    bases.emplace_back(
+        new SmootherFeasibilityCheckerBase(
+            testables[i],
+            checkResolution,
+            clearances.empty() ? nullptr : clearances[i]));
+    feasibilityCheckers.emplace_back(bases.back().get(), tolerance);
+  }
+
+  // Candidates are re-solved when they are spliced into the path. This is
+  // deterministic, so the spliced ramp is the one that was checked.
+  AlwaysFeasibleChecker alwaysFeasible;
+  ParabolicRamp::RampFeasibilityChecker commitChecker(
+      &alwaysFeasible, tolerance);
+
+  std::vector<ShortcutCandidate> candidates;
+  std::vector<std::exception_ptr> errors(numWorkers);
+  candidates.reserve(numWorkers);
+
+  // Feasibility checking dominates the cost of a shortcut. Check the
+  // candidates concurrently, each with its own testable.
+  RoundWorkers workers(numWorkers, [&](std::size_t i) {
+    try
+    {
+      candidates[i].feasible = feasibilityCheckers[i].Check(candidates[i].ramp);
+    }
+    catch (...)
+    {
+      errors[i] = std::current_exception();
+    }
+  });
+
+  std::chrono::time_point<std::chrono::system_clock> startTime
+      = std::chrono::system_clock::now();
+  double elapsedTime = 0;
+
+  bool success = false;
+  while (elapsedTime < timelimit && dynamicPath.ramps.size() > 3)
+  {
+    // Sampling and ramp solving are cheap; do them serially so the result
+    // only depends on the seed of rng.
+    candidates.clear();
+    std::uniform_real_distribution<> dist(0.0, dynamicPath.GetTotalTime());
+    for (std::size_t i = 0; i < numWorkers; ++i)
+    {
+      const double t1 = dist(rng);
+      const double t2 = dist(rng);
+
+      candidates.emplace_back();
+      if (!solveShortcut(dynamicPath, t1, t2, candidates.back()))
+        candidates.pop_back();
+    }
+
+    workers.run(candidates.size());
+
+    for (const auto& error : errors)
+    {
+      if (error)
+        std::rethrow_exception(error);
+    }
+
+    // Commit the feasible candidates that save the most time, skipping any
+    // candidate that touches a ramp modified by an already accepted one.
+    std::vector<const ShortcutCandidate*> accepted;
+    std::vector<const ShortcutCandidate*> feasible;
+    for (const auto& candidate : candidates)
+    {
+      if (candidate.feasible
+          && candidate.ramp.endTime < candidate.t2 - candidate.t1)
+        feasible.push_back(&candidate);
+    }
+    std::sort(
+        feasible.begin(),
+        feasible.end(),
+        [](const ShortcutCandidate* a, const ShortcutCandidate* b) {
+          return (a->t2 - a->t1) - a->ramp.endTime
+                 > (b->t2 - b->t1) - b->ramp.endTime;
+        });
+    for (const auto candidate : feasible)
+    {
+      const bool overlaps = std::any_of(
+          accepted.begin(),
+          accepted.end(),
+          [candidate](const ShortcutCandidate* other) {
+            return candidate->i1 <= other->i2 && other->i1 <= candidate->i2;
+          });
+      if (!overlaps)
+        accepted.push_back(candidate);
+    }
+
+    // Splice from the back of the path to the front so that the times and
+    // ramp indices of the remaining candidates stay valid.
+    std::sort(
+        accepted.begin(),
+        accepted.end(),
+        [](const ShortcutCandidate* a, const ShortcutCandidate* b) {
+          return a->t1 > b->t1;
+        });
+    for (const auto candidate : accepted)
+    {
+      if (dynamicPath.TryShortcut(candidate->t1, candidate->t2, commitChecker))
+        success = true;
+    }
+
+    elapsedTime = std::chrono::duration_cast<std::chrono::duration<double>>(
+                      std::chrono::system_clock::now() - startTime)
+                      .count();
+  }
+  return success;
+}
+
+std::size_t doOnlineShortcut(
+    ParabolicRamp::DynamicPath& dynamicPath,
+    aikido::constraint::TestablePtr testable,
+    double timelimit,
+    double checkResolution,
+    double tolerance,
+    aikido::common::RNG& rng,
+    const std::function<double()>& getSafeTime,
+    const std::function<
+        bool(double, std::size_t, const ParabolicRamp::DynamicPath&)>& commit,
+    const std::atomic<bool>& stop,
+    aikido::constraint::ClearancePtr clearance)
+{
+  if (timelimit < 0.0)
+    throw std::invalid_argument("Timelimit should be non-negative");
+  if (checkResolution <= 0.0)
+    throw std::invalid_argument("Check resolution should be positive");
+  if (tolerance < 0.0)
+    throw std::invalid_argument("Tolerance should be non-negative");
+
+  SmootherFeasibilityCheckerBase base(testable, checkResolution, clearance);
+  ParabolicRamp::RampFeasibilityChecker feasibilityChecker(&base, tolerance);
+
+  AlwaysFeasibleChecker alwaysFeasible;
+  ParabolicRamp::RampFeasibilityChecker commitChecker(
+      &alwaysFeasible, tolerance);
+
+  std::chrono::time_point<std::chrono::system_clock> startTime
+      = std::chrono::system_clock::now();
+  double elapsedTime = 0;
+
+  ShortcutCandidate candidate;
+  std::size_t numShortcuts = 0;
+  while (elapsedTime < timelimit && !stop)
+  {
+    const double safeTime = std::max(getSafeTime(), 0.0);
+    const double totalTime = dynamicPath.GetTotalTime();
+    if (safeTime >= totalTime)
+      break;
+
+    // The ramps are only copied once a shortcut is known to be feasible, so
+    // the copy is not paid for the rejected samples. Only the ramps from the
+    // one the shortcut leaves on are copied, since the ones before it do not
+    // change.
+    std::uniform_real_distribution<> dist(safeTime, totalTime);
+    const double t1 = dist(rng);
+    const double t2 = dist(rng);
+    if (solveShortcut(dynamicPath, t1, t2, candidate)
+        && candidate.ramp.endTime < candidate.t2 - candidate.t1
+        && feasibilityChecker.Check(candidate.ramp))
+    {
+      const auto firstRamp = static_cast<std::size_t>(candidate.i1);
+      const double offset = dynamicPath.rampStartTimes[firstRamp];
+
+      ParabolicRamp::DynamicPath suffix;
+      suffix.Init(dynamicPath.velMax, dynamicPath.accMax);
+      suffix.SetJointLimits(dynamicPath.xMin, dynamicPath.xMax);
+      suffix.ramps.assign(
+          dynamicPath.ramps.begin() + firstRamp, dynamicPath.ramps.end());
+      suffix.UpdateRampStartTimes();
+
+      if (suffix.TryShortcut(
+              candidate.t1 - offset, candidate.t2 - offset, commitChecker)
+          && commit(candidate.t1, firstRamp, suffix))
+      {
+        dynamicPath.ramps.erase(
+            dynamicPath.ramps.begin() + firstRamp, dynamicPath.ramps.end());
+        dynamicPath.ramps.insert(
+            dynamicPath.ramps.end(), suffix.ramps.begin(), suffix.ramps.end());
+        dynamicPath.UpdateRampStartTimes(firstRamp);
+        ++numShortcuts;
+      }
+    }
+
+    elapsedTime = std::chrono::duration_cast<std::chrono::duration<double>>(
+                      std::chrono::system_clock::now() - startTime)
+                      .count();
+  }
+  return numShortcuts;
+}
+
 bool doBlend(
     ParabolicRamp::DynamicPath& dynamicPath,
     aikido::constraint::TestablePtr testable,
     double blendRadius,
     int blendIterations,
     double checkResolution,
-    double tolerance)
+    double tolerance,
+    aikido::constraint::ClearancePtr clearance)
 {
   if (blendIterations <= 0)
     throw std::invalid_argument("Blend iterations should be positive");
@@ -179,7 +673,7 @@ bool doBlend(
   if (tolerance < 0.0)
     throw std::invalid_argument("Tolerance should be non-negative");
 
-  SmootherFeasibilityCheckerBase base(testable, checkResolution);
+  SmootherFeasibilityCheckerBase base(testable, checkResolution, clearance);
   ParabolicRamp::RampFeasibilityChecker feasibilityChecker(&base, tolerance);
 
   // Mark all of the ramps in the initial trajectory as "original". We'll
@@ -1,9 +1,13 @@
 #ifndef AIKIDO_PLANNER_PARABOLIC_SMOOTHER_HELPER_HPP_
 #define AIKIDO_PLANNER_PARABOLIC_SMOOTHER_HELPER_HPP_
 
+#include <atomic>
+#include <functional>
+#include <vector>
 #include <Eigen/Dense>
 #include "aikido/trajectory/Interpolated.hpp"
 #include "aikido/trajectory/Spline.hpp"
+#include "aikido/constraint/Clearance.hpp"
 #include "aikido/constraint/Testable.hpp"
 #include "DynamicPath.h"
 
@@ -12,16 +16,60 @@ namespace planner {
 namespace parabolic {
 namespace detail {
 
+  /// If \c clearance is not nullptr, segments are only checked at
+  /// \c checkResolution where the clearance of their ends does not prove
+  /// them feasible.
   bool doShortcut(ParabolicRamp::DynamicPath& dynamicPath,
                   aikido::constraint::TestablePtr testable,
                   double timelimit,
                   double checkResolution, double tolerance,
-                  aikido::common::RNG& rng);
+                  aikido::common::RNG& rng,
+                  aikido::constraint::ClearancePtr clearance = nullptr);
+
+  /// Parallel variant of doShortcut(). Each round samples one candidate
+  /// shortcut per element of \c testables, checks the candidates
+  /// concurrently (candidate i is checked against testables[i] on its own
+  /// thread) and commits the feasible ones that save the most time without
+  /// touching the same ramps. Each testable must be safe to use concurrently
+  /// with the others, e.g. by being defined on its own skeleton clone. The
+  /// worker threads are started once and reused by every round.
+  /// \c clearances is either empty or holds one clearance per testable, which
+  /// worker i queries together with testables[i].
+  bool doShortcut(ParabolicRamp::DynamicPath& dynamicPath,
+                  const std::vector<aikido::constraint::TestablePtr>& testables,
+                  double timelimit,
+                  double checkResolution, double tolerance,
+                  aikido::common::RNG& rng,
+                  const std::vector<aikido::constraint::ClearancePtr>&
+                      clearances);
+
+  /// Online variant of doShortcut() for a path that is being executed.
+  /// Shortcuts are only sampled after \c getSafeTime(), the time along the
+  /// path before which it may already have been executed. A feasible
+  /// shortcut is spliced into a copy of the ramps of \c dynamicPath from the
+  /// one it leaves on. \c commit is passed the time at which the shortcut
+  /// leaves the original path, the index of that ramp and the copy, which
+  /// replaces the ramps from that index on; \c dynamicPath is only modified
+  /// if \c commit returns true. Stops when \c timelimit is exceeded,
+  /// \c stop is set, or \c getSafeTime() reaches the end of the path.
+  /// \c clearance is used as in doShortcut().
+  /// \return number of committed shortcuts
+  std::size_t doOnlineShortcut(ParabolicRamp::DynamicPath& dynamicPath,
+      aikido::constraint::TestablePtr testable,
+      double timelimit,
+      double checkResolution, double tolerance,
+      aikido::common::RNG& rng,
+      const std::function<double()>& getSafeTime,
+      const std::function<bool(
+          double, std::size_t, const ParabolicRamp::DynamicPath&)>& commit,
+      const std::atomic<bool>& stop,
+      aikido::constraint::ClearancePtr clearance = nullptr);
 
   bool doBlend(ParabolicRamp::DynamicPath& dynamicPath,
                aikido::constraint::TestablePtr testable,
                double blendRadius, int blendIterations,
-               double checkResolution, double tolerance);
+               double checkResolution, double tolerance,
+               aikido::constraint::ClearancePtr clearance = nullptr);
 
 } // namespace detail
 } // namespace parabolic
@@ -0,0 +1,252 @@
+#include "aikido/planner/parabolic/OnlineShortcutTrajectory.hpp"
+
+#include <stdexcept>
+#include "DynamicPath.h"
+#include "HauserParabolicSmootherHelpers.hpp"
+#include "ParabolicUtil.hpp"
+
+namespace aikido {
+namespace planner {
+namespace parabolic {
+namespace {
+
+/// Appends the segments of \c _from in [_first, _last) to \c _to.
+void appendSegments(
+    const trajectory::Spline& _from,
+    std::size_t _first,
+    std::size_t _last,
+    trajectory::Spline& _to)
+{
+  for (std::size_t i = _first; i < _last; ++i)
+  {
+    _to.addSegment(
+        _from.getSegmentCoefficients(i),
+        _from.getSegmentDuration(i),
+        _from.getSegmentStartState(i));
+  }
+}
+
+} // namespace
+
+OnlineShortcutTrajectory::OnlineShortcutTrajectory(
+    const trajectory::Spline& _inputTrajectory,
+    aikido::constraint::TestablePtr _feasibilityCheck,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    const aikido::common::RNG& _rng,
+    double _leadTime,
+    double _timelimit,
+    double _checkResolution,
+    double _tolerance,
+    aikido::constraint::ClearancePtr _clearance)
+  : mStateSpace(_inputTrajectory.getStateSpace())
+  , mStartTime(_inputTrajectory.getStartTime())
+  , mFeasibilityCheck(std::move(_feasibilityCheck))
+  , mRng(_rng.clone())
+  , mLeadTime(_leadTime)
+  , mTimelimit(_timelimit)
+  , mCheckResolution(_checkResolution)
+  , mTolerance(_tolerance)
+  , mClearance(std::move(_clearance))
+  , mNumShortcuts(0)
+  , mStopRequested(false)
+  , mStarted(false)
+{
+  if (!mFeasibilityCheck)
+    throw std::invalid_argument("Testable is nullptr");
+  if (mLeadTime < 0.0)
+    throw std::invalid_argument("Lead time should be non-negative");
+  if (mTimelimit < 0.0)
+    throw std::invalid_argument("Timelimit should be non-negative");
+  if (mCheckResolution <= 0.0)
+    throw std::invalid_argument("Check resolution should be positive");
+  if (mTolerance < 0.0)
+    throw std::invalid_argument("Tolerance should be non-negative");
+
+  mDynamicPath = detail::convertToDynamicPath(
+      _inputTrajectory, _maxVelocity, _maxAcceleration);
+
+  // Executing the input trajectory and the converted path must be
+  // indistinguishable, since shortcuts are spliced into the latter.
+  mSpline = std::make_shared<trajectory::Spline>(mStateSpace, mStartTime);
+  mRampSegments = detail::appendToSpline(*mDynamicPath, *mSpline);
+}
+
+OnlineShortcutTrajectory::~OnlineShortcutTrajectory()
+{
+  mStopRequested = true;
+  if (mThread.joinable())
+    mThread.join();
+}
+
+void OnlineShortcutTrajectory::start()
+{
+  if (mStarted)
+    throw std::logic_error("Online shortcutting has already been started.");
+
+  mStarted = true;
+  mExecutionStartTime = std::chrono::steady_clock::now();
+  mThread = std::thread(&OnlineShortcutTrajectory::run, this);
+}
+
+void OnlineShortcutTrajectory::stop()
+{
+  mStopRequested = true;
+  join();
+}
+
+void OnlineShortcutTrajectory::wait()
+{
+  join();
+}
+
+std::shared_ptr<const trajectory::Spline>
+OnlineShortcutTrajectory::getSpline() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mSpline;
+}
+
+std::size_t OnlineShortcutTrajectory::getNumShortcuts() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mNumShortcuts;
+}
+
+statespace::ConstStateSpacePtr OnlineShortcutTrajectory::getStateSpace() const
+{
+  return mStateSpace;
+}
+
+std::size_t OnlineShortcutTrajectory::getNumDerivatives() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mSpline->getNumDerivatives();
+}
+
+double OnlineShortcutTrajectory::getStartTime() const
+{
+  return mStartTime;
+}
+
+double OnlineShortcutTrajectory::getEndTime() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mSpline->getEndTime();
+}
+
+double OnlineShortcutTrajectory::getDuration() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mSpline->getDuration();
+}
+
+void OnlineShortcutTrajectory::evaluate(
+    double _t, statespace::StateSpace::State* _state) const
+{
+  // Shortcuts modify the spline in place, so it is evaluated under the lock
+  // instead of through a snapshot from getSpline().
+  std::lock_guard<std::mutex> lock(mMutex);
+  mSpline->evaluate(_t, _state);
+}
+
+void OnlineShortcutTrajectory::evaluateDerivative(
+    double _t, int _derivative, Eigen::VectorXd& _tangentVector) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mSpline->evaluateDerivative(_t, _derivative, _tangentVector);
+}
+
+void OnlineShortcutTrajectory::run()
+{
+  try
+  {
+    detail::doOnlineShortcut(
+        *mDynamicPath,
+        mFeasibilityCheck,
+        mTimelimit,
+        mCheckResolution,
+        mTolerance,
+        *mRng,
+        [this]() { return getSafeTime(); },
+        [this](
+            double leaveTime,
+            std::size_t firstRamp,
+            const ParabolicRamp::DynamicPath& suffix) {
+          return commit(leaveTime, firstRamp, suffix);
+        },
+        mStopRequested,
+        mClearance);
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mError = std::current_exception();
+  }
+}
+
+bool OnlineShortcutTrajectory::commit(
+    double _leaveTime,
+    std::size_t _firstRamp,
+    const ParabolicRamp::DynamicPath& _suffix)
+{
+  // Convert the new ramps before locking so evaluation is never blocked for
+  // longer than it takes to splice their segments in. The segments of the
+  // ramps before _firstRamp do not change.
+  trajectory::Spline suffix(mStateSpace, mStartTime);
+  const auto suffixSegments = detail::appendToSpline(_suffix, suffix);
+  const std::size_t firstSegment = mRampSegments[_firstRamp];
+
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  // Checking the shortcut took time, so execution may have caught up to it.
+  if (_leaveTime < getSafeTime())
+    return false;
+
+  // Splines returned by getSpline() must not change, so copy the unchanged
+  // segments if one is still referenced.
+  if (mSpline.use_count() > 1)
+  {
+    auto spline = std::make_shared<trajectory::Spline>(mStateSpace, mStartTime);
+    appendSegments(*mSpline, 0, firstSegment, *spline);
+    mSpline = std::move(spline);
+  }
+  else
+  {
+    mSpline->removeSegments(firstSegment);
+  }
+  appendSegments(suffix, 0, suffix.getNumSegments(), *mSpline);
+  ++mNumShortcuts;
+
+  mRampSegments.resize(_firstRamp);
+  for (const auto index : suffixSegments)
+    mRampSegments.push_back(firstSegment + index);
+  return true;
+}
+
+double OnlineShortcutTrajectory::getSafeTime() const
+{
+  const double executionTime
+      = std::chrono::duration_cast<std::chrono::duration<double>>(
+            std::chrono::steady_clock::now() - mExecutionStartTime)
+            .count();
+  return executionTime + mLeadTime;
+}
+
+void OnlineShortcutTrajectory::join()
+{
+  if (mThread.joinable())
+    mThread.join();
+
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::swap(error, mError);
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+} // namespace parabolic
+} // namespace planner
+} // namespace aikido
@@ -1,6 +1,7 @@
 #include "aikido/planner/parabolic/ParabolicSmoother.hpp"
 
 #include <cassert>
+#include <functional>
 #include <set>
 #include <dart/common/StlHelpers.hpp>
 #include "aikido/common/Spline.hpp"
@@ -13,15 +14,16 @@ namespace aikido {
 namespace planner {
 namespace parabolic {
 
-std::unique_ptr<aikido::trajectory::Spline> doShortcut(
-    const aikido::trajectory::Spline& _inputTrajectory,
-    aikido::constraint::TestablePtr _feasibilityCheck,
+namespace {
+
+//==============================================================================
+/// Converts \c _inputTrajectory to a DynamicPath, applies \c _smooth to it and
+/// converts the result back to a spline.
+std::unique_ptr<trajectory::Spline> smoothDynamicPath(
+    const trajectory::Spline& _inputTrajectory,
     const Eigen::VectorXd& _maxVelocity,
     const Eigen::VectorXd& _maxAcceleration,
-    aikido::common::RNG& _rng,
-    double _timelimit,
-    double _checkResolution,
-    double _tolerance)
+    const std::function<void(ParabolicRamp::DynamicPath&)>& _smooth)
 {
   auto stateSpace = _inputTrajectory.getStateSpace();
 
@@ -29,20 +31,70 @@ std::unique_ptr<aikido::trajectory::Spline> doShortcut(
   auto dynamicPath = detail::convertToDynamicPath(
       _inputTrajectory, _maxVelocity, _maxAcceleration);
 
-  detail::doShortcut(
-      *dynamicPath,
-      _feasibilityCheck,
-      _timelimit,
-      _checkResolution,
-      _tolerance,
-      _rng);
+  _smooth(*dynamicPath);
+
+  return detail::convertToSpline(*dynamicPath, startTime, stateSpace);
+}
 
-  auto outputTrajectory
-      = detail::convertToSpline(*dynamicPath, startTime, stateSpace);
+} // namespace
 
-  return outputTrajectory;
+//==============================================================================
+std::unique_ptr<aikido::trajectory::Spline> doShortcut(
+    const aikido::trajectory::Spline& _inputTrajectory,
+    aikido::constraint::TestablePtr _feasibilityCheck,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    aikido::common::RNG& _rng,
+    double _timelimit,
+    double _checkResolution,
+    double _tolerance,
+    aikido::constraint::ClearancePtr _clearance)
+{
+  return smoothDynamicPath(
+      _inputTrajectory,
+      _maxVelocity,
+      _maxAcceleration,
+      [&](ParabolicRamp::DynamicPath& _dynamicPath) {
+        detail::doShortcut(
+            _dynamicPath,
+            _feasibilityCheck,
+            _timelimit,
+            _checkResolution,
+            _tolerance,
+            _rng,
+            _clearance);
+      });
 }
 
+//==============================================================================
+std::unique_ptr<trajectory::Spline> doShortcut(
+    const trajectory::Spline& _inputTrajectory,
+    const std::vector<aikido::constraint::TestablePtr>& _feasibilityChecks,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    aikido::common::RNG& _rng,
+    double _timelimit,
+    double _checkResolution,
+    double _tolerance,
+    const std::vector<aikido::constraint::ClearancePtr>& _clearances)
+{
+  return smoothDynamicPath(
+      _inputTrajectory,
+      _maxVelocity,
+      _maxAcceleration,
+      [&](ParabolicRamp::DynamicPath& _dynamicPath) {
+        detail::doShortcut(
+            _dynamicPath,
+            _feasibilityChecks,
+            _timelimit,
+            _checkResolution,
+            _tolerance,
+            _rng,
+            _clearances);
+      });
+}
+
+//==============================================================================
 std::unique_ptr<trajectory::Spline> doBlend(
     const trajectory::Spline& _inputTrajectory,
     aikido::constraint::TestablePtr _feasibilityCheck,
@@ -51,28 +103,26 @@ std::unique_ptr<trajectory::Spline> doBlend(
     double _blendRadius,
     int _blendIterations,
     double _checkResolution,
-    double _tolerance)
+    double _tolerance,
+    aikido::constraint::ClearancePtr _clearance)
 {
-  auto stateSpace = _inputTrajectory.getStateSpace();
-
-  double startTime = _inputTrajectory.getStartTime();
-  auto dynamicPath = detail::convertToDynamicPath(
-      _inputTrajectory, _maxVelocity, _maxAcceleration);
-
-  detail::doBlend(
-      *dynamicPath,
-      _feasibilityCheck,
-      _blendRadius,
-      _blendIterations,
-      _checkResolution,
-      _tolerance);
-
-  auto outputTrajectory
-      = detail::convertToSpline(*dynamicPath, startTime, stateSpace);
-
-  return outputTrajectory;
+  return smoothDynamicPath(
+      _inputTrajectory,
+      _maxVelocity,
+      _maxAcceleration,
+      [&](ParabolicRamp::DynamicPath& _dynamicPath) {
+        detail::doBlend(
+            _dynamicPath,
+            _feasibilityCheck,
+            _blendRadius,
+            _blendIterations,
+            _checkResolution,
+            _tolerance,
+            _clearance);
+      });
 }
 
+//==============================================================================
 std::unique_ptr<trajectory::Spline> doShortcutAndBlend(
     const trajectory::Spline& _inputTrajectory,
     aikido::constraint::TestablePtr _feasibilityCheck,
@@ -83,34 +133,77 @@ std::unique_ptr<trajectory::Spline> doShortcutAndBlend(
     double _blendRadius,
     int _blendIterations,
     double _checkResolution,
-    double _tolerance)
+    double _tolerance,
+    aikido::constraint::ClearancePtr _clearance)
 {
-  auto stateSpace = _inputTrajectory.getStateSpace();
-
-  double startTime = _inputTrajectory.getStartTime();
-  auto dynamicPath = detail::convertToDynamicPath(
-      _inputTrajectory, _maxVelocity, _maxAcceleration);
-
-  detail::doShortcut(
-      *dynamicPath,
+  return doShortcutAndBlend(
+      _inputTrajectory,
+      std::vector<aikido::constraint::TestablePtr>{},
       _feasibilityCheck,
+      _maxVelocity,
+      _maxAcceleration,
+      _rng,
       _timelimit,
-      _checkResolution,
-      _tolerance,
-      _rng);
-
-  detail::doBlend(
-      *dynamicPath,
-      _feasibilityCheck,
       _blendRadius,
       _blendIterations,
       _checkResolution,
-      _tolerance);
+      _tolerance,
+      _clearance);
+}
 
-  auto outputTrajectory
-      = detail::convertToSpline(*dynamicPath, startTime, stateSpace);
+//==============================================================================
+std::unique_ptr<trajectory::Spline> doShortcutAndBlend(
+    const trajectory::Spline& _inputTrajectory,
+    const std::vector<aikido::constraint::TestablePtr>& _shortcutChecks,
+    aikido::constraint::TestablePtr _feasibilityCheck,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    aikido::common::RNG& _rng,
+    double _timelimit,
+    double _blendRadius,
+    int _blendIterations,
+    double _checkResolution,
+    double _tolerance,
+    aikido::constraint::ClearancePtr _clearance,
+    const std::vector<aikido::constraint::ClearancePtr>& _shortcutClearances)
+{
+  return smoothDynamicPath(
+      _inputTrajectory,
+      _maxVelocity,
+      _maxAcceleration,
+      [&](ParabolicRamp::DynamicPath& _dynamicPath) {
+        if (_shortcutChecks.empty())
+        {
+          detail::doShortcut(
+              _dynamicPath,
+              _feasibilityCheck,
+              _timelimit,
+              _checkResolution,
+              _tolerance,
+              _rng,
+              _clearance);
+        }
+        else
+        {
+          detail::doShortcut(
+              _dynamicPath,
+              _shortcutChecks,
+              _timelimit,
+              _checkResolution,
+              _tolerance,
+              _rng,
+              _shortcutClearances);
+        }
 
-  return outputTrajectory;
+        detail::doBlend(
+            _dynamicPath,
+            _feasibilityCheck,
+            _blendRadius,
+            _blendIterations,
+            _checkResolution,
+            _tolerance,
+            _clearance);
+      });
 }
 
 //==============================================================================
@@ -173,6 +266,60 @@ std::unique_ptr<aikido::trajectory::Spline> ParabolicSmoother::postprocess(
   return timedTrajectory;
 }
 
+//==============================================================================
+void ParabolicSmoother::setShortcutFeasibilityChecks(
+    std::vector<aikido::constraint::TestablePtr> _feasibilityChecks,
+    std::vector<aikido::constraint::ClearancePtr> _clearances)
+{
+  for (const auto& feasibilityCheck : _feasibilityChecks)
+  {
+    if (!feasibilityCheck)
+      throw std::invalid_argument("Shortcut feasibility check is nullptr.");
+  }
+
+  if (!_clearances.empty() && _clearances.size() != _feasibilityChecks.size())
+    throw std::invalid_argument(
+        "There should be one shortcut clearance per feasibility check or "
+        "none.");
+
+  for (const auto& clearance : _clearances)
+  {
+    if (!clearance)
+      throw std::invalid_argument("Shortcut clearance is nullptr.");
+  }
+
+  mShortcutFeasibilityChecks = std::move(_feasibilityChecks);
+  mShortcutFeasibilityClearances = std::move(_clearances);
+}
+
+//==============================================================================
+const std::vector<aikido::constraint::TestablePtr>&
+ParabolicSmoother::getShortcutFeasibilityChecks() const
+{
+  return mShortcutFeasibilityChecks;
+}
+
+//==============================================================================
+const std::vector<aikido::constraint::ClearancePtr>&
+ParabolicSmoother::getShortcutFeasibilityClearances() const
+{
+  return mShortcutFeasibilityClearances;
+}
+
+//==============================================================================
+void ParabolicSmoother::setFeasibilityClearance(
+    aikido::constraint::ClearancePtr _clearance)
+{
+  mFeasibilityClearance = std::move(_clearance);
+}
+
+//==============================================================================
+aikido::constraint::ClearancePtr ParabolicSmoother::getFeasibilityClearance()
+    const
+{
+  return mFeasibilityClearance;
+}
+
 //==============================================================================
 std::unique_ptr<aikido::trajectory::Spline>
 ParabolicSmoother::handleShortcutOrBlend(
@@ -188,6 +335,7 @@ ParabolicSmoother::handleShortcutOrBlend(
   {
     return doShortcutAndBlend(
         _inputTraj,
+        mShortcutFeasibilityChecks,
         _collisionTestable,
         mVelocityLimits,
         mAccelerationLimits,
@@ -196,7 +344,22 @@ ParabolicSmoother::handleShortcutOrBlend(
         mBlendRadius,
         mBlendIterations,
         mFeasibilityCheckResolution,
-        mFeasibilityApproxTolerance);
+        mFeasibilityApproxTolerance,
+        mFeasibilityClearance,
+        mShortcutFeasibilityClearances);
+  }
+  else if (mEnableShortcut && !mShortcutFeasibilityChecks.empty())
+  {
+    return doShortcut(
+        _inputTraj,
+        mShortcutFeasibilityChecks,
+        mVelocityLimits,
+        mAccelerationLimits,
+        *_rng.clone(),
+        mShortcutTimelimit,
+        mFeasibilityCheckResolution,
+        mFeasibilityApproxTolerance,
+        mShortcutFeasibilityClearances);
   }
   else if (mEnableShortcut)
   {
@@ -208,7 +371,8 @@ ParabolicSmoother::handleShortcutOrBlend(
         *_rng.clone(),
         mShortcutTimelimit,
         mFeasibilityCheckResolution,
-        mFeasibilityApproxTolerance);
+        mFeasibilityApproxTolerance,
+        mFeasibilityClearance);
   }
   else if (mEnableBlend)
   {
@@ -220,7 +384,8 @@ ParabolicSmoother::handleShortcutOrBlend(
         mBlendRadius,
         mBlendIterations,
         mFeasibilityCheckResolution,
-        mFeasibilityApproxTolerance);
+        mFeasibilityApproxTolerance,
+        mFeasibilityClearance);
   }
 
   return nullptr;
@@ -1,23 +1,23 @@
 #include "aikido/planner/parabolic/ParabolicTimer.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <exception>
 #include <set>
+#include <thread>
 #include <dart/common/StlHelpers.hpp>
 #include "aikido/common/Spline.hpp"
 #include "aikido/trajectory/Interpolated.hpp"
+#include "../detail/TimingUtil.hpp"
 #include "DynamicPath.h"
 #include "ParabolicUtil.hpp"
 
-using Eigen::Vector2d;
 using dart::common::make_unique;
 
-using LinearSplineProblem
-    = aikido::common::SplineProblem<double, int, 2, Eigen::Dynamic, 2>;
-
 namespace aikido {
 namespace planner {
 namespace parabolic {
-
 //==============================================================================
 std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
     const aikido::trajectory::Interpolated& _inputTrajectory)
@@ -33,10 +33,9 @@ std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
   }
 
   const auto stateSpace = _inputTrajectory.getStateSpace();
-  const auto dimension = stateSpace->getDimension();
   const auto numWaypoints = _inputTrajectory.getNumWaypoints();
 
-  if (!detail::checkStateSpace(stateSpace.get()))
+  if (!planner::detail::checkStateSpace(stateSpace.get()))
     throw std::invalid_argument(
         "computeParabolicTiming only supports Rn, "
         "SO2, and CartesianProducts consisting of those types.");
@@ -59,14 +58,8 @@ std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
     stateSpace->logMap(nextState, nextVec);
 
     // Compute the spline coefficients for this segment of the trajectory.
-    LinearSplineProblem problem(
-        Vector2d(0, nextTime - currentTime), 2, dimension);
-    problem.addConstantConstraint(0, 0, Eigen::VectorXd::Zero(dimension));
-    problem.addConstantConstraint(1, 0, nextVec - currentVec);
-    const auto spline = problem.fit();
-
-    assert(spline.getCoefficients().size() == 1);
-    const auto& coefficients = spline.getCoefficients().front();
+    const auto coefficients = common::fitLinearSegment(
+        nextVec - currentVec, nextTime - currentTime);
     outputTrajectory->addSegment(
         coefficients, nextTime - currentTime, currentState);
   }
@@ -81,26 +74,8 @@ std::unique_ptr<aikido::trajectory::Spline> computeParabolicTiming(
     const Eigen::VectorXd& _maxAcceleration)
 {
   const auto stateSpace = _inputTrajectory.getStateSpace();
-  const auto dimension = stateSpace->getDimension();
-
-  if (static_cast<std::size_t>(_maxVelocity.size()) != dimension)
-    throw std::invalid_argument("Velocity limits have wrong dimension.");
-
-  if (static_cast<std::size_t>(_maxAcceleration.size()) != dimension)
-    throw std::invalid_argument("Acceleration limits have wrong dimension.");
-
-  for (std::size_t i = 0; i < dimension; ++i)
-  {
-    if (_maxVelocity[i] <= 0.)
-      throw std::invalid_argument("Velocity limits must be positive.");
-    if (!std::isfinite(_maxVelocity[i]))
-      throw std::invalid_argument("Velocity limits must be finite.");
-
-    if (_maxAcceleration[i] <= 0.)
-      throw std::invalid_argument("Acceleration limits must be positive.");
-    if (!std::isfinite(_maxAcceleration[i]))
-      throw std::invalid_argument("Acceleration limits must be finite.");
-  }
+  planner::detail::checkLimits(
+      stateSpace->getDimension(), _maxVelocity, _maxAcceleration);
 
   double startTime = _inputTrajectory.getStartTime();
   auto dynamicPath = detail::convertToDynamicPath(
@@ -118,26 +93,8 @@ std::unique_ptr<aikido::trajectory::Spline> computeParabolicTiming(
     const Eigen::VectorXd& _maxAcceleration)
 {
   const auto stateSpace = _inputTrajectory.getStateSpace();
-  const auto dimension = stateSpace->getDimension();
-
-  if (static_cast<std::size_t>(_maxVelocity.size()) != dimension)
-    throw std::invalid_argument("Velocity limits have wrong dimension.");
-
-  if (static_cast<std::size_t>(_maxAcceleration.size()) != dimension)
-    throw std::invalid_argument("Acceleration limits have wrong dimension.");
-
-  for (std::size_t i = 0; i < dimension; ++i)
-  {
-    if (_maxVelocity[i] <= 0.)
-      throw std::invalid_argument("Velocity limits must be positive.");
-    if (!std::isfinite(_maxVelocity[i]))
-      throw std::invalid_argument("Velocity limits must be finite.");
-
-    if (_maxAcceleration[i] <= 0.)
-      throw std::invalid_argument("Acceleration limits must be positive.");
-    if (!std::isfinite(_maxAcceleration[i]))
-      throw std::invalid_argument("Acceleration limits must be finite.");
-  }
+  planner::detail::checkLimits(
+      stateSpace->getDimension(), _maxVelocity, _maxAcceleration);
 
   double startTime = _inputTrajectory.getStartTime();
   auto dynamicPath = detail::convertToDynamicPath(
@@ -148,6 +105,92 @@ std::unique_ptr<aikido::trajectory::Spline> computeParabolicTiming(
   return outputTrajectory;
 }
 
+//==============================================================================
+std::vector<std::unique_ptr<aikido::trajectory::Spline>> computeParabolicTiming(
+    const std::vector<aikido::trajectory::ConstInterpolatedPtr>&
+        _inputTrajectories,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    std::size_t _numThreads)
+{
+  const auto numTrajectories = _inputTrajectories.size();
+  std::vector<std::unique_ptr<aikido::trajectory::Spline>> outputTrajectories(
+      numTrajectories);
+  if (numTrajectories == 0)
+    return outputTrajectories;
+
+  for (const auto& inputTrajectory : _inputTrajectories)
+  {
+    if (!inputTrajectory)
+      throw std::invalid_argument("Trajectory is nullptr.");
+    if (inputTrajectory->getNumWaypoints() == 0)
+      throw std::invalid_argument("Trajectory is empty.");
+  }
+
+  const auto stateSpace = _inputTrajectories.front()->getStateSpace();
+  for (const auto& inputTrajectory : _inputTrajectories)
+  {
+    if (inputTrajectory->getStateSpace() != stateSpace)
+      throw std::invalid_argument(
+          "Trajectories must be defined in the same state space.");
+  }
+
+  if (!planner::detail::checkStateSpace(stateSpace.get()))
+    throw std::invalid_argument(
+        "computeParabolicTiming only supports Rn, "
+        "SO2, and CartesianProducts consisting of those types.");
+
+  planner::detail::checkLimits(
+      stateSpace->getDimension(), _maxVelocity, _maxAcceleration);
+
+  const auto maxVelocity = detail::toVector(_maxVelocity);
+  const auto maxAcceleration = detail::toVector(_maxAcceleration);
+
+  // Trajectories are handed out one at a time, so a few long trajectories do
+  // not leave the other threads idle.
+  std::atomic<std::size_t> nextIndex(0);
+  std::vector<std::exception_ptr> errors(numTrajectories);
+  auto retime = [&]() {
+    for (std::size_t i = nextIndex++; i < numTrajectories; i = nextIndex++)
+    {
+      try
+      {
+        const auto& inputTrajectory = *_inputTrajectories[i];
+        auto dynamicPath = detail::convertToDynamicPath(
+            inputTrajectory, maxVelocity, maxAcceleration);
+        outputTrajectories[i] = detail::convertToSpline(
+            *dynamicPath, inputTrajectory.getStartTime(), stateSpace);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+
+  std::size_t numThreads = _numThreads;
+  if (numThreads == 0)
+    numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  numThreads = std::min(numThreads, numTrajectories);
+
+  // The calling thread retimes too.
+  std::vector<std::thread> workers;
+  workers.reserve(numThreads - 1);
+  for (std::size_t i = 1; i < numThreads; ++i)
+    workers.emplace_back(retime);
+  retime();
+  for (auto& worker : workers)
+    worker.join();
+
+  for (const auto& error : errors)
+  {
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  return outputTrajectories;
+}
+
 //==============================================================================
 ParabolicTimer::ParabolicTimer(
     const Eigen::VectorXd& _velocityLimits,
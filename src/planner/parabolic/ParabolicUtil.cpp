@@ -6,25 +6,15 @@
 #include <dart/common/StlHelpers.hpp>
 #include <dart/dart.hpp>
 #include <aikido/common/Spline.hpp>
-#include <aikido/statespace/CartesianProduct.hpp>
 #include <aikido/statespace/GeodesicInterpolator.hpp>
-#include <aikido/statespace/Rn.hpp>
-#include <aikido/statespace/SO2.hpp>
 #include <aikido/trajectory/Interpolated.hpp>
 #include <aikido/trajectory/Spline.hpp>
 
 #include "DynamicPath.h"
 
-using Eigen::Vector2d;
-using aikido::statespace::CartesianProduct;
-using aikido::statespace::R;
-using aikido::statespace::SO2;
 using aikido::statespace::StateSpace;
 using dart::common::make_unique;
 
-using CubicSplineProblem
-    = aikido::common::SplineProblem<double, int, 4, Eigen::Dynamic, 2>;
-
 namespace aikido {
 namespace planner {
 namespace parabolic {
@@ -65,72 +55,27 @@ void evaluateAtTime(
   _velocity = toEigen(velocityVector);
 }
 
-bool checkStateSpace(const statespace::StateSpace* _stateSpace)
-{
-  // TODO(JS): Generalize Rn<N> for arbitrary N.
-  if (dynamic_cast<const R<0>*>(_stateSpace) != nullptr)
-  {
-    return true;
-  }
-  else if (dynamic_cast<const R<1>*>(_stateSpace) != nullptr)
-  {
-    return true;
-  }
-  else if (dynamic_cast<const R<2>*>(_stateSpace) != nullptr)
-  {
-    return true;
-  }
-  else if (dynamic_cast<const R<3>*>(_stateSpace) != nullptr)
-  {
-    return true;
-  }
-  else if (dynamic_cast<const R<4>*>(_stateSpace) != nullptr)
-  {
-    return true;
-  }
-  else if (dynamic_cast<const R<5>*>(_stateSpace) != nullptr)
-  {
-    return true;
-  }
-  else if (dynamic_cast<const R<6>*>(_stateSpace) != nullptr)
-  {
-    return true;
-  }
-  else if (dynamic_cast<const R<Eigen::Dynamic>*>(_stateSpace) != nullptr)
-  {
-    return true;
-  }
-  else if (dynamic_cast<const SO2*>(_stateSpace) != nullptr)
-  {
-    return true;
-  }
-  else if (auto space = dynamic_cast<const CartesianProduct*>(_stateSpace))
-  {
-    for (std::size_t isubspace = 0; isubspace < space->getNumSubspaces();
-         ++isubspace)
-    {
-      if (!checkStateSpace(space->getSubspace<>(isubspace).get()))
-        return false;
-    }
-    return true;
-  }
-  else
-  {
-    return false;
-  }
-}
-
 std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
     const ParabolicRamp::DynamicPath& _inputPath,
     double _startTime,
     statespace::ConstStateSpacePtr _stateSpace)
 {
-  const auto dimension = _stateSpace->getDimension();
+  auto _outputTrajectory
+      = make_unique<aikido::trajectory::Spline>(_stateSpace, _startTime);
+  appendToSpline(_inputPath, *_outputTrajectory);
+  return _outputTrajectory;
+}
 
+std::vector<std::size_t> appendToSpline(
+    const ParabolicRamp::DynamicPath& _inputPath,
+    aikido::trajectory::Spline& _outputTrajectory)
+{
   // Construct a list of all ramp transition points.
   double t = 0.;
   std::set<double> transitionTimes;
+  std::vector<double> rampEndTimes;
   transitionTimes.insert(t);
+  rampEndTimes.reserve(_inputPath.ramps.size());
 
   for (const auto& rampNd : _inputPath.ramps)
   {
@@ -142,6 +87,7 @@ std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
 
     t += rampNd.endTime;
     transitionTimes.insert(t);
+    rampEndTimes.push_back(t);
   }
 
   // Convert the output to a spline with a knot at each transition time.
@@ -153,36 +99,46 @@ std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
   Eigen::VectorXd positionPrev, velocityPrev;
   evaluateAtTime(_inputPath, timePrev, positionPrev, velocityPrev);
 
-  auto _outputTrajectory = make_unique<aikido::trajectory::Spline>(
-      _stateSpace, timePrev + _startTime);
-  auto segmentStartState = _stateSpace->createState();
+  const auto stateSpace = _outputTrajectory.getStateSpace();
+  auto segmentStartState = stateSpace->createState();
+
+  // Every ramp end time is a transition time, so each ramp starts at a knot.
+  // Records the first segment of each ramp that starts at or before _t.
+  std::vector<std::size_t> rampSegments(1, _outputTrajectory.getNumSegments());
+  rampSegments.reserve(rampEndTimes.size() + 1);
+  const auto addRampSegments = [&](double _t) {
+    while (rampSegments.size() <= rampEndTimes.size()
+           && rampEndTimes[rampSegments.size() - 1] <= _t)
+      rampSegments.push_back(_outputTrajectory.getNumSegments());
+  };
+  addRampSegments(timePrev);
 
   for (const auto timeCurr : transitionTimes)
   {
     Eigen::VectorXd positionCurr, velocityCurr;
     evaluateAtTime(_inputPath, timeCurr, positionCurr, velocityCurr);
 
-    CubicSplineProblem problem(Vector2d(0, timeCurr - timePrev), 4, dimension);
-    problem.addConstantConstraint(0, 0, Eigen::VectorXd::Zero(dimension));
-    problem.addConstantConstraint(0, 1, velocityPrev);
-    problem.addConstantConstraint(1, 0, positionCurr - positionPrev);
-    problem.addConstantConstraint(1, 1, velocityCurr);
-    const auto spline = problem.fit();
+    const auto coefficients = common::fitCubicHermiteSegment(
+        positionCurr - positionPrev,
+        velocityPrev,
+        velocityCurr,
+        timeCurr - timePrev);
 
-    _stateSpace->expMap(positionPrev, segmentStartState);
+    stateSpace->expMap(positionPrev, segmentStartState);
 
     // Add the ramp to the output trajectory.
-    assert(spline.getCoefficients().size() == 1);
-    const auto& coefficients = spline.getCoefficients().front();
-    _outputTrajectory->addSegment(
+    _outputTrajectory.addSegment(
         coefficients, timeCurr - timePrev, segmentStartState);
 
+    addRampSegments(timeCurr);
+
     timePrev = timeCurr;
     positionPrev = positionCurr;
     velocityPrev = velocityCurr;
   }
 
-  return _outputTrajectory;
+  assert(rampSegments.size() == rampEndTimes.size() + 1);
+  return rampSegments;
 }
 
 std::unique_ptr<ParabolicRamp::DynamicPath> convertToDynamicPath(
@@ -199,19 +155,17 @@ std::unique_ptr<ParabolicRamp::DynamicPath> convertToDynamicPath(
   milestones.reserve(numWaypoints);
   velocities.reserve(numWaypoints);
 
-  Eigen::VectorXd tangentVector, currVec;
-
-  for (std::size_t iwaypoint = 0; iwaypoint < numWaypoints; ++iwaypoint)
-  {
-    auto currentState = stateSpace->createState();
-    _inputTrajectory.getWaypoint(iwaypoint, currentState);
-
-    stateSpace->logMap(currentState, currVec);
-    milestones.emplace_back(toVector(currVec));
+  Eigen::VectorXd currVec;
 
-    _inputTrajectory.getWaypointDerivative(iwaypoint, 1, tangentVector);
-    velocities.emplace_back(toVector(tangentVector));
-  }
+  _inputTrajectory.visitWaypoints(
+      [&](std::size_t /*index*/,
+          double /*time*/,
+          const statespace::StateSpace::State* currentState,
+          const Eigen::VectorXd& tangentVector) {
+        stateSpace->logMap(currentState, currVec);
+        milestones.emplace_back(toVector(currVec));
+        velocities.emplace_back(toVector(tangentVector));
+      });
 
   auto outputPath = make_unique<ParabolicRamp::DynamicPath>();
   outputPath->Init(toVector(_maxVelocity), toVector(_maxAcceleration));
@@ -232,6 +186,15 @@ std::unique_ptr<ParabolicRamp::DynamicPath> convertToDynamicPath(
     const aikido::trajectory::Interpolated& _inputTrajectory,
     const Eigen::VectorXd& _maxVelocity,
     const Eigen::VectorXd& _maxAcceleration)
+{
+  return convertToDynamicPath(
+      _inputTrajectory, toVector(_maxVelocity), toVector(_maxAcceleration));
+}
+
+std::unique_ptr<ParabolicRamp::DynamicPath> convertToDynamicPath(
+    const aikido::trajectory::Interpolated& _inputTrajectory,
+    const ParabolicRamp::Vector& _maxVelocity,
+    const ParabolicRamp::Vector& _maxAcceleration)
 {
   const auto stateSpace = _inputTrajectory.getStateSpace();
   const auto numWaypoints = _inputTrajectory.getNumWaypoints();
@@ -251,7 +214,7 @@ std::unique_ptr<ParabolicRamp::DynamicPath> convertToDynamicPath(
   }
 
   auto outputPath = make_unique<ParabolicRamp::DynamicPath>();
-  outputPath->Init(toVector(_maxVelocity), toVector(_maxAcceleration));
+  outputPath->Init(_maxVelocity, _maxAcceleration);
   outputPath->SetMilestones(milestones);
   if (!outputPath->IsValid())
     throw std::runtime_error("Converted DynamicPath is not valid");
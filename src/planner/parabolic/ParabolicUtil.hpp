@@ -32,11 +32,6 @@ Eigen::VectorXd toEigen(const ParabolicRamp::Vector& _x);
 void evaluateAtTime(ParabolicRamp::DynamicPath& _path, double _t,
     Eigen::VectorXd& _position, Eigen::VectorXd& _velocity);
 
-/// Check wether the state space is supported
-/// \param _stateSpace the state space to be checked
-/// \return whether the state space is supported
-bool checkStateSpace(const statespace::StateSpace* _stateSpace);
-
 /// Convert an interpolated trajectory to a spline trajectory
 /// \param _inputTrajectory interpolated trajectory
 /// \return a spline trajectory
@@ -53,6 +48,16 @@ std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
         double _startTime,
         statespace::ConstStateSpacePtr _stateSpace);
 
+/// Append a dynamic path to a spline trajectory. The segments of the path
+/// start at the end time of \c _outputTrajectory.
+/// \param _inputPath dynamic path
+/// \param[out] _outputTrajectory spline trajectory to append to
+/// \return index of the first segment of each ramp in
+/// \c _outputTrajectory, followed by the number of segments
+std::vector<std::size_t> appendToSpline(
+    const ParabolicRamp::DynamicPath& _inputPath,
+    aikido::trajectory::Spline& _outputTrajectory);
+
 /// Convert a spline trajectory to a dynamic path
 /// \param _inputTrajectory a spline trajectory
 /// \param _maxVelocity maximum velocity in each dimension
@@ -75,6 +80,17 @@ std::unique_ptr<ParabolicRamp::DynamicPath>
                          const Eigen::VectorXd& _maxVelocity,
                          const Eigen::VectorXd& _maxAcceleration);
 
+/// Convert an interpolated trajectory to a dynamic path, with limits that
+/// were already converted to ParabolicRamp vectors
+/// \param _inputTrajectory a spline trajectory
+/// \param _maxVelocity maximum velocity in each dimension
+/// \param _maxAcceleration maximum acceleration in each dimension
+/// \return a dynamic path
+std::unique_ptr<ParabolicRamp::DynamicPath>
+    convertToDynamicPath(const aikido::trajectory::Interpolated& _inputTrajectory,
+                         const ParabolicRamp::Vector& _maxVelocity,
+                         const ParabolicRamp::Vector& _maxAcceleration);
+
 } // namespace detail
 } // namespace parabolic
 } // namespace planner
@@ -0,0 +1,339 @@
+#include "aikido/planner/scurve/SCurveTimer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <dart/common/StlHelpers.hpp>
+
+using dart::common::make_unique;
+using aikido::statespace::ConstStateSpacePtr;
+using aikido::statespace::StateSpace;
+
+namespace aikido {
+namespace planner {
+namespace scurve {
+namespace {
+
+/// Waypoints closer than this are merged.
+constexpr double kMinWaypointDistance = 1e-10;
+
+/// Phases shorter than this are dropped.
+constexpr double kMinPhaseDuration = 1e-12;
+
+//==============================================================================
+void checkLimits(
+    const StateSpace& _stateSpace,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    const Eigen::VectorXd& _maxJerk)
+{
+  const auto dimension = _stateSpace.getDimension();
+
+  if (static_cast<std::size_t>(_maxVelocity.size()) != dimension)
+    throw std::invalid_argument("Velocity limits have wrong dimension.");
+
+  if (static_cast<std::size_t>(_maxAcceleration.size()) != dimension)
+    throw std::invalid_argument("Acceleration limits have wrong dimension.");
+
+  if (static_cast<std::size_t>(_maxJerk.size()) != dimension)
+    throw std::invalid_argument("Jerk limits have wrong dimension.");
+
+  for (std::size_t i = 0; i < dimension; ++i)
+  {
+    if (_maxVelocity[i] <= 0.)
+      throw std::invalid_argument("Velocity limits must be positive.");
+    if (!std::isfinite(_maxVelocity[i]))
+      throw std::invalid_argument("Velocity limits must be finite.");
+
+    if (_maxAcceleration[i] <= 0.)
+      throw std::invalid_argument("Acceleration limits must be positive.");
+    if (!std::isfinite(_maxAcceleration[i]))
+      throw std::invalid_argument("Acceleration limits must be finite.");
+
+    if (_maxJerk[i] <= 0.)
+      throw std::invalid_argument("Jerk limits must be positive.");
+    if (!std::isfinite(_maxJerk[i]))
+      throw std::invalid_argument("Jerk limits must be finite.");
+  }
+}
+
+/// Durations and jerks of the seven phases of a rest-to-rest S-curve profile.
+struct SCurveProfile
+{
+  std::array<double, 7> mDurations;
+  std::array<double, 7> mJerks;
+};
+
+//==============================================================================
+/// Computes the time-optimal rest-to-rest profile that travels \c _distance
+/// under the bounds \c _v, \c _a, and \c _j on the magnitudes of velocity,
+/// acceleration, and jerk.
+SCurveProfile computeProfile(double _distance, double _v, double _a, double _j)
+{
+  // Durations of a jerk phase, of a whole acceleration phase, and of the
+  // constant velocity phase.
+  double jerkDuration;
+  double accelerationDuration;
+  double coastDuration;
+
+  if (_v * _j >= _a * _a)
+  {
+    jerkDuration = _a / _j;
+    accelerationDuration = jerkDuration + _v / _a;
+  }
+  else
+  {
+    jerkDuration = std::sqrt(_v / _j);
+    accelerationDuration = 2. * jerkDuration;
+  }
+  coastDuration = _distance / _v - accelerationDuration;
+
+  // The velocity limit is not reached.
+  if (coastDuration < 0.)
+  {
+    coastDuration = 0.;
+
+    if (_distance >= 2. * _a * _a * _a / (_j * _j))
+    {
+      jerkDuration = _a / _j;
+      accelerationDuration
+          = 0.5
+            * (jerkDuration
+               + std::sqrt(jerkDuration * jerkDuration + 4. * _distance / _a));
+    }
+    else
+    {
+      jerkDuration = std::cbrt(0.5 * _distance / _j);
+      accelerationDuration = 2. * jerkDuration;
+    }
+  }
+
+  const double constantAccelerationDuration
+      = std::max(0., accelerationDuration - 2. * jerkDuration);
+
+  SCurveProfile profile;
+  profile.mDurations = {{jerkDuration,
+                         constantAccelerationDuration,
+                         jerkDuration,
+                         coastDuration,
+                         jerkDuration,
+                         constantAccelerationDuration,
+                         jerkDuration}};
+  profile.mJerks = {{_j, 0., -_j, 0., -_j, 0., _j}};
+  return profile;
+}
+
+/// Appends a jerk-limited timing of the geodesic between consecutive
+/// waypoints to a spline.
+class SCurveBuilder
+{
+public:
+  SCurveBuilder(
+      ConstStateSpacePtr _stateSpace,
+      double _startTime,
+      const Eigen::VectorXd& _maxVelocity,
+      const Eigen::VectorXd& _maxAcceleration,
+      const Eigen::VectorXd& _maxJerk)
+    : mStateSpace(std::move(_stateSpace))
+    , mMaxVelocity(_maxVelocity)
+    , mMaxAcceleration(_maxAcceleration)
+    , mMaxJerk(_maxJerk)
+    , mOutputTrajectory(
+          make_unique<aikido::trajectory::Spline>(mStateSpace, _startTime))
+    , mPrevious(mStateSpace->createState())
+    , mInverse(mStateSpace->createState())
+    , mDifference(mStateSpace->createState())
+    , mPhaseStartState(mStateSpace->createState())
+    , mCoefficients(mStateSpace->getDimension(), 4)
+  {
+    // Do nothing
+  }
+
+  void add(const StateSpace::State* _state)
+  {
+    if (!mHasPrevious)
+    {
+      mHasPrevious = true;
+      mStateSpace->copyState(_state, mPrevious);
+      return;
+    }
+
+    mStateSpace->getInverse(mPrevious, mInverse);
+    mStateSpace->compose(mInverse, _state, mDifference);
+    mStateSpace->logMap(mDifference, mDisplacement);
+
+    if (mDisplacement.norm() <= kMinWaypointDistance)
+      return;
+
+    addGeodesic();
+    mStateSpace->copyState(_state, mPrevious);
+  }
+
+  std::unique_ptr<aikido::trajectory::Spline> finish()
+  {
+    return std::move(mOutputTrajectory);
+  }
+
+private:
+  /// Times the geodesic from mPrevious along mDisplacement. The path is
+  /// parameterized by p in [0, 1], so a bound on each dimension becomes a
+  /// bound on p scaled by the displacement of that dimension.
+  void addGeodesic()
+  {
+    double maxVelocity = std::numeric_limits<double>::infinity();
+    double maxAcceleration = std::numeric_limits<double>::infinity();
+    double maxJerk = std::numeric_limits<double>::infinity();
+
+    for (int i = 0; i < mDisplacement.size(); ++i)
+    {
+      const double distance = std::abs(mDisplacement[i]);
+      if (distance == 0.)
+        continue;
+
+      maxVelocity = std::min(maxVelocity, mMaxVelocity[i] / distance);
+      maxAcceleration
+          = std::min(maxAcceleration, mMaxAcceleration[i] / distance);
+      maxJerk = std::min(maxJerk, mMaxJerk[i] / distance);
+    }
+
+    const auto profile
+        = computeProfile(1., maxVelocity, maxAcceleration, maxJerk);
+
+    // Integrate the path parameter through the phases. Each phase is a cubic
+    // polynomial in the tangent space of the state it starts at.
+    double position = 0.;
+    double velocity = 0.;
+    double acceleration = 0.;
+
+    for (std::size_t iphase = 0; iphase < profile.mDurations.size(); ++iphase)
+    {
+      const double duration = profile.mDurations[iphase];
+      const double jerk = profile.mJerks[iphase];
+      if (duration < kMinPhaseDuration)
+        continue;
+
+      mTangent = position * mDisplacement;
+      mStateSpace->expMap(mTangent, mDifference);
+      mStateSpace->compose(mPrevious, mDifference, mPhaseStartState);
+
+      mCoefficients.col(0).setZero();
+      mCoefficients.col(1) = velocity * mDisplacement;
+      mCoefficients.col(2) = (0.5 * acceleration) * mDisplacement;
+      mCoefficients.col(3) = (jerk / 6.) * mDisplacement;
+      mOutputTrajectory->addSegment(mCoefficients, duration, mPhaseStartState);
+
+      position += duration
+                  * (velocity
+                     + duration * (0.5 * acceleration + duration * jerk / 6.));
+      velocity += duration * (acceleration + 0.5 * duration * jerk);
+      acceleration += duration * jerk;
+    }
+  }
+
+  ConstStateSpacePtr mStateSpace;
+  const Eigen::VectorXd& mMaxVelocity;
+  const Eigen::VectorXd& mMaxAcceleration;
+  const Eigen::VectorXd& mMaxJerk;
+  std::unique_ptr<aikido::trajectory::Spline> mOutputTrajectory;
+
+  bool mHasPrevious = false;
+  StateSpace::ScopedState mPrevious;
+  StateSpace::ScopedState mInverse;
+  StateSpace::ScopedState mDifference;
+  StateSpace::ScopedState mPhaseStartState;
+  Eigen::VectorXd mDisplacement;
+  Eigen::VectorXd mTangent;
+  Eigen::MatrixXd mCoefficients;
+};
+
+} // namespace
+
+//==============================================================================
+std::unique_ptr<aikido::trajectory::Spline> computeSCurveTiming(
+    const aikido::trajectory::Interpolated& _inputTrajectory,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    const Eigen::VectorXd& _maxJerk)
+{
+  const auto stateSpace = _inputTrajectory.getStateSpace();
+  checkLimits(*stateSpace, _maxVelocity, _maxAcceleration, _maxJerk);
+
+  if (_inputTrajectory.getNumWaypoints() == 0)
+    throw std::invalid_argument("Trajectory is empty.");
+
+  SCurveBuilder builder(
+      stateSpace,
+      _inputTrajectory.getStartTime(),
+      _maxVelocity,
+      _maxAcceleration,
+      _maxJerk);
+  for (std::size_t i = 0; i < _inputTrajectory.getNumWaypoints(); ++i)
+    builder.add(_inputTrajectory.getWaypoint(i));
+
+  return builder.finish();
+}
+
+//==============================================================================
+std::unique_ptr<aikido::trajectory::Spline> computeSCurveTiming(
+    const aikido::trajectory::Spline& _inputTrajectory,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    const Eigen::VectorXd& _maxJerk)
+{
+  const auto stateSpace = _inputTrajectory.getStateSpace();
+  checkLimits(*stateSpace, _maxVelocity, _maxAcceleration, _maxJerk);
+
+  if (_inputTrajectory.getNumSegments() == 0)
+    throw std::invalid_argument("Trajectory is empty.");
+
+  SCurveBuilder builder(
+      stateSpace,
+      _inputTrajectory.getStartTime(),
+      _maxVelocity,
+      _maxAcceleration,
+      _maxJerk);
+  _inputTrajectory.visitWaypoints(
+      [&](std::size_t /*index*/,
+          double /*time*/,
+          const StateSpace::State* state,
+          const Eigen::VectorXd& /*velocity*/) { builder.add(state); });
+
+  return builder.finish();
+}
+
+//==============================================================================
+SCurveTimer::SCurveTimer(
+    const Eigen::VectorXd& _velocityLimits,
+    const Eigen::VectorXd& _accelerationLimits,
+    const Eigen::VectorXd& _jerkLimits)
+  : mVelocityLimits{_velocityLimits}
+  , mAccelerationLimits{_accelerationLimits}
+  , mJerkLimits{_jerkLimits}
+{
+  // Do nothing
+}
+
+//==============================================================================
+std::unique_ptr<aikido::trajectory::Spline> SCurveTimer::postprocess(
+    const aikido::trajectory::Interpolated& _inputTraj,
+    const aikido::common::RNG& /*_rng*/,
+    const aikido::constraint::TestablePtr& /*_constraint*/)
+{
+  return computeSCurveTiming(
+      _inputTraj, mVelocityLimits, mAccelerationLimits, mJerkLimits);
+}
+
+//==============================================================================
+std::unique_ptr<aikido::trajectory::Spline> SCurveTimer::postprocess(
+    const aikido::trajectory::Spline& _inputTraj,
+    const aikido::common::RNG& /*_rng*/,
+    const aikido::constraint::TestablePtr& /*_constraint*/)
+{
+  return computeSCurveTiming(
+      _inputTraj, mVelocityLimits, mAccelerationLimits, mJerkLimits);
+}
+
+} // namespace scurve
+} // namespace planner
+} // namespace aikido
@@ -0,0 +1,691 @@
+#include "aikido/planner/toppra/ToppraTimer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <dart/common/StlHelpers.hpp>
+#include "aikido/constraint/Testable.hpp"
+#include "../detail/TimingUtil.hpp"
+
+using dart::common::make_unique;
+using aikido::constraint::Testable;
+using aikido::statespace::ConstStateSpacePtr;
+using aikido::statespace::StateSpace;
+
+namespace aikido {
+namespace planner {
+namespace toppra {
+namespace {
+
+/// Waypoints closer than this are merged.
+constexpr double kMinWaypointDistance = 1e-10;
+
+/// Tolerance used when testing whether a point satisfies a linear constraint.
+constexpr double kFeasibilityTolerance = 1e-9;
+
+/// Bound on the squared path velocity where no joint limits it.
+constexpr double kMaxSquaredPathVelocity = 1e12;
+
+/// Changes of direction at a waypoint smaller than this are not blended.
+constexpr double kMinDirectionChange = 1e-9;
+
+//==============================================================================
+void checkInputs(
+    const StateSpace& _stateSpace,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    double _gridResolution,
+    double _maxDeviation)
+{
+  if (!planner::detail::checkStateSpace(&_stateSpace))
+    throw std::invalid_argument(
+        "computeToppraTiming only supports Rn, "
+        "SO2, and CartesianProducts consisting of those types.");
+
+  planner::detail::checkLimits(
+      _stateSpace.getDimension(), _maxVelocity, _maxAcceleration);
+
+  if (!(_gridResolution > 0.) || !std::isfinite(_gridResolution))
+    throw std::invalid_argument("Grid resolution must be positive and finite.");
+
+  if (!(_maxDeviation >= 0.) || !std::isfinite(_maxDeviation))
+    throw std::invalid_argument(
+        "Maximum deviation must be non-negative and finite.");
+}
+
+/// Collects waypoints as points in the tangent space of the first waypoint.
+/// Each waypoint is reached from the previous one along the same geodesic
+/// that \c GeodesicInterpolator follows.
+class WaypointCollector
+{
+public:
+  explicit WaypointCollector(ConstStateSpacePtr _stateSpace)
+    : mStateSpace(std::move(_stateSpace))
+    , mPrevious(mStateSpace->createState())
+    , mInverse(mStateSpace->createState())
+    , mDifference(mStateSpace->createState())
+  {
+    // Do nothing
+  }
+
+  void add(const StateSpace::State* _state)
+  {
+    if (mPositions.empty())
+    {
+      mStateSpace->logMap(_state, mTangent);
+      mPositions.push_back(mTangent);
+    }
+    else
+    {
+      mStateSpace->getInverse(mPrevious, mInverse);
+      mStateSpace->compose(mInverse, _state, mDifference);
+      mStateSpace->logMap(mDifference, mTangent);
+
+      if (mTangent.norm() > kMinWaypointDistance)
+        mPositions.push_back(mPositions.back() + mTangent);
+    }
+
+    mStateSpace->copyState(_state, mPrevious);
+  }
+
+  const std::vector<Eigen::VectorXd>& getPositions() const
+  {
+    return mPositions;
+  }
+
+private:
+  ConstStateSpacePtr mStateSpace;
+  StateSpace::ScopedState mPrevious;
+  StateSpace::ScopedState mInverse;
+  StateSpace::ScopedState mDifference;
+  Eigen::VectorXd mTangent;
+  std::vector<Eigen::VectorXd> mPositions;
+};
+
+/// Piecewise quadratic path q(s). Segment k is defined for s in
+/// [mKnots[k], mKnots[k + 1]] by the coefficients mCoefficients[k] of
+/// (s - mKnots[k])^0, ..., (s - mKnots[k])^2. The first derivative of the path
+/// is continuous, except at the knots where mIsStop is set, which must be
+/// passed at rest.
+struct Path
+{
+  std::vector<double> mKnots;
+  std::vector<Eigen::MatrixXd> mCoefficients;
+
+  /// Whether each segment is a blend, which leaves the geodesic path.
+  std::vector<bool> mIsBlend;
+
+  /// Whether the path stops at each knot.
+  std::vector<bool> mIsStop;
+};
+
+//==============================================================================
+/// Creates the path that follows the geodesics between the waypoints, and
+/// turns at each waypoint along a quadratic blend that stays within
+/// \c _maxDeviation of the geodesics. Waypoints that cannot be blended, e.g.
+/// because \c _maxDeviation is zero, are stops. The path is parameterized by
+/// arc length along the geodesics.
+Path createPath(
+    const std::vector<Eigen::VectorXd>& _positions, double _maxDeviation)
+{
+  const std::size_t numWaypoints = _positions.size();
+  const auto dimension = _positions.front().size();
+
+  std::vector<double> lengths(numWaypoints - 1);
+  std::vector<Eigen::VectorXd> directions(numWaypoints - 1);
+  for (std::size_t k = 0; k + 1 < numWaypoints; ++k)
+  {
+    const Eigen::VectorXd difference = _positions[k + 1] - _positions[k];
+    lengths[k] = difference.norm();
+    directions[k] = difference / lengths[k];
+  }
+
+  // A blend at waypoint k starts radius[k] before it on the incoming geodesic
+  // and ends radius[k] after it on the outgoing one. As a quadratic Bezier
+  // curve with the waypoint as its control point, its farthest point from the
+  // waypoint, and from the geodesics, is radius[k] * change / 4 away, where
+  // change is the norm of the change of direction. Neighboring blends may use
+  // at most half of the geodesic between them.
+  std::vector<double> radius(numWaypoints, 0.);
+  std::vector<bool> isStop(numWaypoints, false);
+  for (std::size_t k = 1; k + 1 < numWaypoints; ++k)
+  {
+    const double change = (directions[k] - directions[k - 1]).norm();
+    if (change < kMinDirectionChange)
+      continue;
+
+    radius[k] = std::min(
+        4. * _maxDeviation / change,
+        0.5 * std::min(lengths[k - 1], lengths[k]));
+    if (radius[k] < kMinWaypointDistance)
+    {
+      radius[k] = 0.;
+      isStop[k] = true;
+    }
+  }
+
+  Path path;
+  path.mKnots.push_back(0.);
+  path.mIsStop.push_back(false);
+
+  const auto addSegment = [&](
+      const Eigen::VectorXd& _position,
+      const Eigen::VectorXd& _firstDerivative,
+      const Eigen::VectorXd& _secondDerivative,
+      double _length,
+      bool _isBlend,
+      bool _isStopAtEnd) {
+    Eigen::MatrixXd coefficients(dimension, 3);
+    coefficients.col(0) = _position;
+    coefficients.col(1) = _firstDerivative;
+    coefficients.col(2) = 0.5 * _secondDerivative;
+
+    path.mKnots.push_back(path.mKnots.back() + _length);
+    path.mCoefficients.push_back(std::move(coefficients));
+    path.mIsBlend.push_back(_isBlend);
+    path.mIsStop.push_back(_isStopAtEnd);
+  };
+
+  const Eigen::VectorXd zero = Eigen::VectorXd::Zero(dimension);
+  for (std::size_t k = 0; k + 1 < numWaypoints; ++k)
+  {
+    const double length = lengths[k] - radius[k] - radius[k + 1];
+    if (length > kMinWaypointDistance)
+    {
+      addSegment(
+          _positions[k] + radius[k] * directions[k],
+          directions[k],
+          zero,
+          length,
+          false,
+          isStop[k + 1]);
+    }
+
+    if (radius[k + 1] > 0.)
+    {
+      // The blend has length 2 * radius[k + 1] in the path parameter, so its
+      // first derivative matches the unit directions at both ends.
+      const double r = radius[k + 1];
+      const double blendLength = 2. * r;
+      addSegment(
+          _positions[k + 1] - r * directions[k],
+          directions[k],
+          2. * r * (directions[k + 1] - directions[k])
+              / (blendLength * blendLength),
+          blendLength,
+          true,
+          false);
+    }
+  }
+
+  return path;
+}
+
+//==============================================================================
+/// Returns whether the blends of \c _path satisfy \c _constraint at points
+/// that are at most \c _resolution apart along them, including their ends.
+bool isBlendFeasible(
+    const Path& _path,
+    const StateSpace& _stateSpace,
+    const Testable& _constraint,
+    double _resolution)
+{
+  auto state = _stateSpace.createState();
+  Eigen::VectorXd position;
+
+  for (std::size_t k = 0; k < _path.mCoefficients.size(); ++k)
+  {
+    if (!_path.mIsBlend[k])
+      continue;
+
+    const auto& c = _path.mCoefficients[k];
+    const double length = _path.mKnots[k + 1] - _path.mKnots[k];
+    const auto numSteps = std::max<std::size_t>(
+        1, static_cast<std::size_t>(std::ceil(length / _resolution)));
+
+    for (std::size_t istep = 0; istep <= numSteps; ++istep)
+    {
+      const double sigma = length * istep / numSteps;
+      position = c.col(0) + sigma * (c.col(1) + sigma * c.col(2));
+      _stateSpace.expMap(position, state);
+      if (!_constraint.isSatisfied(state))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+/// Point of the discretization grid along the path.
+struct GridPoint
+{
+  /// Path parameter.
+  double mS;
+
+  /// Index of the path segment that starts at or before mS.
+  std::size_t mSegment;
+
+  /// First derivative of the path with respect to s.
+  Eigen::VectorXd mFirstDerivative;
+
+  /// Second derivative of the path with respect to s.
+  Eigen::VectorXd mSecondDerivative;
+
+  /// First derivative of segment mSegment at the next grid point, which may
+  /// differ from the one of the next grid point when it starts a new segment.
+  Eigen::VectorXd mNextFirstDerivative;
+
+  /// Second derivative of segment mSegment at the next grid point.
+  Eigen::VectorXd mNextSecondDerivative;
+
+  /// Bound on the squared path velocity imposed by the velocity limits.
+  double mMaxSquaredVelocity;
+};
+
+//==============================================================================
+std::vector<GridPoint> createGrid(
+    const Path& _path,
+    const Eigen::VectorXd& _maxVelocity,
+    double _gridResolution)
+{
+  std::vector<GridPoint> grid;
+
+  const auto addGridPoint = [&](std::size_t _segment, double _s, double _next) {
+    const auto& c = _path.mCoefficients[_segment];
+    const double sigma = _s - _path.mKnots[_segment];
+    const double nextSigma = _next - _path.mKnots[_segment];
+
+    GridPoint point;
+    point.mS = _s;
+    point.mSegment = _segment;
+    point.mFirstDerivative = c.col(1) + sigma * 2. * c.col(2);
+    point.mSecondDerivative = 2. * c.col(2);
+    point.mNextFirstDerivative = c.col(1) + nextSigma * 2. * c.col(2);
+    point.mNextSecondDerivative = point.mSecondDerivative;
+
+    point.mMaxSquaredVelocity = kMaxSquaredPathVelocity;
+    for (int j = 0; j < _maxVelocity.size(); ++j)
+    {
+      const double dq = std::abs(point.mFirstDerivative[j]);
+      if (dq > 0.)
+      {
+        point.mMaxSquaredVelocity = std::min(
+            point.mMaxSquaredVelocity,
+            (_maxVelocity[j] / dq) * (_maxVelocity[j] / dq));
+      }
+    }
+
+    grid.push_back(std::move(point));
+  };
+
+  // Every segment gets at least two grid intervals, so that the path velocity
+  // is nonzero somewhere inside it even if it starts and ends at rest.
+  const std::size_t numSegments = _path.mCoefficients.size();
+  for (std::size_t k = 0; k < numSegments; ++k)
+  {
+    const double start = _path.mKnots[k];
+    const double length = _path.mKnots[k + 1] - start;
+    const auto numSteps = std::max<std::size_t>(
+        2, static_cast<std::size_t>(std::ceil(length / _gridResolution)));
+
+    for (std::size_t istep = 0; istep < numSteps; ++istep)
+    {
+      addGridPoint(
+          k,
+          start + length * istep / numSteps,
+          start + length * (istep + 1) / numSteps);
+    }
+
+    if (_path.mIsStop[k])
+      grid[grid.size() - numSteps].mMaxSquaredVelocity = 0.;
+  }
+  addGridPoint(numSegments - 1, _path.mKnots.back(), _path.mKnots.back());
+
+  return grid;
+}
+
+/// Computes the range of x over the polygon {(x, u) : A [x u]^T <= b} by
+/// enumerating its vertices. Returns false if the polygon is empty.
+bool computeRange(
+    const Eigen::Matrix<double, Eigen::Dynamic, 2>& _A,
+    const Eigen::VectorXd& _b,
+    double& _lower,
+    double& _upper)
+{
+  _lower = std::numeric_limits<double>::infinity();
+  _upper = -std::numeric_limits<double>::infinity();
+
+  const auto numRows = _A.rows();
+  for (int i = 0; i < numRows; ++i)
+  {
+    for (int j = i + 1; j < numRows; ++j)
+    {
+      const double det = _A(i, 0) * _A(j, 1) - _A(i, 1) * _A(j, 0);
+      if (std::abs(det) < 1e-12)
+        continue;
+
+      const Eigen::Vector2d vertex(
+          (_b[i] * _A(j, 1) - _A(i, 1) * _b[j]) / det,
+          (_A(i, 0) * _b[j] - _b[i] * _A(j, 0)) / det);
+
+      bool isFeasible = true;
+      for (int k = 0; k < numRows && isFeasible; ++k)
+      {
+        isFeasible = _A.row(k).dot(vertex)
+                     <= _b[k] + kFeasibilityTolerance * (1. + std::abs(_b[k]));
+      }
+
+      if (isFeasible)
+      {
+        _lower = std::min(_lower, vertex[0]);
+        _upper = std::max(_upper, vertex[0]);
+      }
+    }
+  }
+
+  return _lower <= _upper;
+}
+
+//==============================================================================
+std::unique_ptr<aikido::trajectory::Spline> computeToppraTiming(
+    ConstStateSpacePtr _stateSpace,
+    double _startTime,
+    const std::vector<Eigen::VectorXd>& _positions,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    double _gridResolution,
+    double _maxDeviation,
+    const Testable* _constraint)
+{
+  if (_positions.size() < 2)
+    throw std::invalid_argument(
+        "Trajectory must contain at least two distinct waypoints.");
+
+  const auto dimension = _maxVelocity.size();
+  auto path = createPath(_positions, _maxDeviation);
+
+  // The geodesics between the waypoints are assumed to be feasible, but the
+  // blends are not, so fall back to stopping at every corner if they fail.
+  if (_constraint
+      && !isBlendFeasible(path, *_stateSpace, *_constraint, _gridResolution))
+    path = createPath(_positions, 0.);
+
+  const auto grid = createGrid(path, _maxVelocity, _gridResolution);
+  const std::size_t numIntervals = grid.size() - 1;
+
+  // Each grid interval has a constant path acceleration u, so the squared
+  // path velocity x satisfies x[i + 1] = x[i] + 2 * delta[i] * u[i].
+  std::vector<double> delta(numIntervals);
+  for (std::size_t i = 0; i < numIntervals; ++i)
+    delta[i] = grid[i + 1].mS - grid[i].mS;
+
+  // Backward pass: compute the controllable sets [lower[i], upper[i]] of
+  // squared path velocities from which the end of the path can be reached at
+  // rest.
+  std::vector<double> lower(grid.size(), 0.);
+  std::vector<double> upper(grid.size(), 0.);
+
+  // The acceleration limits are enforced at both ends of every interval
+  // (the "interpolation" discretization of TOPP-RA), which bounds the
+  // violation in between much better than only enforcing them at the start.
+  Eigen::Matrix<double, Eigen::Dynamic, 2> A(4 * dimension + 4, 2);
+  Eigen::VectorXd b(4 * dimension + 4);
+
+  for (std::size_t i = numIntervals; i-- > 0;)
+  {
+    const auto& point = grid[i];
+
+    for (int j = 0; j < dimension; ++j)
+    {
+      A.row(4 * j) << point.mSecondDerivative[j], point.mFirstDerivative[j];
+      A.row(4 * j + 1) << point.mNextSecondDerivative[j],
+          2. * delta[i] * point.mNextSecondDerivative[j]
+              + point.mNextFirstDerivative[j];
+      A.row(4 * j + 2) = -A.row(4 * j);
+      A.row(4 * j + 3) = -A.row(4 * j + 1);
+      b.segment<4>(4 * j).setConstant(_maxAcceleration[j]);
+    }
+
+    A.row(4 * dimension) << -1., 0.;
+    b[4 * dimension] = 0.;
+    A.row(4 * dimension + 1) << 1., 0.;
+    b[4 * dimension + 1] = point.mMaxSquaredVelocity;
+    A.row(4 * dimension + 2) << 1., 2. * delta[i];
+    b[4 * dimension + 2] = upper[i + 1];
+    A.row(4 * dimension + 3) << -1., -2. * delta[i];
+    b[4 * dimension + 3] = -lower[i + 1];
+
+    if (!computeRange(A, b, lower[i], upper[i]))
+      throw std::runtime_error(
+          "No timing of the path satisfies the velocity and acceleration "
+          "limits.");
+
+    lower[i] = std::max(lower[i], 0.);
+  }
+
+  if (lower[0] > kFeasibilityTolerance)
+    throw std::runtime_error(
+        "No timing of the path starts at rest and satisfies the velocity and "
+        "acceleration limits.");
+
+  // Forward pass: greedily pick the largest path acceleration that keeps the
+  // next squared path velocity in its controllable set.
+  std::vector<double> squaredVelocities(grid.size(), 0.);
+  for (std::size_t i = 0; i < numIntervals; ++i)
+  {
+    const auto& point = grid[i];
+    const double x = squaredVelocities[i];
+
+    double maxU = (upper[i + 1] - x) / (2. * delta[i]);
+    const double minU = (lower[i + 1] - x) / (2. * delta[i]);
+
+    // Upper bound on u from -a <= ddq x' + dq u <= a, with x' = x + k u.
+    const auto limitU = [&](double _ddq, double _dq, double _k, double _a) {
+      const double slope = _ddq * _k + _dq;
+      if (std::abs(slope) < 1e-12)
+        return;
+
+      const double bound1 = (_a - _ddq * x) / slope;
+      const double bound2 = (-_a - _ddq * x) / slope;
+      maxU = std::min(maxU, std::max(bound1, bound2));
+    };
+
+    for (int j = 0; j < dimension; ++j)
+    {
+      limitU(
+          point.mSecondDerivative[j],
+          point.mFirstDerivative[j],
+          0.,
+          _maxAcceleration[j]);
+      limitU(
+          point.mNextSecondDerivative[j],
+          point.mNextFirstDerivative[j],
+          2. * delta[i],
+          _maxAcceleration[j]);
+    }
+
+    const double u = std::max(maxU, minU);
+    squaredVelocities[i + 1]
+        = std::min(upper[i + 1], std::max(0., x + 2. * delta[i] * u));
+  }
+
+  // Compose the quadratic path with the quadratic path parameter of each grid
+  // interval to get fourth-order polynomials in time.
+  auto outputTrajectory
+      = make_unique<aikido::trajectory::Spline>(_stateSpace, _startTime);
+  auto segmentStartState = _stateSpace->createState();
+
+  Eigen::MatrixXd coefficients(dimension, 5);
+  Eigen::Matrix<double, 1, 5> power;
+  Eigen::Matrix<double, 1, 5> nextPower;
+
+  for (std::size_t i = 0; i < numIntervals; ++i)
+  {
+    const auto& point = grid[i];
+    const double velocity0 = std::sqrt(squaredVelocities[i]);
+    const double velocity1 = std::sqrt(squaredVelocities[i + 1]);
+
+    if (velocity0 + velocity1 <= 0.)
+      throw std::runtime_error(
+          "No timing of the path satisfies the velocity and acceleration "
+          "limits.");
+
+    const double duration = 2. * delta[i] / (velocity0 + velocity1);
+    const double acceleration
+        = (squaredVelocities[i + 1] - squaredVelocities[i]) / (2. * delta[i]);
+
+    // sigma(t) = p0 + p1 t + p2 t^2 is the offset into the path segment.
+    const double p0 = point.mS - path.mKnots[point.mSegment];
+    const double p1 = velocity0;
+    const double p2 = 0.5 * acceleration;
+    const auto& pathCoefficients = path.mCoefficients[point.mSegment];
+
+    coefficients.setZero();
+    power.setZero();
+    power[0] = 1.;
+    for (int m = 0; m < 3; ++m)
+    {
+      coefficients += pathCoefficients.col(m) * power;
+
+      nextPower.setZero();
+      for (int n = 0; n + 2 < 5; ++n)
+      {
+        nextPower[n] += p0 * power[n];
+        nextPower[n + 1] += p1 * power[n];
+        nextPower[n + 2] += p2 * power[n];
+      }
+      power = nextPower;
+    }
+
+    // Polynomials are defined in the tangent space of the segment start.
+    _stateSpace->expMap(coefficients.col(0), segmentStartState);
+    coefficients.col(0).setZero();
+
+    outputTrajectory->addSegment(coefficients, duration, segmentStartState);
+  }
+
+  return outputTrajectory;
+}
+
+} // namespace
+
+//==============================================================================
+std::unique_ptr<aikido::trajectory::Spline> computeToppraTiming(
+    const aikido::trajectory::Interpolated& _inputTrajectory,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    double _gridResolution,
+    double _maxDeviation,
+    const aikido::constraint::Testable* _constraint)
+{
+  const auto stateSpace = _inputTrajectory.getStateSpace();
+  checkInputs(
+      *stateSpace,
+      _maxVelocity,
+      _maxAcceleration,
+      _gridResolution,
+      _maxDeviation);
+
+  if (_inputTrajectory.getNumWaypoints() == 0)
+    throw std::invalid_argument("Trajectory is empty.");
+
+  WaypointCollector collector(stateSpace);
+  for (std::size_t i = 0; i < _inputTrajectory.getNumWaypoints(); ++i)
+    collector.add(_inputTrajectory.getWaypoint(i));
+
+  return computeToppraTiming(
+      stateSpace,
+      _inputTrajectory.getStartTime(),
+      collector.getPositions(),
+      _maxVelocity,
+      _maxAcceleration,
+      _gridResolution,
+      _maxDeviation,
+      _constraint);
+}
+
+//==============================================================================
+std::unique_ptr<aikido::trajectory::Spline> computeToppraTiming(
+    const aikido::trajectory::Spline& _inputTrajectory,
+    const Eigen::VectorXd& _maxVelocity,
+    const Eigen::VectorXd& _maxAcceleration,
+    double _gridResolution,
+    double _maxDeviation,
+    const aikido::constraint::Testable* _constraint)
+{
+  const auto stateSpace = _inputTrajectory.getStateSpace();
+  checkInputs(
+      *stateSpace,
+      _maxVelocity,
+      _maxAcceleration,
+      _gridResolution,
+      _maxDeviation);
+
+  if (_inputTrajectory.getNumSegments() == 0)
+    throw std::invalid_argument("Trajectory is empty.");
+
+  WaypointCollector collector(stateSpace);
+  _inputTrajectory.visitWaypoints(
+      [&](std::size_t /*index*/,
+          double /*time*/,
+          const StateSpace::State* state,
+          const Eigen::VectorXd& /*velocity*/) { collector.add(state); });
+
+  return computeToppraTiming(
+      stateSpace,
+      _inputTrajectory.getStartTime(),
+      collector.getPositions(),
+      _maxVelocity,
+      _maxAcceleration,
+      _gridResolution,
+      _maxDeviation,
+      _constraint);
+}
+
+//==============================================================================
+ToppraTimer::ToppraTimer(
+    const Eigen::VectorXd& _velocityLimits,
+    const Eigen::VectorXd& _accelerationLimits,
+    double _gridResolution,
+    double _maxDeviation)
+  : mVelocityLimits{_velocityLimits}
+  , mAccelerationLimits{_accelerationLimits}
+  , mGridResolution{_gridResolution}
+  , mMaxDeviation{_maxDeviation}
+{
+  // Do nothing
+}
+
+//==============================================================================
+std::unique_ptr<aikido::trajectory::Spline> ToppraTimer::postprocess(
+    const aikido::trajectory::Interpolated& _inputTraj,
+    const aikido::common::RNG& /*_rng*/,
+    const aikido::constraint::TestablePtr& _constraint)
+{
+  return computeToppraTiming(
+      _inputTraj,
+      mVelocityLimits,
+      mAccelerationLimits,
+      mGridResolution,
+      mMaxDeviation,
+      _constraint.get());
+}
+
+//==============================================================================
+std::unique_ptr<aikido::trajectory::Spline> ToppraTimer::postprocess(
+    const aikido::trajectory::Spline& _inputTraj,
+    const aikido::common::RNG& /*_rng*/,
+    const aikido::constraint::TestablePtr& _constraint)
+{
+  return computeToppraTiming(
+      _inputTraj,
+      mVelocityLimits,
+      mAccelerationLimits,
+      mGridResolution,
+      mMaxDeviation,
+      _constraint.get());
+}
+
+} // namespace toppra
+} // namespace planner
+} // namespace aikido
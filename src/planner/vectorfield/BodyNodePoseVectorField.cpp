@@ -1,6 +1,8 @@
 #include <aikido/common/StepSequence.hpp>
 #include <aikido/planner/vectorfield/BodyNodePoseVectorField.hpp>
 #include <aikido/planner/vectorfield/VectorFieldUtil.hpp>
+#include <aikido/trajectory/Spline.hpp>
+#include <aikido/trajectory/SplineCursor.hpp>
 #include "detail/VectorFieldPlannerExceptions.hpp"
 
 namespace aikido {
@@ -32,6 +34,8 @@ BodyNodePoseVectorField::BodyNodePoseVectorField(
     throw std::invalid_argument("Joint limit padding must be non-negative.");
   }
 
+  mPositionLowerLimits = mMetaSkeleton->getPositionLowerLimits();
+  mPositionUpperLimits = mMetaSkeleton->getPositionUpperLimits();
   mVelocityLowerLimits = mMetaSkeleton->getVelocityLowerLimits();
   mVelocityUpperLimits = mMetaSkeleton->getVelocityUpperLimits();
 }
@@ -46,13 +50,7 @@ bool BodyNodePoseVectorField::evaluateVelocity(
   using Eigen::Vector6d;
   using aikido::planner::vectorfield::computeJointVelocityFromTwist;
 
-  Eigen::VectorXd position(mMetaSkeleton->getNumDofs());
-  auto newState
-      = static_cast<const aikido::statespace::CartesianProduct::State*>(state);
-  mMetaSkeletonStateSpace->convertStateToPositions(newState, position);
-  mMetaSkeleton->setPositions(position);
-
-  const Isometry3d currentPose = mBodyNode->getTransform();
+  const Isometry3d& currentPose = computeBodyNodePose(state);
 
   Vector6d desiredTwist = Eigen::Vector6d::Zero();
   if (!evaluateCartesianVelocity(currentPose, desiredTwist))
@@ -63,13 +61,16 @@ bool BodyNodePoseVectorField::evaluateVelocity(
   bool result = computeJointVelocityFromTwist(
       qd,
       desiredTwist,
-      mMetaSkeleton,
-      mBodyNode,
+      computeBodyNodeJacobian(),
+      mKinematicsCache.mPositions,
+      mPositionLowerLimits,
+      mPositionUpperLimits,
       mJointLimitPadding,
       mVelocityLowerLimits,
       mVelocityUpperLimits,
       mEnforceJointVelocityLimits,
-      mMaxStepSize);
+      mMaxStepSize,
+      mJointVelocitySolver);
   return result;
 }
 
@@ -79,13 +80,7 @@ VectorFieldPlannerStatus BodyNodePoseVectorField::evaluateStatus(
 {
   using Eigen::Isometry3d;
 
-  Eigen::VectorXd position(mMetaSkeleton->getNumDofs());
-  auto newState = static_cast<const aikido::statespace::dart::
-                                  MetaSkeletonStateSpace::State*>(state);
-  mMetaSkeletonStateSpace->convertStateToPositions(newState, position);
-  mMetaSkeleton->setPositions(position);
-
-  const Isometry3d currentPose = mBodyNode->getTransform();
+  const Isometry3d& currentPose = computeBodyNodePose(state);
 
   return evaluateCartesianStatus(currentPose);
 }
@@ -111,9 +106,28 @@ bool BodyNodePoseVectorField::evaluateTrajectory(
       evalTimePivot,
       trajectory.getEndTime());
 
+  // The samples are increasing, so a cursor finds the segment of each one in
+  // constant time. The cursor is kept across calls to reuse its workspace.
+  const auto spline
+      = dynamic_cast<const aikido::trajectory::Spline*>(&trajectory);
+  aikido::trajectory::SplineCursor* cursor = nullptr;
+  if (spline && spline->getStateSpace() == mMetaSkeletonStateSpace)
+  {
+    if (mSplineCursor)
+      mSplineCursor->reset(*spline);
+    else
+      mSplineCursor
+          = dart::common::make_unique<aikido::trajectory::SplineCursor>(
+              *spline);
+    cursor = mSplineCursor.get();
+  }
+
   for (double t : seq)
   {
-    trajectory.evaluate(t, state);
+    if (cursor)
+      cursor->evaluate(t, state);
+    else
+      trajectory.evaluate(t, state);
     // update current evaluation time pivot
     evalTimePivot = t;
     if (!constraint->isSatisfied(state))
@@ -164,6 +178,52 @@ dart::dynamics::ConstBodyNodePtr BodyNodePoseVectorField::getBodyNode() const
   return mBodyNode;
 }
 
+//==============================================================================
+const Eigen::Isometry3d& BodyNodePoseVectorField::computeBodyNodePose(
+    const aikido::statespace::StateSpace::State* state) const
+{
+  auto newState = static_cast<const aikido::statespace::dart::
+                                  MetaSkeletonStateSpace::State*>(state);
+  mMetaSkeletonStateSpace->convertStateToPositions(newState, mPositions);
+
+  KinematicsCache& cache = mKinematicsCache;
+  if (cache.mHasPose && cache.mPositions == mPositions)
+  {
+    return cache.mPose;
+  }
+
+  mMetaSkeleton->setPositions(mPositions);
+  cache.mPositions = mPositions;
+  cache.mPose = mBodyNode->getTransform();
+  cache.mHasPose = true;
+  cache.mHasJacobian = false;
+  return cache.mPose;
+}
+
+//==============================================================================
+const dart::math::Jacobian& BodyNodePoseVectorField::computeBodyNodeJacobian()
+    const
+{
+  KinematicsCache& cache = mKinematicsCache;
+  if (!cache.mHasPose)
+  {
+    throw std::logic_error(
+        "computeBodyNodePose() must be called before the Jacobian.");
+  }
+
+  if (!cache.mHasJacobian)
+  {
+    // Constraint checks may have moved the MetaSkeleton since the pose was
+    // computed.
+    if (mMetaSkeleton->getPositions() != cache.mPositions)
+      mMetaSkeleton->setPositions(cache.mPositions);
+
+    cache.mJacobian = mMetaSkeleton->getWorldJacobian(mBodyNode);
+    cache.mHasJacobian = true;
+  }
+  return cache.mJacobian;
+}
+
 } // namespace vectorfield
 } // namespace planner
 } // namespace aikido
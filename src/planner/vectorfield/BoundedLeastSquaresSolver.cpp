@@ -0,0 +1,194 @@
+#include <aikido/planner/vectorfield/BoundedLeastSquaresSolver.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace aikido {
+namespace planner {
+namespace vectorfield {
+
+//==============================================================================
+BoundedLeastSquaresSolver::BoundedLeastSquaresSolver(double damping)
+  : mDamping(damping)
+{
+  if (mDamping <= 0.0)
+  {
+    throw std::invalid_argument("Damping must be positive.");
+  }
+}
+
+//==============================================================================
+bool BoundedLeastSquaresSolver::solve(
+    const Eigen::Ref<const Eigen::MatrixXd>& A,
+    const Eigen::Ref<const Eigen::VectorXd>& b,
+    const Eigen::Ref<const Eigen::VectorXd>& lower,
+    const Eigen::Ref<const Eigen::VectorXd>& upper,
+    Eigen::VectorXd& x)
+{
+  const Eigen::Index numVariables = A.cols();
+
+  if (b.size() != A.rows())
+  {
+    throw std::invalid_argument("Target vector has wrong dimension.");
+  }
+  if (lower.size() != numVariables || upper.size() != numVariables)
+  {
+    throw std::invalid_argument("Bounds have wrong dimension.");
+  }
+  if ((lower.array() > upper.array()).any())
+  {
+    throw std::invalid_argument("Lower bounds exceed upper bounds.");
+  }
+
+  mNormalMatrix.noalias() = A.transpose() * A;
+  mNormalMatrix.diagonal().array() += mDamping * mDamping;
+  mNormalVector.noalias() = A.transpose() * b;
+
+  // Start from the feasible point closest to the origin, with every variable
+  // that can move free.
+  x.resize(numVariables);
+  mBounds.resize(numVariables);
+  for (Eigen::Index i = 0; i < numVariables; ++i)
+  {
+    x[i] = std::min(std::max(0.0, lower[i]), upper[i]);
+    mBounds[i] = (lower[i] == upper[i]) ? Bound::LOWER : Bound::NONE;
+  }
+
+  const double tolerance
+      = 1e-10 * std::max(1.0, mNormalVector.lpNorm<Eigen::Infinity>());
+
+  // Each iteration either clamps a variable or releases one. A release is
+  // always followed by progress on a strictly convex problem, so this limit
+  // is only reached due to round-off.
+  const int maxIterations = 10 * (numVariables + 1);
+  for (int iteration = 0; iteration < maxIterations; ++iteration)
+  {
+    solveFree(x);
+
+    // Step towards the solution over the free variables, stopping at the
+    // first bound in the way.
+    double stepLength = 1.0;
+    Eigen::Index blocking = -1;
+    Bound blockingBound = Bound::NONE;
+    for (std::size_t j = 0; j < mFree.size(); ++j)
+    {
+      const Eigen::Index i = mFree[j];
+      const double target = mFreeSolution[j];
+      double length = 1.0;
+      Bound bound = Bound::NONE;
+      if (target < lower[i])
+      {
+        length = (lower[i] - x[i]) / (target - x[i]);
+        bound = Bound::LOWER;
+      }
+      else if (target > upper[i])
+      {
+        length = (upper[i] - x[i]) / (target - x[i]);
+        bound = Bound::UPPER;
+      }
+
+      if (bound != Bound::NONE && length < stepLength)
+      {
+        stepLength = std::max(0.0, length);
+        blocking = i;
+        blockingBound = bound;
+      }
+    }
+
+    for (std::size_t j = 0; j < mFree.size(); ++j)
+    {
+      const Eigen::Index i = mFree[j];
+      x[i] += stepLength * (mFreeSolution[j] - x[i]);
+      x[i] = std::min(std::max(x[i], lower[i]), upper[i]);
+    }
+
+    if (blocking >= 0)
+    {
+      x[blocking]
+          = (blockingBound == Bound::LOWER) ? lower[blocking] : upper[blocking];
+      mBounds[blocking] = blockingBound;
+      continue;
+    }
+
+    // The free variables are optimal. Release the clamped variable whose
+    // gradient points into the box the most, if any.
+    mGradient.noalias() = mNormalMatrix * x;
+    mGradient -= mNormalVector;
+
+    Eigen::Index released = -1;
+    double maxViolation = tolerance;
+    for (Eigen::Index i = 0; i < numVariables; ++i)
+    {
+      if (mBounds[i] == Bound::NONE || lower[i] == upper[i])
+        continue;
+
+      const double violation
+          = (mBounds[i] == Bound::LOWER) ? -mGradient[i] : mGradient[i];
+      if (violation > maxViolation)
+      {
+        maxViolation = violation;
+        released = i;
+      }
+    }
+
+    if (released < 0)
+    {
+      return x.allFinite();
+    }
+    mBounds[released] = Bound::NONE;
+  }
+
+  return false;
+}
+
+//==============================================================================
+double BoundedLeastSquaresSolver::getDamping() const
+{
+  return mDamping;
+}
+
+//==============================================================================
+void BoundedLeastSquaresSolver::solveFree(const Eigen::VectorXd& x)
+{
+  const Eigen::Index numVariables = x.size();
+
+  mFree.clear();
+  for (Eigen::Index i = 0; i < numVariables; ++i)
+  {
+    if (mBounds[i] == Bound::NONE)
+      mFree.push_back(i);
+  }
+
+  const auto numFree = static_cast<Eigen::Index>(mFree.size());
+  mFreeMatrix.resize(numFree, numFree);
+  mFreeVector.resize(numFree);
+  for (Eigen::Index j = 0; j < numFree; ++j)
+  {
+    const Eigen::Index row = mFree[j];
+
+    // Move the contribution of the clamped variables to the right-hand side.
+    mFreeVector[j] = mNormalVector[row];
+    for (Eigen::Index i = 0; i < numVariables; ++i)
+    {
+      if (mBounds[i] != Bound::NONE)
+        mFreeVector[j] -= mNormalMatrix(row, i) * x[i];
+    }
+
+    for (Eigen::Index k = 0; k < numFree; ++k)
+      mFreeMatrix(j, k) = mNormalMatrix(row, mFree[k]);
+  }
+
+  if (numFree == 0)
+  {
+    mFreeSolution.resize(0);
+    return;
+  }
+
+  mFreeDecomposition.compute(mFreeMatrix);
+  mFreeSolution = mFreeDecomposition.solve(mFreeVector);
+}
+
+} // namespace vectorfield
+} // namespace planner
+} // namespace aikido
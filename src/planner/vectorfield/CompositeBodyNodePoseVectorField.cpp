@@ -0,0 +1,234 @@
+#include <aikido/planner/vectorfield/CompositeBodyNodePoseVectorField.hpp>
+
+#include <stdexcept>
+#include <aikido/planner/vectorfield/VectorFieldUtil.hpp>
+
+namespace aikido {
+namespace planner {
+namespace vectorfield {
+
+namespace {
+
+//==============================================================================
+BodyNodePoseVectorField& getFirst(
+    const std::vector<BodyNodePoseVectorFieldPtr>& vectorFields)
+{
+  if (vectorFields.empty())
+    throw std::invalid_argument("No vector fields given.");
+  if (!vectorFields.front())
+    throw std::invalid_argument("Vector field is nullptr.");
+  return *vectorFields.front();
+}
+
+} // namespace
+
+//==============================================================================
+CompositeBodyNodePoseVectorField::CompositeBodyNodePoseVectorField(
+    std::vector<BodyNodePoseVectorFieldPtr> vectorFields,
+    double maxStepSize,
+    double jointLimitPadding,
+    bool enforceJointVelocityLimits)
+  : VectorField(getFirst(vectorFields).getStateSpace())
+  , mVectorFields(std::move(vectorFields))
+  , mMetaSkeletonStateSpace(mVectorFields.front()->getMetaSkeletonStateSpace())
+  , mMetaSkeleton(mVectorFields.front()->getMetaSkeleton())
+  , mMaxStepSize(maxStepSize)
+  , mJointLimitPadding(jointLimitPadding)
+  , mEnforceJointVelocityLimits(enforceJointVelocityLimits)
+  , mHasPoses(false)
+{
+  if (mMaxStepSize <= 0)
+  {
+    throw std::invalid_argument("Maximum step size must be positive.");
+  }
+  if (mJointLimitPadding < 0)
+  {
+    throw std::invalid_argument("Joint limit padding must be non-negative.");
+  }
+
+  for (const auto& vectorField : mVectorFields)
+  {
+    if (!vectorField)
+    {
+      throw std::invalid_argument("Vector field is nullptr.");
+    }
+    if (vectorField->getMetaSkeleton() != mMetaSkeleton
+        || vectorField->getMetaSkeletonStateSpace() != mMetaSkeletonStateSpace)
+    {
+      throw std::invalid_argument(
+          "Vector fields must share the same MetaSkeleton and state space.");
+    }
+  }
+
+  mPositionLowerLimits = mMetaSkeleton->getPositionLowerLimits();
+  mPositionUpperLimits = mMetaSkeleton->getPositionUpperLimits();
+  mVelocityLowerLimits = mMetaSkeleton->getVelocityLowerLimits();
+  mVelocityUpperLimits = mMetaSkeleton->getVelocityUpperLimits();
+  mPoses.resize(mVectorFields.size());
+  mStatuses.resize(mVectorFields.size());
+}
+
+//==============================================================================
+bool CompositeBodyNodePoseVectorField::evaluateVelocity(
+    const aikido::statespace::StateSpace::State* state,
+    Eigen::VectorXd& qd) const
+{
+  computeBodyNodePoses(state);
+  const bool isWaiting = computeComponentStatuses();
+
+  const auto numRows = static_cast<Eigen::Index>(6 * mVectorFields.size());
+  mDesiredTwists.resize(numRows);
+  mJacobians.resize(numRows, mMetaSkeleton->getNumDofs());
+
+  Eigen::Vector6d desiredTwist;
+  for (std::size_t i = 0; i < mVectorFields.size(); ++i)
+  {
+    const auto& vectorField = mVectorFields[i];
+    if (isHeld(mStatuses[i], isWaiting))
+    {
+      desiredTwist.setZero();
+    }
+    else if (!vectorField->evaluateCartesianVelocity(mPoses[i], desiredTwist))
+    {
+      return false;
+    }
+
+    const auto row = static_cast<Eigen::Index>(6 * i);
+    mDesiredTwists.segment<6>(row) = desiredTwist;
+    mJacobians.middleRows<6>(row)
+        = mMetaSkeleton->getWorldJacobian(vectorField->getBodyNode());
+  }
+
+  return computeJointVelocityFromTwist(
+      qd,
+      mDesiredTwists,
+      mJacobians,
+      mPositions,
+      mPositionLowerLimits,
+      mPositionUpperLimits,
+      mJointLimitPadding,
+      mVelocityLowerLimits,
+      mVelocityUpperLimits,
+      mEnforceJointVelocityLimits,
+      mMaxStepSize,
+      mJointVelocitySolver);
+}
+
+//==============================================================================
+VectorFieldPlannerStatus CompositeBodyNodePoseVectorField::evaluateStatus(
+    const aikido::statespace::StateSpace::State* state) const
+{
+  computeBodyNodePoses(state);
+  computeComponentStatuses();
+
+  bool allCache = true;
+  bool allTerminate = true;
+  for (const auto status : mStatuses)
+  {
+    switch (status)
+    {
+      case VectorFieldPlannerStatus::TERMINATE:
+        return VectorFieldPlannerStatus::TERMINATE;
+      case VectorFieldPlannerStatus::CONTINUE:
+        allCache = false;
+        allTerminate = false;
+        break;
+      case VectorFieldPlannerStatus::CACHE_AND_CONTINUE:
+        allTerminate = false;
+        break;
+      case VectorFieldPlannerStatus::CACHE_AND_TERMINATE:
+        break;
+    }
+  }
+
+  if (allTerminate)
+    return VectorFieldPlannerStatus::CACHE_AND_TERMINATE;
+  if (allCache)
+    return VectorFieldPlannerStatus::CACHE_AND_CONTINUE;
+  return VectorFieldPlannerStatus::CONTINUE;
+}
+
+//==============================================================================
+bool CompositeBodyNodePoseVectorField::evaluateTrajectory(
+    const aikido::trajectory::Trajectory& trajectory,
+    const aikido::constraint::Testable* constraint,
+    double evalStepSize,
+    double& evalTimePivot,
+    bool includeEndTime) const
+{
+  // Checking a trajectory does not depend on the BodyNode.
+  return mVectorFields.front()->evaluateTrajectory(
+      trajectory, constraint, evalStepSize, evalTimePivot, includeEndTime);
+}
+
+//==============================================================================
+std::size_t CompositeBodyNodePoseVectorField::getNumVectorFields() const
+{
+  return mVectorFields.size();
+}
+
+//==============================================================================
+ConstBodyNodePoseVectorFieldPtr
+CompositeBodyNodePoseVectorField::getVectorField(std::size_t index) const
+{
+  return mVectorFields.at(index);
+}
+
+//==============================================================================
+dart::dynamics::ConstMetaSkeletonPtr
+CompositeBodyNodePoseVectorField::getMetaSkeleton() const
+{
+  return mMetaSkeleton;
+}
+
+//==============================================================================
+void CompositeBodyNodePoseVectorField::computeBodyNodePoses(
+    const aikido::statespace::StateSpace::State* state) const
+{
+  auto newState = static_cast<const aikido::statespace::dart::
+                                  MetaSkeletonStateSpace::State*>(state);
+  mMetaSkeletonStateSpace->convertStateToPositions(newState, mPositions);
+
+  // Constraint checks may have moved the MetaSkeleton since the poses were
+  // computed, and the Jacobians are computed from it.
+  if (mMetaSkeleton->getPositions() != mPositions)
+    mMetaSkeleton->setPositions(mPositions);
+
+  if (mHasPoses && mPosePositions == mPositions)
+    return;
+
+  for (std::size_t i = 0; i < mVectorFields.size(); ++i)
+    mPoses[i] = mVectorFields[i]->getBodyNode()->getTransform();
+
+  mPosePositions = mPositions;
+  mHasPoses = true;
+}
+
+//==============================================================================
+bool CompositeBodyNodePoseVectorField::computeComponentStatuses() const
+{
+  bool isWaiting = false;
+  for (std::size_t i = 0; i < mVectorFields.size(); ++i)
+  {
+    mStatuses[i] = mVectorFields[i]->evaluateCartesianStatus(mPoses[i]);
+    if (mStatuses[i] == VectorFieldPlannerStatus::CONTINUE)
+      isWaiting = true;
+  }
+  return isWaiting;
+}
+
+//==============================================================================
+bool CompositeBodyNodePoseVectorField::isHeld(
+    VectorFieldPlannerStatus status, bool isWaiting)
+{
+  // A component that may terminate is done. One that may only cache has
+  // reached its goal region and waits there while others have not, so that
+  // it does not run past the region before the others catch up.
+  if (status == VectorFieldPlannerStatus::CACHE_AND_TERMINATE)
+    return true;
+  return isWaiting && status == VectorFieldPlannerStatus::CACHE_AND_CONTINUE;
+}
+
+} // namespace vectorfield
+} // namespace planner
+} // namespace aikido
@@ -0,0 +1,255 @@
+#include <aikido/planner/vectorfield/VectorFieldStream.hpp>
+
+#include <limits>
+#include <stdexcept>
+#include <dart/common/Console.hpp>
+#include <dart/common/StlHelpers.hpp>
+#include <aikido/common/Spline.hpp>
+#include "detail/VectorFieldIntegrator.hpp"
+#include "detail/VectorFieldPlannerExceptions.hpp"
+
+namespace aikido {
+namespace planner {
+namespace vectorfield {
+
+namespace {
+
+//==============================================================================
+const VectorField& checkNotNull(
+    const std::shared_ptr<const VectorField>& vectorField)
+{
+  if (!vectorField)
+    throw std::invalid_argument("Vector field is nullptr.");
+  return *vectorField;
+}
+
+} // namespace
+
+//==============================================================================
+VectorFieldStream::VectorFieldStream(
+    std::shared_ptr<const VectorField> vectorField,
+    const aikido::statespace::StateSpace::State* startState,
+    aikido::constraint::ConstTestablePtr constraint,
+    double stepSize,
+    double lookAheadTime,
+    double checkConstraintResolution,
+    Method method,
+    double maxTime)
+  : mVectorField(std::move(vectorField))
+  , mConstraint(std::move(constraint))
+  , mStepSize(stepSize)
+  , mLookAheadTime(lookAheadTime)
+  , mConstraintCheckResolution(checkConstraintResolution)
+  , mMethod(method)
+  , mMaxTime(maxTime)
+  , mStarted(false)
+  , mIntegrating(true)
+  , mFailed(false)
+  , mNumFinalKnots(0)
+  , mNumSegments(0)
+  , mEvaluationTimePivot(0.0)
+  , mTime(0.0)
+  , mSegmentStartState(
+        checkNotNull(mVectorField).getStateSpace()->createState())
+{
+  if (!startState)
+    throw std::invalid_argument("Start state is nullptr.");
+  if (!mConstraint)
+    throw std::invalid_argument("Constraint is nullptr.");
+  if (mStepSize <= 0.0)
+    throw std::invalid_argument("Step size must be positive.");
+  if (mLookAheadTime < 0.0)
+    throw std::invalid_argument("Look-ahead time must be non-negative.");
+  if (mConstraintCheckResolution <= 0.0)
+    throw std::invalid_argument("Check resolution must be positive.");
+  if (mMaxTime <= 0.0)
+    throw std::invalid_argument("Maximum time must be positive.");
+
+  const auto stateSpace = mVectorField->getStateSpace();
+
+  // The stream has no overall time limit. Each call to next() does a bounded
+  // amount of work instead.
+  mIntegrator = dart::common::make_unique<detail::VectorFieldIntegrator>(
+      mVectorField.get(),
+      mConstraint.get(),
+      std::numeric_limits<double>::infinity(),
+      mConstraintCheckResolution);
+  mIntegrator->start();
+
+  // The current implementation works only in real vector spaces.
+  mPosition.resize(stateSpace->getDimension());
+  stateSpace->logMap(startState, mPosition);
+}
+
+//==============================================================================
+VectorFieldStream::~VectorFieldStream()
+{
+  // Do nothing
+}
+
+//==============================================================================
+std::unique_ptr<aikido::trajectory::Spline> VectorFieldStream::next(
+    planner::PlanningResult* planningResult)
+{
+  try
+  {
+    if (!mStarted)
+    {
+      mStarted = true;
+      mIntegrator->check(mPosition, mTime);
+    }
+
+    while (mIntegrating && !canRelease())
+      integrateStep();
+  }
+  // VectorFieldTerminated ends the integration without indicating that an
+  // error has occurred.
+  catch (const detail::VectorFieldTerminated& e)
+  {
+    finishIntegration(e.what());
+  }
+  catch (const detail::VectorFieldError& e)
+  {
+    dtwarn << e.what() << std::endl;
+    failIntegration(e.what());
+  }
+
+  if (!canRelease())
+  {
+    if (planningResult)
+      planningResult->message = mMessage;
+    return nullptr;
+  }
+
+  const auto stateSpace = mVectorField->getStateSpace();
+  const auto& knots = mIntegrator->getKnots();
+  const detail::Knot& startKnot = knots[mNumSegments];
+  const detail::Knot& endKnot = knots[mNumSegments + 1];
+
+  // TODO: const cast will be removed after the spline constructor updated.
+  auto segment = dart::common::make_unique<aikido::trajectory::Spline>(
+      std::const_pointer_cast<aikido::statespace::StateSpace>(stateSpace),
+      startKnot.mT);
+  const double segmentDuration = endKnot.mT - startKnot.mT;
+  stateSpace->expMap(startKnot.mPositions, mSegmentStartState);
+  segment->addSegment(
+      aikido::common::fitLinearSegment(
+          endKnot.mPositions - startKnot.mPositions, segmentDuration),
+      segmentDuration,
+      mSegmentStartState);
+
+  // The integrator checks up to, but not including, the newest knot. Check
+  // the rest of the final segments before releasing them.
+  if (!mIntegrating && endKnot.mT > mEvaluationTimePivot)
+  {
+    const bool isLastSegment = (mNumSegments + 2 == mNumFinalKnots);
+    if (!mVectorField->evaluateTrajectory(
+            *segment,
+            mConstraint.get(),
+            mConstraintCheckResolution,
+            mEvaluationTimePivot,
+            isLastSegment))
+    {
+      failIntegration("Constraint violated.");
+      if (planningResult)
+        planningResult->message = mMessage;
+      return nullptr;
+    }
+  }
+
+  ++mNumSegments;
+  return segment;
+}
+
+//==============================================================================
+bool VectorFieldStream::isDone() const
+{
+  return !mIntegrating && !canRelease();
+}
+
+//==============================================================================
+bool VectorFieldStream::hasFailed() const
+{
+  return mFailed;
+}
+
+//==============================================================================
+std::size_t VectorFieldStream::getNumSegments() const
+{
+  return mNumSegments;
+}
+
+//==============================================================================
+void VectorFieldStream::integrateStep()
+{
+  const double h = mStepSize;
+
+  switch (mMethod)
+  {
+    case Method::EULER:
+      mIntegrator->step(mPosition, mK1, mTime);
+      mPosition += h * mK1;
+      break;
+
+    case Method::RK4:
+      mIntegrator->step(mPosition, mK1, mTime);
+      mStagePosition = mPosition + 0.5 * h * mK1;
+      mIntegrator->step(mStagePosition, mK2, mTime + 0.5 * h);
+      mStagePosition = mPosition + 0.5 * h * mK2;
+      mIntegrator->step(mStagePosition, mK3, mTime + 0.5 * h);
+      mStagePosition = mPosition + h * mK3;
+      mIntegrator->step(mStagePosition, mK4, mTime + h);
+      mPosition += (h / 6.0) * (mK1 + 2.0 * mK2 + 2.0 * mK3 + mK4);
+      break;
+  }
+  mTime += h;
+
+  mIntegrator->check(mPosition, mTime);
+
+  if (mTime >= mMaxTime)
+    finishIntegration("Reached maximum integration time.");
+}
+
+//==============================================================================
+void VectorFieldStream::finishIntegration(const std::string& message)
+{
+  mIntegrating = false;
+  mMessage = message;
+
+  // Knots after the last cached one are dropped, as in followVectorField().
+  const int cacheIndex = mIntegrator->getCacheIndex();
+  mNumFinalKnots = cacheIndex > 0 ? static_cast<std::size_t>(cacheIndex) : 0;
+  mEvaluationTimePivot = mIntegrator->getLastEvaluationTime();
+
+  if (mNumFinalKnots <= 1 && mNumSegments == 0)
+    mMessage = "No segment cached.";
+}
+
+//==============================================================================
+void VectorFieldStream::failIntegration(const std::string& message)
+{
+  mIntegrating = false;
+  mFailed = true;
+  mMessage = message;
+  mNumFinalKnots = 0;
+}
+
+//==============================================================================
+bool VectorFieldStream::canRelease() const
+{
+  const auto& knots = mIntegrator->getKnots();
+  const std::size_t endIndex = mNumSegments + 1;
+
+  if (mIntegrating)
+  {
+    return endIndex < knots.size()
+           && knots[endIndex].mT + mLookAheadTime
+                  <= mIntegrator->getLastEvaluationTime();
+  }
+
+  return endIndex < mNumFinalKnots;
+}
+
+} // namespace vectorfield
+} // namespace planner
+} // namespace aikido
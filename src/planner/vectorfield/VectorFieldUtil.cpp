@@ -1,7 +1,6 @@
+#include <limits>
 #include <Eigen/Geometry>
-#include <dart/optimizer/Solver.hpp>
-#include <dart/optimizer/nlopt/NloptSolver.hpp>
-#include <aikido/common/algorithm.hpp>
+#include <dart/math/Geometry.hpp>
 #include <aikido/planner/vectorfield/VectorFieldUtil.hpp>
 #include <aikido/trajectory/Spline.hpp>
 
@@ -11,55 +10,14 @@ namespace vectorfield {
 
 namespace {
 
-/// A function class that defines an objective. The objective measures
-/// the difference between a desired twist and Jacobian * joint velocities.
-///
-class DesiredTwistFunction : public dart::optimizer::Function
-{
-public:
-  using Twist = Eigen::Vector6d;
-  using Jacobian = dart::math::Jacobian;
-
-  /// Constructor.
-  ///
-  /// \param[in] twist A desired twist.
-  /// \param[in] jacobian System Jacobian.
-  DesiredTwistFunction(const Twist& twist, const Jacobian& jacobian)
-    : dart::optimizer::Function("DesiredTwistFunction")
-    , mTwist(twist)
-    , mJacobian(jacobian)
-  {
-    // Do nothing
-  }
-
-  /// Implementation inherited.
-  /// Evaluating an objective by a state value.
-  ///
-  /// \param[in] qd Joint velocities.
-  /// \return Objective value.
-  double eval(const Eigen::VectorXd& qd) override
-  {
-    return 0.5 * (mJacobian * qd - mTwist).squaredNorm();
-  }
-
-  /// Implementation inherited.
-  /// Evaluating gradient of an objective by a state value.
-  /// \param[in] qd Joint velocities.
-  /// \param[out] grad Gradient of a defined objective.
-  void evalGradient(
-      const Eigen::VectorXd& qd, Eigen::Map<Eigen::VectorXd> grad) override
-  {
-    grad = mJacobian.transpose() * (mJacobian * qd - mTwist);
-  }
-
-private:
-  /// Twist.
-  Twist mTwist;
+// Damping of the joint velocity solve. Along a singular value s of the
+// Jacobian, the joint velocity per unit twist is s / (s^2 + damping^2)
+// instead of 1 / s. This differs by less than 0.01% for s > 0.1, so the twist
+// is followed closely away from singularities, and never exceeds
+// 1 / (2 * damping), so the joint velocities stay bounded near them.
+static const double jointVelocityDamping = 1e-3;
 
-  /// Jacobian of Meta Skeleton.
-  Jacobian mJacobian;
-};
-}
+} // namespace
 
 //==============================================================================
 bool computeJointVelocityFromTwist(
@@ -73,65 +31,111 @@ bool computeJointVelocityFromTwist(
     bool enforceJointVelocityLimits,
     double stepSize)
 {
-  using dart::math::Jacobian;
-  using dart::optimizer::Problem;
-  using dart::optimizer::Solver;
-  using Eigen::VectorXd;
+  // Callers of this overload have no solver to keep between calls, so each
+  // thread keeps one and reuses its workspace.
+  thread_local BoundedLeastSquaresSolver solver(jointVelocityDamping);
+  return computeJointVelocityFromTwist(
+      jointVelocity,
+      desiredTwist,
+      metaSkeleton,
+      bodyNode,
+      jointLimitPadding,
+      jointVelocityLowerLimits,
+      jointVelocityUpperLimits,
+      enforceJointVelocityLimits,
+      stepSize,
+      solver);
+}
 
-  // Use LBFGS to find joint angles that won't violate the joint limits.
-  const Jacobian jacobian = metaSkeleton->getWorldJacobian(bodyNode);
+//==============================================================================
+bool computeJointVelocityFromTwist(
+    Eigen::VectorXd& jointVelocity,
+    const Eigen::Vector6d& desiredTwist,
+    const dart::dynamics::MetaSkeletonPtr metaSkeleton,
+    const dart::dynamics::BodyNodePtr bodyNode,
+    double jointLimitPadding,
+    const Eigen::VectorXd& jointVelocityLowerLimits,
+    const Eigen::VectorXd& jointVelocityUpperLimits,
+    bool enforceJointVelocityLimits,
+    double stepSize,
+    BoundedLeastSquaresSolver& solver)
+{
+  // The Jacobian of a single BodyNode has fixed-size rows, like the twist.
+  const dart::math::Jacobian jacobian
+      = metaSkeleton->getWorldJacobian(bodyNode);
+  return computeJointVelocityFromTwist(
+      jointVelocity,
+      desiredTwist,
+      jacobian,
+      metaSkeleton->getPositions(),
+      metaSkeleton->getPositionLowerLimits(),
+      metaSkeleton->getPositionUpperLimits(),
+      jointLimitPadding,
+      jointVelocityLowerLimits,
+      jointVelocityUpperLimits,
+      enforceJointVelocityLimits,
+      stepSize,
+      solver);
+}
 
-  const std::size_t numDofs = metaSkeleton->getNumDofs();
+//==============================================================================
+bool computeJointVelocityFromTwist(
+    Eigen::VectorXd& jointVelocity,
+    const Eigen::Ref<const Eigen::VectorXd>& desiredTwist,
+    const Eigen::Ref<const Eigen::MatrixXd>& jacobian,
+    const Eigen::VectorXd& positions,
+    const Eigen::VectorXd& positionLowerLimits,
+    const Eigen::VectorXd& positionUpperLimits,
+    double jointLimitPadding,
+    const Eigen::VectorXd& jointVelocityLowerLimits,
+    const Eigen::VectorXd& jointVelocityUpperLimits,
+    bool enforceJointVelocityLimits,
+    double stepSize,
+    BoundedLeastSquaresSolver& solver)
+{
+  using Eigen::VectorXd;
 
-  jointVelocity = Eigen::VectorXd::Zero(numDofs);
-  VectorXd positions = metaSkeleton->getPositions();
-  VectorXd initialGuess = metaSkeleton->getVelocities();
-  VectorXd positionLowerLimits = metaSkeleton->getPositionLowerLimits();
-  VectorXd positionUpperLimits = metaSkeleton->getPositionUpperLimits();
-  VectorXd velocityLowerLimits = jointVelocityLowerLimits;
-  VectorXd velocityUpperLimits = jointVelocityUpperLimits;
+  const auto numDofs = jacobian.cols();
 
-  const auto problem = std::make_shared<Problem>(numDofs);
+  VectorXd velocityLowerLimits;
+  VectorXd velocityUpperLimits;
   if (enforceJointVelocityLimits)
   {
-    for (std::size_t i = 0; i < numDofs; ++i)
+    velocityLowerLimits = jointVelocityLowerLimits;
+    velocityUpperLimits = jointVelocityUpperLimits;
+
+    for (Eigen::Index i = 0; i < numDofs; ++i)
     {
       const double position = positions[i];
-      const double positionLowerLimit = positionLowerLimits[i];
-      const double positionUpperLimit = positionUpperLimits[i];
-      const double velocityLowerLimit = velocityLowerLimits[i];
-      const double velocityUpperLimit = velocityUpperLimits[i];
 
-      if (position + stepSize * velocityLowerLimit
-          <= positionLowerLimit + jointLimitPadding)
+      if (position + stepSize * velocityLowerLimits[i]
+          <= positionLowerLimits[i] + jointLimitPadding)
       {
         velocityLowerLimits[i] = 0.0;
       }
 
-      if (position + stepSize * velocityUpperLimit
-          >= positionUpperLimit - jointLimitPadding)
+      if (position + stepSize * velocityUpperLimits[i]
+          >= positionUpperLimits[i] - jointLimitPadding)
       {
         velocityUpperLimits[i] = 0.0;
       }
-
-      initialGuess[i] = common::clamp(
-          initialGuess[i], velocityLowerLimits[i], velocityUpperLimits[i]);
     }
-    problem->setLowerBounds(velocityLowerLimits);
-    problem->setUpperBounds(velocityUpperLimits);
   }
-
-  problem->setInitialGuess(initialGuess);
-  problem->setObjective(
-      std::make_shared<DesiredTwistFunction>(desiredTwist, jacobian));
-
-  dart::optimizer::NloptSolver solver(problem, nlopt::LD_LBFGS);
-  if (!solver.solve())
+  else
   {
-    return false;
+    velocityLowerLimits = VectorXd::Constant(
+        numDofs, -std::numeric_limits<double>::infinity());
+    velocityUpperLimits = VectorXd::Constant(
+        numDofs, std::numeric_limits<double>::infinity());
   }
-  jointVelocity = problem->getOptimalSolution();
-  return true;
+
+  // Find the joint velocities that best achieve the twist within the bounds.
+  return solver.solve(
+      jacobian,
+      desiredTwist,
+      velocityLowerLimits,
+      velocityUpperLimits,
+      jointVelocity);
 }
 
 //==============================================================================
@@ -18,31 +18,21 @@ std::unique_ptr<aikido::trajectory::Spline> convertToSpline(
 {
   using dart::common::make_unique;
 
-  std::size_t dimension = stateSpace->getDimension();
-
   // TODO: const cast will be removed after the spline constructor updated.
   auto nonConstStateSpace
       = std::const_pointer_cast<aikido::statespace::StateSpace>(stateSpace);
   auto outputTrajectory
       = make_unique<aikido::trajectory::Spline>(nonConstStateSpace);
 
-  using CubicSplineProblem = aikido::common::
-      SplineProblem<double, int, 2, Eigen::Dynamic, Eigen::Dynamic>;
-
-  const Eigen::VectorXd zeroPosition = Eigen::VectorXd::Zero(dimension);
   auto currState = stateSpace->createState();
   for (std::size_t iknot = 0; iknot < knots.size() - 1; ++iknot)
   {
     const double segmentDuration = knots[iknot + 1].mT - knots[iknot].mT;
-    Eigen::VectorXd currentPosition = knots[iknot].mPositions;
-    Eigen::VectorXd nextPosition = knots[iknot + 1].mPositions;
+    const Eigen::VectorXd& currentPosition = knots[iknot].mPositions;
+    const Eigen::VectorXd& nextPosition = knots[iknot + 1].mPositions;
 
-    CubicSplineProblem problem(
-        Eigen::Vector2d{0., segmentDuration}, 2, dimension);
-    problem.addConstantConstraint(0, 0, zeroPosition);
-    problem.addConstantConstraint(1, 0, nextPosition - currentPosition);
-    const auto solution = problem.fit();
-    const auto coefficients = solution.getCoefficients().front();
+    const auto coefficients = aikido::common::fitLinearSegment(
+        nextPosition - currentPosition, segmentDuration);
 
     stateSpace->expMap(currentPosition, currState);
     outputTrajectory->addSegment(coefficients, segmentDuration, currState);
@@ -60,11 +50,12 @@ VectorFieldIntegrator::VectorFieldIntegrator(
   , mConstraint(collisionFreeConstraint)
   , mTimelimit(timelimit)
   , mConstraintCheckResolution(checkConstraintResolution)
+  , mState(mVectorField->getStateSpace()->createState())
+  , mSegmentStartState(mVectorField->getStateSpace()->createState())
 {
   mCacheIndex = -1;
   mLastEvaluationTime = 0.0;
   mDimension = mVectorField->getStateSpace()->getDimension();
-  mState = mVectorField->getStateSpace()->createState();
 }
 
 //==============================================================================
@@ -72,6 +63,7 @@ void VectorFieldIntegrator::start()
 {
   mTimer.start();
   mKnots.clear();
+  mTrajectory.reset();
   mCacheIndex = -1;
   mLastEvaluationTime = 0.0;
 }
@@ -124,10 +116,12 @@ void VectorFieldIntegrator::check(const Eigen::VectorXd& q, double t)
 
   if (mKnots.size() > 1)
   {
-    auto trajSegment = convertToSpline(mKnots, mVectorField->getStateSpace());
+    // Only the newest segment is fitted. Constraint checking resumes from
+    // mLastEvaluationTime, so the earlier segments are not checked again.
+    appendSegment(mKnots[mKnots.size() - 2], mKnots.back());
 
     if (!mVectorField->evaluateTrajectory(
-            *trajSegment,
+            *mTrajectory,
             mConstraint,
             mConstraintCheckResolution,
             mLastEvaluationTime,
@@ -153,6 +147,29 @@ void VectorFieldIntegrator::check(const Eigen::VectorXd& q, double t)
   }
 }
 
+//==============================================================================
+void VectorFieldIntegrator::appendSegment(
+    const Knot& startKnot, const Knot& endKnot)
+{
+  const auto stateSpace = mVectorField->getStateSpace();
+
+  if (!mTrajectory)
+  {
+    // TODO: const cast will be removed after the spline constructor updated.
+    auto nonConstStateSpace
+        = std::const_pointer_cast<aikido::statespace::StateSpace>(stateSpace);
+    mTrajectory = dart::common::make_unique<aikido::trajectory::Spline>(
+        nonConstStateSpace, startKnot.mT);
+  }
+
+  const double segmentDuration = endKnot.mT - startKnot.mT;
+  const auto coefficients = aikido::common::fitLinearSegment(
+      endKnot.mPositions - startKnot.mPositions, segmentDuration);
+
+  stateSpace->expMap(startKnot.mPositions, mSegmentStartState);
+  mTrajectory->addSegment(coefficients, segmentDuration, mSegmentStartState);
+}
+
 } // namespace detail
 } // namespace vectorfield
 } // namespace planner
@@ -92,6 +92,12 @@ public:
   void check(const Eigen::VectorXd& q, double t);
 
 protected:
+  /// Appends the linear segment between two knots to mTrajectory.
+  ///
+  /// \param[in] startKnot Knot the segment starts at.
+  /// \param[in] endKnot Knot the segment ends at.
+  void appendSegment(const Knot& startKnot, const Knot& endKnot);
+
   /// Vector field
   const VectorField* mVectorField;
 
@@ -116,10 +122,16 @@ protected:
   double mConstraintCheckResolution;
 
   /// Current state in integration
-  aikido::statespace::StateSpace::State* mState;
+  aikido::statespace::StateSpace::ScopedState mState;
 
   /// Last evaluation time in checking trajectory
   double mLastEvaluationTime;
+
+  /// Trajectory through mKnots. Each accepted step appends one segment.
+  std::unique_ptr<aikido::trajectory::Spline> mTrajectory;
+
+  /// Start state of the segment being appended to mTrajectory.
+  aikido::statespace::StateSpace::ScopedState mSegmentStartState;
 };
 
 } // namespace detail
@@ -0,0 +1,127 @@
+#include <aikido/trajectory/ConcatenatedTrajectory.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace aikido {
+namespace trajectory {
+
+//==============================================================================
+ConcatenatedTrajectory::ConcatenatedTrajectory(
+    std::vector<ConstTrajectoryPtr> _trajectories)
+  : mTrajectories(std::move(_trajectories)), mNumDerivatives(0)
+{
+  if (mTrajectories.empty())
+    throw std::invalid_argument("At least one trajectory is required.");
+
+  for (const auto& trajectory : mTrajectories)
+  {
+    if (!trajectory)
+      throw std::invalid_argument("Trajectory is null.");
+  }
+
+  const auto stateSpace = mTrajectories.front()->getStateSpace();
+
+  mKnotTimes.reserve(mTrajectories.size() + 1);
+  mTimeOffsets.reserve(mTrajectories.size());
+  mKnotTimes.push_back(mTrajectories.front()->getStartTime());
+
+  for (const auto& trajectory : mTrajectories)
+  {
+    if (trajectory->getStateSpace() != stateSpace)
+    {
+      throw std::invalid_argument(
+          "Trajectories must be in the same state space.");
+    }
+
+    mTimeOffsets.push_back(trajectory->getStartTime() - mKnotTimes.back());
+    mKnotTimes.push_back(mKnotTimes.back() + trajectory->getDuration());
+    mNumDerivatives
+        = std::max(mNumDerivatives, trajectory->getNumDerivatives());
+  }
+}
+
+//==============================================================================
+std::size_t ConcatenatedTrajectory::getNumTrajectories() const
+{
+  return mTrajectories.size();
+}
+
+//==============================================================================
+ConstTrajectoryPtr ConcatenatedTrajectory::getTrajectory(
+    std::size_t _index) const
+{
+  if (_index >= mTrajectories.size())
+    throw std::domain_error("Trajectory index is out of bounds.");
+
+  return mTrajectories[_index];
+}
+
+//==============================================================================
+double ConcatenatedTrajectory::getTrajectoryStartTime(std::size_t _index) const
+{
+  if (_index >= mTrajectories.size())
+    throw std::domain_error("Trajectory index is out of bounds.");
+
+  return mKnotTimes[_index];
+}
+
+//==============================================================================
+statespace::ConstStateSpacePtr ConcatenatedTrajectory::getStateSpace() const
+{
+  return mTrajectories.front()->getStateSpace();
+}
+
+//==============================================================================
+std::size_t ConcatenatedTrajectory::getNumDerivatives() const
+{
+  return mNumDerivatives;
+}
+
+//==============================================================================
+double ConcatenatedTrajectory::getDuration() const
+{
+  return getEndTime() - getStartTime();
+}
+
+//==============================================================================
+double ConcatenatedTrajectory::getStartTime() const
+{
+  return mKnotTimes.front();
+}
+
+//==============================================================================
+double ConcatenatedTrajectory::getEndTime() const
+{
+  return mKnotTimes.back();
+}
+
+//==============================================================================
+void ConcatenatedTrajectory::evaluate(
+    double _t, statespace::StateSpace::State* _state) const
+{
+  const auto index = getTrajectoryForTime(_t);
+  mTrajectories[index]->evaluate(_t + mTimeOffsets[index], _state);
+}
+
+//==============================================================================
+void ConcatenatedTrajectory::evaluateDerivative(
+    double _t, int _derivative, Eigen::VectorXd& _tangentVector) const
+{
+  const auto index = getTrajectoryForTime(_t);
+  mTrajectories[index]->evaluateDerivative(
+      _t + mTimeOffsets[index], _derivative, _tangentVector);
+}
+
+//==============================================================================
+std::size_t ConcatenatedTrajectory::getTrajectoryForTime(double _t) const
+{
+  // Find the first trajectory that ends at or after _t. Times outside of this
+  // trajectory belong to the first or last trajectory.
+  const auto it
+      = std::lower_bound(mKnotTimes.begin() + 1, mKnotTimes.end() - 1, _t);
+  return static_cast<std::size_t>(it - (mKnotTimes.begin() + 1));
+}
+
+} // namespace trajectory
+} // namespace aikido
@@ -1,5 +1,8 @@
 #include <aikido/trajectory/Interpolated.hpp>
 
+#include <algorithm>
+#include <cstddef>
+
 using aikido::statespace::GeodesicInterpolator;
 
 namespace aikido {
@@ -7,13 +10,34 @@ namespace trajectory {
 
 using State = aikido::statespace::StateSpace::State;
 
+namespace {
+
+/// Number of states in the first block of waypoint states.
+constexpr std::size_t MIN_STATE_BLOCK_CAPACITY = 8;
+
+} // namespace
+
 //==============================================================================
 Interpolated::Interpolated(
     statespace::ConstStateSpacePtr _stateSpace,
     statespace::ConstInterpolatorPtr _interpolator)
-  : mStateSpace(std::move(_stateSpace)), mInterpolator(std::move(_interpolator))
+  : mStateSpace(std::move(_stateSpace))
+  , mInterpolator(std::move(_interpolator))
+  , mStateBlockCapacity(0)
+  , mStateBlockSize(0)
+{
+  // Keep every state in a block aligned like a state from allocateState().
+  constexpr std::size_t alignment = alignof(std::max_align_t);
+  const std::size_t stateSize
+      = std::max<std::size_t>(mStateSpace->getStateSizeInBytes(), 1);
+  mStateStride = (stateSize + alignment - 1) / alignment * alignment;
+}
+
+//==============================================================================
+Interpolated::~Interpolated()
 {
-  // Do nothing
+  for (const auto& waypoint : mWaypoints)
+    mStateSpace->freeStateInBuffer(waypoint.state);
 }
 
 //==============================================================================
@@ -68,30 +92,7 @@ void Interpolated::evaluate(double _t, State* _state) const
     throw std::invalid_argument(
         "Requested trajectory point from an empty trajectory");
 
-  try
-  {
-    int idx = getWaypointIndexAfterTime(_t);
-    if (idx == 0)
-    {
-      // Time before beginning of trajectory - return first waypoint
-      mStateSpace->copyState(mWaypoints[0].state, _state);
-    }
-    else
-    {
-      Waypoint currentWpt = mWaypoints[idx];
-      Waypoint prevWpt = mWaypoints[idx - 1];
-      mInterpolator->interpolate(
-          prevWpt.state,
-          currentWpt.state,
-          (_t - prevWpt.t) / (currentWpt.t - prevWpt.t),
-          _state);
-    }
-  }
-  catch (const std::domain_error& e)
-  {
-    // Time past end of trajectory - return last waypoint
-    mStateSpace->copyState(mWaypoints.back().state, _state);
-  }
+  evaluateAtIndex(getWaypointIndexAfterTime(_t), _t, _state);
 }
 
 //==============================================================================
@@ -102,55 +103,86 @@ void Interpolated::evaluateDerivative(
     throw std::invalid_argument(
         "0th derivative not available. Use evaluate(t, state).");
 
-  if (static_cast<std::size_t>(_derivative)
-      > mInterpolator->getNumDerivatives())
-  {
-    _tangentVector.resize(mStateSpace->getDimension());
-    _tangentVector.setZero();
-  }
-
-  // Compute the interpolated state at time t
-  auto iPt = mStateSpace->createState();
-  evaluate(_t, iPt);
+  if (mWaypoints.empty())
+    throw std::invalid_argument(
+        "Requested trajectory point from an empty trajectory");
 
-  // Compute the endpoint of the segment
-  try
-  {
-    int idx = getWaypointIndexAfterTime(_t);
+  evaluateDerivativeAtIndex(
+      getWaypointIndexAfterTime(_t), _t, _derivative, _tangentVector);
+}
 
-    // Time before beginning of trajectory - return 0
-    if (idx == 0)
-      throw std::domain_error("Time is before the trajectory starts.");
+//==============================================================================
+void Interpolated::sample(
+    const std::vector<double>& _times,
+    Eigen::MatrixXd* _positions,
+    Eigen::MatrixXd* _velocities,
+    Eigen::MatrixXd* _accelerations) const
+{
+  if (mWaypoints.empty())
+    throw std::invalid_argument(
+        "Requested trajectory point from an empty trajectory");
 
-    const auto segmentTime = mWaypoints[idx].t - mWaypoints[idx - 1].t;
-    const auto alpha = (_t - mWaypoints[idx - 1].t) / segmentTime;
+  auto state = mStateSpace->createState();
+  std::size_t idx = 0;
+
+  sampleWith(
+      mStateSpace->getDimension(),
+      _times,
+      _positions,
+      _velocities,
+      _accelerations,
+      [&](double _t, int _order, Eigen::VectorXd& _tangentVector) {
+        // Walk forward from the waypoint of the previous sample, unless the
+        // times went backwards. Later outputs of a sample find it in place.
+        if (idx > 0 && mWaypoints[idx - 1].t >= _t)
+          idx = getWaypointIndexAfterTime(_t);
+        while (idx < mWaypoints.size() && mWaypoints[idx].t < _t)
+          ++idx;
+
+        if (_order == 0)
+        {
+          evaluateAtIndex(idx, _t, state);
+          mStateSpace->logMap(state, _tangentVector);
+        }
+        else
+        {
+          evaluateDerivativeAtIndex(idx, _t, _order, _tangentVector);
+        }
+      });
+}
 
-    mInterpolator->getDerivative(
-        mWaypoints[idx - 1].state,
-        mWaypoints[idx].state,
-        _derivative,
-        alpha,
-        _tangentVector);
+//==============================================================================
+void Interpolated::addWaypoint(double _t, const State* _state)
+{
+  State* state = createWaypointState(_state);
 
-    _tangentVector /= segmentTime;
-  }
-  // Time past end of trajectory - return zero
-  catch (const std::domain_error& e)
+  // Maintain a sorted list of waypoints. Waypoints added in order of time are
+  // appended without a search.
+  if (mWaypoints.empty() || mWaypoints.back().t < _t)
   {
-    _tangentVector.resize(mStateSpace->getDimension());
-    _tangentVector.setZero();
+    mWaypoints.emplace_back(_t, state);
+    return;
   }
+
+  auto it = std::lower_bound(mWaypoints.begin(), mWaypoints.end(), _t);
+  mWaypoints.insert(it, Waypoint(_t, state));
 }
 
 //==============================================================================
-void Interpolated::addWaypoint(double _t, const State* _state)
+void Interpolated::reserve(std::size_t _numWaypoints)
 {
-  State* state = mStateSpace->allocateState();
-  mStateSpace->copyState(_state, state);
+  if (_numWaypoints <= mWaypoints.size())
+    return;
 
-  // Maintain a sorted list of waypoints
-  auto it = std::lower_bound(mWaypoints.begin(), mWaypoints.end(), _t);
-  mWaypoints.insert(it, Waypoint(_t, state));
+  mWaypoints.reserve(_numWaypoints);
+
+  const auto numNewStates = _numWaypoints - mWaypoints.size();
+  if (mStateBlockSize + numNewStates <= mStateBlockCapacity)
+    return;
+
+  mStateBlocks.emplace_back(new char[numNewStates * mStateStride]);
+  mStateBlockCapacity = numNewStates;
+  mStateBlockSize = 0;
 }
 
 //==============================================================================
@@ -179,16 +211,87 @@ std::size_t Interpolated::getNumWaypoints() const
 }
 
 //==============================================================================
-int Interpolated::getWaypointIndexAfterTime(double _t) const
+std::size_t Interpolated::getWaypointIndexAfterTime(double _t) const
 {
-  auto it = std::lower_bound(mWaypoints.begin(), mWaypoints.end(), _t);
-  if (it == mWaypoints.end())
+  const auto it = std::lower_bound(mWaypoints.begin(), mWaypoints.end(), _t);
+  return static_cast<std::size_t>(std::distance(mWaypoints.begin(), it));
+}
+
+//==============================================================================
+State* Interpolated::createWaypointState(const State* _state)
+{
+  if (mStateBlockSize == mStateBlockCapacity)
+  {
+    // Grow geometrically, so that adding a waypoint takes amortized constant
+    // time.
+    const auto capacity
+        = std::max(MIN_STATE_BLOCK_CAPACITY, mWaypoints.size());
+    mStateBlocks.emplace_back(new char[capacity * mStateStride]);
+    mStateBlockCapacity = capacity;
+    mStateBlockSize = 0;
+  }
+
+  char* buffer = mStateBlocks.back().get() + mStateBlockSize * mStateStride;
+  ++mStateBlockSize;
+
+  State* state = mStateSpace->allocateStateInBuffer(buffer);
+  mStateSpace->copyState(_state, state);
+  return state;
+}
+
+//==============================================================================
+void Interpolated::evaluateAtIndex(
+    std::size_t _index, double _t, State* _state) const
+{
+  if (_index == 0)
+  {
+    // Time before beginning of trajectory - return first waypoint
+    mStateSpace->copyState(mWaypoints.front().state, _state);
+  }
+  else if (_index == mWaypoints.size())
+  {
+    // Time past end of trajectory - return last waypoint
+    mStateSpace->copyState(mWaypoints.back().state, _state);
+  }
+  else
   {
-    throw std::domain_error(
-        "_t is larger than the time value on the last waypoint.");
+    const Waypoint& currentWpt = mWaypoints[_index];
+    const Waypoint& prevWpt = mWaypoints[_index - 1];
+    mInterpolator->interpolate(
+        prevWpt.state,
+        currentWpt.state,
+        (_t - prevWpt.t) / (currentWpt.t - prevWpt.t),
+        _state);
   }
+}
+
+//==============================================================================
+void Interpolated::evaluateDerivativeAtIndex(
+    std::size_t _index,
+    double _t,
+    int _derivative,
+    Eigen::VectorXd& _tangentVector) const
+{
+  // Return zero before the beginning of the trajectory, past its end and for
+  // derivatives the interpolator does not provide.
+  if (_index == 0 || _index == mWaypoints.size()
+      || static_cast<std::size_t>(_derivative)
+             > mInterpolator->getNumDerivatives())
+  {
+    _tangentVector.resize(mStateSpace->getDimension());
+    _tangentVector.setZero();
+    return;
+  }
+
+  const Waypoint& currentWpt = mWaypoints[_index];
+  const Waypoint& prevWpt = mWaypoints[_index - 1];
+  const auto segmentTime = currentWpt.t - prevWpt.t;
+  const auto alpha = (_t - prevWpt.t) / segmentTime;
+
+  mInterpolator->getDerivative(
+      prevWpt.state, currentWpt.state, _derivative, alpha, _tangentVector);
 
-  return std::distance(mWaypoints.begin(), it);
+  _tangentVector /= segmentTime;
 }
 
 //==============================================================================
@@ -0,0 +1,58 @@
+#include <aikido/trajectory/InterpolatedBuilder.hpp>
+
+#include <stdexcept>
+#include <dart/common/StlHelpers.hpp>
+
+namespace aikido {
+namespace trajectory {
+
+//==============================================================================
+InterpolatedBuilder::InterpolatedBuilder(
+    statespace::ConstStateSpacePtr _stateSpace,
+    statespace::ConstInterpolatorPtr _interpolator,
+    std::size_t _numWaypoints)
+  : mStateSpace(std::move(_stateSpace))
+  , mInterpolator(std::move(_interpolator))
+  , mTrajectory(
+        dart::common::make_unique<Interpolated>(mStateSpace, mInterpolator))
+{
+  reserve(_numWaypoints);
+}
+
+//==============================================================================
+void InterpolatedBuilder::reserve(std::size_t _numWaypoints)
+{
+  mTrajectory->reserve(_numWaypoints);
+}
+
+//==============================================================================
+void InterpolatedBuilder::addWaypoint(
+    double _t, const statespace::StateSpace::State* _state)
+{
+  auto& waypoints = mTrajectory->mWaypoints;
+  if (!waypoints.empty() && !(waypoints.back().t < _t))
+  {
+    throw std::invalid_argument(
+        "Waypoints must be added in increasing order of time.");
+  }
+
+  waypoints.emplace_back(_t, mTrajectory->createWaypointState(_state));
+}
+
+//==============================================================================
+std::size_t InterpolatedBuilder::getNumWaypoints() const
+{
+  return mTrajectory->getNumWaypoints();
+}
+
+//==============================================================================
+std::unique_ptr<Interpolated> InterpolatedBuilder::finalize()
+{
+  auto trajectory = std::move(mTrajectory);
+  mTrajectory
+      = dart::common::make_unique<Interpolated>(mStateSpace, mInterpolator);
+  return trajectory;
+}
+
+} // namespace trajectory
+} // namespace aikido
@@ -0,0 +1,411 @@
+#include <aikido/trajectory/PackedSpline.hpp>
+
+#include <algorithm>
+#include <dart/common/StlHelpers.hpp>
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SO2.hpp>
+
+namespace aikido {
+namespace trajectory {
+
+namespace {
+
+//==============================================================================
+/// Returns the factor i! / (i - n)! of the n-th derivative of t^i.
+double getDerivativeFactor(Eigen::Index _power, int _derivative)
+{
+  double factor = 1.;
+  for (Eigen::Index i = _power - _derivative + 1; i <= _power; ++i)
+    factor *= i;
+  return factor;
+}
+
+} // namespace
+
+//==============================================================================
+PackedSpline::PackedSpline(
+    statespace::ConstStateSpacePtr _stateSpace, double _startTime)
+  : mStateSpace(std::move(_stateSpace))
+  , mDimension(0)
+  , mNumDerivatives(0)
+  , mNumSegments(0)
+  , mColumnOffsets{0}
+  , mKnotTimes{_startTime}
+  , mCoefficientView(nullptr)
+  , mColumnOffsetView(nullptr)
+  , mKnotTimeView(nullptr)
+{
+  if (mStateSpace == nullptr)
+    throw std::invalid_argument("StateSpace is null.");
+
+  if (!isSupported(mStateSpace.get()))
+  {
+    throw std::invalid_argument(
+        "PackedSpline only supports Rn, SO2, and CartesianProducts consisting "
+        "of those types.");
+  }
+
+  mDimension = static_cast<Eigen::Index>(mStateSpace->getDimension());
+}
+
+//==============================================================================
+PackedSpline::PackedSpline(const Spline& _spline)
+  : PackedSpline(_spline.getStateSpace(), _spline.getStartTime())
+{
+  const auto numSegments = _spline.getNumSegments();
+  if (numSegments > 0)
+    reserve(numSegments, _spline.getNumDerivatives() + 1);
+
+  for (std::size_t isegment = 0; isegment < numSegments; ++isegment)
+  {
+    addSegment(
+        _spline.getSegmentCoefficients(isegment),
+        _spline.getSegmentDuration(isegment),
+        _spline.getSegmentStartState(isegment));
+  }
+}
+
+//==============================================================================
+PackedSpline::PackedSpline(
+    statespace::ConstStateSpacePtr _stateSpace,
+    const double* _knotTimes,
+    const std::uint64_t* _columnOffsets,
+    const double* _coefficients,
+    std::size_t _numSegments,
+    std::shared_ptr<const void> _buffer)
+  : PackedSpline(std::move(_stateSpace))
+{
+  if (!_knotTimes || !_columnOffsets || !_coefficients)
+    throw std::invalid_argument("Arrays must not be null.");
+
+  for (std::size_t isegment = 0; isegment < _numSegments; ++isegment)
+  {
+    if (!(_knotTimes[isegment + 1] > _knotTimes[isegment]))
+      throw std::invalid_argument("Knot times must be increasing.");
+
+    if (_columnOffsets[isegment + 1] <= _columnOffsets[isegment])
+      throw std::invalid_argument("At least one coefficient is required.");
+
+    mNumDerivatives = std::max<std::size_t>(
+        mNumDerivatives,
+        _columnOffsets[isegment + 1] - _columnOffsets[isegment] - 1);
+  }
+
+  mNumSegments = _numSegments;
+  mColumnOffsets.clear();
+  mKnotTimes.clear();
+  mCoefficientView = _coefficients;
+  mColumnOffsetView = _columnOffsets;
+  mKnotTimeView = _knotTimes;
+  mBuffer = std::move(_buffer);
+}
+
+//==============================================================================
+bool PackedSpline::isSupported(const statespace::StateSpace* _stateSpace)
+{
+  using statespace::R;
+
+  // TODO: Generalize R<N> for arbitrary N.
+  if (dynamic_cast<const R<0>*>(_stateSpace) != nullptr
+      || dynamic_cast<const R<1>*>(_stateSpace) != nullptr
+      || dynamic_cast<const R<2>*>(_stateSpace) != nullptr
+      || dynamic_cast<const R<3>*>(_stateSpace) != nullptr
+      || dynamic_cast<const R<6>*>(_stateSpace) != nullptr
+      || dynamic_cast<const R<Eigen::Dynamic>*>(_stateSpace) != nullptr
+      || dynamic_cast<const statespace::SO2*>(_stateSpace) != nullptr)
+  {
+    return true;
+  }
+  else if (
+      auto space = dynamic_cast<const statespace::CartesianProduct*>(
+          _stateSpace))
+  {
+    for (std::size_t isubspace = 0; isubspace < space->getNumSubspaces();
+         ++isubspace)
+    {
+      if (!isSupported(space->getSubspace<>(isubspace).get()))
+        return false;
+    }
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+//==============================================================================
+void PackedSpline::addSegment(
+    const Eigen::MatrixXd& _coefficients,
+    double _duration,
+    const statespace::StateSpace::State* _startState)
+{
+  checkNotView();
+
+  if (_duration <= 0.)
+    throw std::invalid_argument("Duration must be positive.");
+
+  if (_coefficients.rows() != mDimension)
+    throw std::invalid_argument("Incorrect number of dimensions.");
+
+  if (_coefficients.cols() < 1)
+    throw std::invalid_argument("At least one coefficient is required.");
+
+  Eigen::VectorXd startPosition;
+  mStateSpace->logMap(_startState, startPosition);
+
+  // Coefficient matrices are column-major, so the first mDimension values are
+  // the constant coefficients.
+  const auto offset = mCoefficients.size();
+  mCoefficients.insert(
+      mCoefficients.end(),
+      _coefficients.data(),
+      _coefficients.data() + _coefficients.size());
+  for (Eigen::Index i = 0; i < mDimension; ++i)
+    mCoefficients[offset + i] += startPosition[i];
+
+  mColumnOffsets.push_back(mColumnOffsets.back() + _coefficients.cols());
+  mKnotTimes.push_back(mKnotTimes.back() + _duration);
+  ++mNumSegments;
+  mNumDerivatives = std::max<std::size_t>(
+      mNumDerivatives, _coefficients.cols() - 1);
+}
+
+//==============================================================================
+void PackedSpline::reserve(
+    std::size_t _numSegments, std::size_t _numCoefficients)
+{
+  checkNotView();
+
+  mCoefficients.reserve(_numSegments * _numCoefficients * mDimension);
+  mColumnOffsets.reserve(_numSegments + 1);
+  mKnotTimes.reserve(_numSegments + 1);
+}
+
+//==============================================================================
+std::size_t PackedSpline::getNumSegments() const
+{
+  return mNumSegments;
+}
+
+//==============================================================================
+Eigen::Map<const Eigen::MatrixXd> PackedSpline::getSegmentCoefficients(
+    std::size_t _index) const
+{
+  if (_index >= getNumSegments())
+    throw std::domain_error("Segment index is out of bounds.");
+
+  const auto columnOffsets = getColumnOffsets();
+  const auto columnOffset = columnOffsets[_index];
+  const auto numCoeffs = columnOffsets[_index + 1] - columnOffset;
+  return Eigen::Map<const Eigen::MatrixXd>(
+      getCoefficients() + columnOffset * mDimension,
+      mDimension,
+      static_cast<Eigen::Index>(numCoeffs));
+}
+
+//==============================================================================
+double PackedSpline::getWaypointTime(std::size_t _index) const
+{
+  if (_index > mNumSegments)
+    throw std::domain_error("Waypoint index is out of bounds.");
+
+  return getKnotTimes()[_index];
+}
+
+//==============================================================================
+std::unique_ptr<Spline> PackedSpline::toSpline() const
+{
+  auto spline = dart::common::make_unique<Spline>(mStateSpace, getStartTime());
+  auto startState = mStateSpace->createState();
+  const auto knotTimes = getKnotTimes();
+  Eigen::MatrixXd coefficients;
+
+  for (std::size_t isegment = 0; isegment < getNumSegments(); ++isegment)
+  {
+    coefficients = getSegmentCoefficients(isegment);
+
+    mStateSpace->expMap(coefficients.col(0), startState);
+    coefficients.col(0).setZero();
+
+    spline->addSegment(
+        coefficients,
+        knotTimes[isegment + 1] - knotTimes[isegment],
+        startState);
+  }
+
+  return spline;
+}
+
+//==============================================================================
+statespace::ConstStateSpacePtr PackedSpline::getStateSpace() const
+{
+  return mStateSpace;
+}
+
+//==============================================================================
+std::size_t PackedSpline::getNumDerivatives() const
+{
+  return mNumDerivatives;
+}
+
+//==============================================================================
+double PackedSpline::getStartTime() const
+{
+  return getKnotTimes()[0];
+}
+
+//==============================================================================
+double PackedSpline::getEndTime() const
+{
+  return getKnotTimes()[mNumSegments];
+}
+
+//==============================================================================
+double PackedSpline::getDuration() const
+{
+  return getEndTime() - getStartTime();
+}
+
+//==============================================================================
+void PackedSpline::evaluate(
+    double _t, statespace::StateSpace::State* _state) const
+{
+  if (getNumSegments() == 0)
+    throw std::logic_error("Unable to evaluate empty trajectory.");
+
+  const auto isegment = getSegmentForTime(_t);
+
+  Eigen::VectorXd position;
+  evaluatePolynomial(isegment, _t - getKnotTimes()[isegment], 0, position);
+  mStateSpace->expMap(position, _state);
+}
+
+//==============================================================================
+void PackedSpline::evaluateDerivative(
+    double _t, int _derivative, Eigen::VectorXd& _tangentVector) const
+{
+  if (getNumSegments() == 0)
+    throw std::logic_error("Unable to evaluate empty trajectory.");
+  if (_derivative < 1)
+    throw std::logic_error("Derivative must be positive.");
+
+  const auto isegment = getSegmentForTime(_t);
+  evaluatePolynomial(
+      isegment, _t - getKnotTimes()[isegment], _derivative, _tangentVector);
+}
+
+//==============================================================================
+void PackedSpline::sample(
+    const std::vector<double>& _times,
+    Eigen::MatrixXd* _positions,
+    Eigen::MatrixXd* _velocities,
+    Eigen::MatrixXd* _accelerations) const
+{
+  const auto numSegments = getNumSegments();
+  if (numSegments == 0)
+    throw std::logic_error("Unable to evaluate empty trajectory.");
+
+  // Positions are the log map of the state, which is the polynomial itself in
+  // the supported state spaces.
+  const auto knotTimes = getKnotTimes();
+  std::size_t isegment = 0;
+  sampleWith(
+      static_cast<std::size_t>(mDimension),
+      _times,
+      _positions,
+      _velocities,
+      _accelerations,
+      [&](double _t, int _order, Eigen::VectorXd& _tangentVector) {
+        // Walk forward from the segment of the previous sample, unless the
+        // times went backwards. Later outputs of a sample find it in place.
+        if (isegment > 0 && _t <= knotTimes[isegment])
+          isegment = getSegmentForTime(_t);
+        while (isegment + 1 < numSegments && _t > knotTimes[isegment + 1])
+          ++isegment;
+
+        evaluatePolynomial(
+            isegment, _t - knotTimes[isegment], _order, _tangentVector);
+      });
+}
+
+//==============================================================================
+std::size_t PackedSpline::getSegmentForTime(double _t) const
+{
+  // Find the first segment that ends at or after _t. Times after the end of
+  // the trajectory belong to the last segment.
+  const auto knotTimes = getKnotTimes();
+  const auto it
+      = std::lower_bound(knotTimes + 1, knotTimes + mNumSegments, _t);
+  return static_cast<std::size_t>(it - (knotTimes + 1));
+}
+
+//==============================================================================
+void PackedSpline::checkNotView() const
+{
+  if (mKnotTimeView)
+  {
+    throw std::logic_error(
+        "Unable to modify a trajectory that views external arrays.");
+  }
+}
+
+//==============================================================================
+const double* PackedSpline::getCoefficients() const
+{
+  return mKnotTimeView ? mCoefficientView : mCoefficients.data();
+}
+
+//==============================================================================
+const std::uint64_t* PackedSpline::getColumnOffsets() const
+{
+  return mKnotTimeView ? mColumnOffsetView : mColumnOffsets.data();
+}
+
+//==============================================================================
+const double* PackedSpline::getKnotTimes() const
+{
+  return mKnotTimeView ? mKnotTimeView : mKnotTimes.data();
+}
+
+//==============================================================================
+void PackedSpline::evaluatePolynomial(
+    std::size_t _segment,
+    double _t,
+    int _derivative,
+    Eigen::VectorXd& _out) const
+{
+  evaluatePolynomial(getSegmentCoefficients(_segment), _t, _derivative, _out);
+}
+
+//==============================================================================
+void PackedSpline::evaluatePolynomial(
+    const Eigen::Ref<const Eigen::MatrixXd>& _coefficients,
+    double _t,
+    int _derivative,
+    Eigen::VectorXd& _out)
+{
+  const auto numCoeffs = _coefficients.cols();
+
+  // Return zero for higher-order derivatives.
+  if (_derivative >= numCoeffs)
+  {
+    _out.resize(_coefficients.rows());
+    _out.setZero();
+    return;
+  }
+
+  // Horner's scheme on the derivative of the polynomial, evaluated for all
+  // dimensions at once.
+  Eigen::Index icoeff = numCoeffs - 1;
+  _out = getDerivativeFactor(icoeff, _derivative) * _coefficients.col(icoeff);
+  while (icoeff-- > _derivative)
+  {
+    const double factor = getDerivativeFactor(icoeff, _derivative);
+    _out = _t * _out + factor * _coefficients.col(icoeff);
+  }
+}
+
+} // namespace trajectory
+} // namespace aikido
@@ -1,13 +1,18 @@
 #include <aikido/trajectory/Spline.hpp>
 
+#include <algorithm>
 #include <aikido/common/Spline.hpp>
+#include <aikido/trajectory/SplineCursor.hpp>
 
 namespace aikido {
 namespace trajectory {
 
 //==============================================================================
 Spline::Spline(statespace::ConstStateSpacePtr _stateSpace, double _startTime)
-  : mStateSpace(std::move(_stateSpace)), mStartTime(_startTime)
+  : mStateSpace(std::move(_stateSpace))
+  , mStartTime(_startTime)
+  , mDuration(0.)
+  , mSegmentHint(0)
 {
   if (mStateSpace == nullptr)
     throw std::invalid_argument("StateSpace is null.");
@@ -41,8 +46,30 @@ void Spline::addSegment(
   segment.mDuration = _duration;
   segment.mStartState = mStateSpace->allocateState();
   mStateSpace->copyState(_startState, segment.mStartState);
+  segment.mStartTime = mSegments.empty()
+                           ? mStartTime
+                           : mSegments.back().mStartTime
+                                 + mSegments.back().mDuration;
+
+  // Differentiate the polynomial once here instead of on every evaluation:
+  // d/dt (c_i t^i) = i c_i t^(i - 1).
+  const auto numCoeffs = _coefficients.cols();
+  segment.mDerivativeCoefficients.reserve(numCoeffs - 1);
+  for (Eigen::Index iderivative = 1; iderivative < numCoeffs; ++iderivative)
+  {
+    const Eigen::MatrixXd& previous
+        = iderivative == 1 ? segment.mCoefficients
+                           : segment.mDerivativeCoefficients.back();
+
+    Eigen::MatrixXd derivative(previous.rows(), previous.cols() - 1);
+    for (Eigen::Index icoeff = 0; icoeff < derivative.cols(); ++icoeff)
+      derivative.col(icoeff) = (icoeff + 1) * previous.col(icoeff + 1);
+
+    segment.mDerivativeCoefficients.emplace_back(std::move(derivative));
+  }
 
   mSegments.emplace_back(std::move(segment));
+  mDuration += _duration;
 }
 
 //==============================================================================
@@ -61,12 +88,59 @@ void Spline::addSegment(const Eigen::MatrixXd& _coefficients, double _duration)
   addSegment(_coefficients, _duration, startState);
 }
 
+//==============================================================================
+void Spline::removeSegments(std::size_t _index)
+{
+  if (_index > mSegments.size())
+    throw std::domain_error("Segment index is out of bounds.");
+
+  for (auto it = mSegments.begin() + _index; it != mSegments.end(); ++it)
+    mStateSpace->freeState(it->mStartState);
+  mSegments.erase(mSegments.begin() + _index, mSegments.end());
+
+  // Sum the remaining durations in the same order as addSegment() does.
+  mDuration = 0.;
+  for (const auto& segment : mSegments)
+    mDuration += segment.mDuration;
+
+  if (mSegmentHint.load(std::memory_order_relaxed) >= mSegments.size())
+    mSegmentHint.store(0, std::memory_order_relaxed);
+}
+
 //==============================================================================
 std::size_t Spline::getNumSegments() const
 {
   return mSegments.size();
 }
 
+//==============================================================================
+const Eigen::MatrixXd& Spline::getSegmentCoefficients(std::size_t _index) const
+{
+  if (_index >= mSegments.size())
+    throw std::domain_error("Segment index is out of bounds.");
+
+  return mSegments[_index].mCoefficients;
+}
+
+//==============================================================================
+const statespace::StateSpace::State* Spline::getSegmentStartState(
+    std::size_t _index) const
+{
+  if (_index >= mSegments.size())
+    throw std::domain_error("Segment index is out of bounds.");
+
+  return mSegments[_index].mStartState;
+}
+
+//==============================================================================
+double Spline::getSegmentDuration(std::size_t _index) const
+{
+  if (_index >= mSegments.size())
+    throw std::domain_error("Segment index is out of bounds.");
+
+  return mSegments[_index].mDuration;
+}
+
 //==============================================================================
 statespace::ConstStateSpacePtr Spline::getStateSpace() const
 {
@@ -102,12 +176,7 @@ double Spline::getEndTime() const
 //==============================================================================
 double Spline::getDuration() const
 {
-  double duration = 0.;
-
-  for (const auto& segment : mSegments)
-    duration += segment.mDuration;
-
-  return duration;
+  return mDuration;
 }
 
 //==============================================================================
@@ -122,8 +191,8 @@ void Spline::evaluate(double _t, statespace::StateSpace::State* _out) const
   mStateSpace->copyState(targetSegment.mStartState, _out);
 
   const auto evaluationTime = _t - targetSegmentInfo.second;
-  const auto tangentVector
-      = evaluatePolynomial(targetSegment.mCoefficients, evaluationTime, 0);
+  Eigen::VectorXd tangentVector;
+  evaluatePolynomial(targetSegment, evaluationTime, 0, tangentVector);
 
   const auto relativeState = mStateSpace->createState();
   mStateSpace->expMap(tangentVector, relativeState);
@@ -143,63 +212,107 @@ void Spline::evaluateDerivative(
   const auto& targetSegment = mSegments[targetSegmentInfo.first];
   const auto evaluationTime = _t - targetSegmentInfo.second;
 
-  // Return zero for higher-order derivatives.
-  if (_derivative < targetSegment.mCoefficients.cols())
-  {
-    // TODO: We should transform this into the body frame using the adjoint
-    // transformation.
-    _tangentVector = evaluatePolynomial(
-        targetSegment.mCoefficients, evaluationTime, _derivative);
-  }
-  else
-  {
-    _tangentVector.resize(mStateSpace->getDimension());
-    _tangentVector.setZero();
-  }
+  // TODO: We should transform this into the body frame using the adjoint
+  // transformation.
+  evaluatePolynomial(
+      targetSegment, evaluationTime, _derivative, _tangentVector);
 }
 
 //==============================================================================
-std::pair<std::size_t, double> Spline::getSegmentForTime(double _t) const
+void Spline::sample(
+    const std::vector<double>& _times,
+    Eigen::MatrixXd* _positions,
+    Eigen::MatrixXd* _velocities,
+    Eigen::MatrixXd* _accelerations) const
 {
-  auto segmentStartTime = mStartTime;
-
-  for (std::size_t isegment = 0; isegment < mSegments.size(); ++isegment)
-  {
-    const auto& segment = mSegments[isegment];
-    const auto nextSegmentStartTime = segmentStartTime + segment.mDuration;
+  if (mSegments.empty())
+    throw std::logic_error("Unable to evaluate empty trajectory.");
 
-    if (_t <= nextSegmentStartTime)
-      return std::make_pair(isegment, segmentStartTime);
+  // The cursor walks the segments once for non-decreasing times.
+  SplineCursor cursor(*this);
+  auto state = mStateSpace->createState();
+
+  sampleWith(
+      mStateSpace->getDimension(),
+      _times,
+      _positions,
+      _velocities,
+      _accelerations,
+      [&](double _t, int _order, Eigen::VectorXd& _tangentVector) {
+        if (_order == 0)
+        {
+          cursor.evaluate(_t, state);
+          mStateSpace->logMap(state, _tangentVector);
+        }
+        else
+        {
+          cursor.evaluateDerivative(_t, _order, _tangentVector);
+        }
+      });
+}
 
-    segmentStartTime = nextSegmentStartTime;
+//==============================================================================
+std::pair<std::size_t, double> Spline::getSegmentForTime(double _t) const
+{
+  // A segment contains the times up to and including its end time.
+  const auto containsTime = [&](std::size_t _index) {
+    const auto& segment = mSegments[_index];
+    return (_index == 0 || _t > segment.mStartTime)
+           && (_index + 1 == mSegments.size()
+               || _t <= segment.mStartTime + segment.mDuration);
+  };
+
+  const std::size_t hint = mSegmentHint.load(std::memory_order_relaxed);
+  for (std::size_t isegment = hint;
+       isegment < std::min(hint + 2, mSegments.size());
+       ++isegment)
+  {
+    if (containsTime(isegment))
+    {
+      mSegmentHint.store(isegment, std::memory_order_relaxed);
+      return std::make_pair(isegment, mSegments[isegment].mStartTime);
+    }
   }
 
-  // After the end of the last segment.
-  return std::make_pair(
-      mSegments.size() - 1, segmentStartTime - mSegments.back().mDuration);
+  // Find the first segment that ends at or after _t. Times after the end of
+  // the trajectory belong to the last segment.
+  const auto it = std::lower_bound(
+      mSegments.begin(),
+      mSegments.end() - 1,
+      _t,
+      [](const PolynomialSegment& _segment, double _time) {
+        return _segment.mStartTime + _segment.mDuration < _time;
+      });
+  const auto isegment = static_cast<std::size_t>(it - mSegments.begin());
+
+  mSegmentHint.store(isegment, std::memory_order_relaxed);
+  return std::make_pair(isegment, it->mStartTime);
 }
 
 //==============================================================================
-Eigen::VectorXd Spline::evaluatePolynomial(
-    const Eigen::MatrixXd& _coefficients, double _t, int _derivative)
+void Spline::evaluatePolynomial(
+    const PolynomialSegment& _segment,
+    double _t,
+    int _derivative,
+    Eigen::VectorXd& _out)
 {
-  const auto numOutputs = _coefficients.rows();
-  const auto numCoeffs = _coefficients.cols();
-
-  const auto timeVector
-      = common::SplineProblem<>::createTimeVector(_t, _derivative, numCoeffs);
-  const auto derivativeMatrix
-      = common::SplineProblem<>::createCoefficientMatrix(numCoeffs);
-  const auto derivativeVector = derivativeMatrix.row(_derivative);
-  const auto evaluationVector
-      = derivativeVector.cwiseProduct(timeVector.transpose());
-
-  Eigen::VectorXd outputVector(numOutputs);
+  // Return zero for higher-order derivatives.
+  if (_derivative >= _segment.mCoefficients.cols())
+  {
+    _out.resize(_segment.mCoefficients.rows());
+    _out.setZero();
+    return;
+  }
 
-  for (int ioutput = 0; ioutput < numOutputs; ++ioutput)
-    outputVector[ioutput] = _coefficients.row(ioutput).dot(evaluationVector);
+  const Eigen::MatrixXd& coefficients
+      = _derivative == 0 ? _segment.mCoefficients
+                         : _segment.mDerivativeCoefficients[_derivative - 1];
 
-  return outputVector;
+  // Horner's scheme, evaluated for all dimensions at once.
+  Eigen::Index icoeff = coefficients.cols() - 1;
+  _out = coefficients.col(icoeff);
+  while (icoeff-- > 0)
+    _out = _t * _out + coefficients.col(icoeff);
 }
 
 //==============================================================================
@@ -211,15 +324,15 @@ std::size_t Spline::getNumWaypoints() const
 //==============================================================================
 double Spline::getWaypointTime(std::size_t _index) const
 {
-  double waypointTime = mStartTime;
-
   if (_index >= getNumWaypoints())
     throw std::domain_error("Waypoint index is out of bounds.");
 
-  for (std::size_t i = 0; i < _index; ++i)
-    waypointTime += mSegments[i].mDuration;
+  if (_index == 0)
+    return mStartTime;
 
-  return waypointTime;
+  // Waypoint i > 0 is the end of segment i - 1.
+  const auto& segment = mSegments[_index - 1];
+  return segment.mStartTime + segment.mDuration;
 }
 
 //==============================================================================
@@ -252,5 +365,45 @@ void Spline::getWaypointDerivative(
   }
 }
 
+//==============================================================================
+void Spline::visitWaypoints(const WaypointVisitor& _visitor) const
+{
+  if (mSegments.empty())
+    throw std::logic_error("Unable to evaluate empty trajectory.");
+
+  auto state = mStateSpace->createState();
+  auto relativeState = mStateSpace->createState();
+  Eigen::VectorXd tangentVector;
+  Eigen::VectorXd velocity;
+
+  // Evaluates the segment the same way as evaluate() and evaluateDerivative().
+  const auto evaluateSegment
+      = [&](const PolynomialSegment& _segment, double _evaluationTime) {
+          evaluatePolynomial(_segment, _evaluationTime, 0, tangentVector);
+          mStateSpace->copyState(_segment.mStartState, state);
+          mStateSpace->expMap(tangentVector, relativeState);
+          mStateSpace->compose(state, relativeState);
+
+          evaluatePolynomial(_segment, _evaluationTime, 1, velocity);
+        };
+
+  // The first waypoint is the start of the first segment and every other
+  // waypoint is the end of the segment preceding it.
+  double segmentStartTime = mStartTime;
+  evaluateSegment(mSegments.front(), 0.);
+  _visitor(0, segmentStartTime, state, velocity);
+
+  for (std::size_t isegment = 0; isegment < mSegments.size(); ++isegment)
+  {
+    const auto& segment = mSegments[isegment];
+    const auto waypointTime = segmentStartTime + segment.mDuration;
+
+    evaluateSegment(segment, waypointTime - segmentStartTime);
+    _visitor(isegment + 1, waypointTime, state, velocity);
+
+    segmentStartTime = waypointTime;
+  }
+}
+
 } // namespace trajectory
 } // namespace aikido
@@ -0,0 +1,90 @@
+#include <aikido/trajectory/SplineCursor.hpp>
+
+#include <stdexcept>
+
+namespace aikido {
+namespace trajectory {
+
+//==============================================================================
+SplineCursor::SplineCursor(const Spline& _spline)
+  : mSpline(&_spline)
+  , mValid(false)
+  , mSegmentIndex(0)
+  , mRelativeState(_spline.getStateSpace()->createState())
+{
+  // Do nothing
+}
+
+//==============================================================================
+void SplineCursor::evaluate(double _t, statespace::StateSpace::State* _state)
+{
+  seek(_t);
+
+  const auto& stateSpace = mSpline->mStateSpace;
+  const auto& segment = mSpline->mSegments[mSegmentIndex];
+
+  stateSpace->copyState(segment.mStartState, _state);
+
+  Spline::evaluatePolynomial(
+      segment, _t - segment.mStartTime, 0, mTangentVector);
+  stateSpace->expMap(mTangentVector, mRelativeState);
+  stateSpace->compose(_state, mRelativeState);
+}
+
+//==============================================================================
+void SplineCursor::evaluateDerivative(
+    double _t, int _derivative, Eigen::VectorXd& _tangentVector)
+{
+  if (_derivative < 1)
+    throw std::logic_error("Derivative must be positive.");
+
+  seek(_t);
+
+  const auto& segment = mSpline->mSegments[mSegmentIndex];
+  Spline::evaluatePolynomial(
+      segment, _t - segment.mStartTime, _derivative, _tangentVector);
+}
+
+//==============================================================================
+void SplineCursor::reset()
+{
+  mValid = false;
+}
+
+//==============================================================================
+void SplineCursor::reset(const Spline& _spline)
+{
+  if (_spline.mStateSpace != mSpline->mStateSpace)
+    throw std::invalid_argument("Spline is in a different state space.");
+
+  mSpline = &_spline;
+  mValid = false;
+}
+
+//==============================================================================
+void SplineCursor::seek(double _t)
+{
+  const auto& segments = mSpline->mSegments;
+
+  if (segments.empty())
+    throw std::logic_error("Unable to evaluate empty trajectory.");
+
+  // A time on the boundary belongs to the earlier segment, as in
+  // Spline::getSegmentForTime(), so going back to it needs a new search.
+  if (!mValid
+      || (mSegmentIndex > 0 && _t <= segments[mSegmentIndex].mStartTime))
+  {
+    mSegmentIndex = mSpline->getSegmentForTime(_t).first;
+    mValid = true;
+    return;
+  }
+
+  while (mSegmentIndex + 1 < segments.size()
+         && _t > segments[mSegmentIndex + 1].mStartTime)
+  {
+    ++mSegmentIndex;
+  }
+}
+
+} // namespace trajectory
+} // namespace aikido
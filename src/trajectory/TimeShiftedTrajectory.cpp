@@ -0,0 +1,90 @@
+#include <aikido/trajectory/TimeShiftedTrajectory.hpp>
+
+#include <stdexcept>
+
+namespace aikido {
+namespace trajectory {
+
+//==============================================================================
+TimeShiftedTrajectory::TimeShiftedTrajectory(
+    ConstTrajectoryPtr _trajectory, double _timeOffset)
+  : mTrajectory(std::move(_trajectory)), mTimeOffset(_timeOffset)
+{
+  if (!mTrajectory)
+    throw std::invalid_argument("Trajectory is null.");
+}
+
+//==============================================================================
+ConstTrajectoryPtr TimeShiftedTrajectory::getTrajectory() const
+{
+  return mTrajectory;
+}
+
+//==============================================================================
+double TimeShiftedTrajectory::getTimeOffset() const
+{
+  return mTimeOffset;
+}
+
+//==============================================================================
+statespace::ConstStateSpacePtr TimeShiftedTrajectory::getStateSpace() const
+{
+  return mTrajectory->getStateSpace();
+}
+
+//==============================================================================
+std::size_t TimeShiftedTrajectory::getNumDerivatives() const
+{
+  return mTrajectory->getNumDerivatives();
+}
+
+//==============================================================================
+double TimeShiftedTrajectory::getDuration() const
+{
+  return mTrajectory->getDuration();
+}
+
+//==============================================================================
+double TimeShiftedTrajectory::getStartTime() const
+{
+  return mTrajectory->getStartTime() + mTimeOffset;
+}
+
+//==============================================================================
+double TimeShiftedTrajectory::getEndTime() const
+{
+  return mTrajectory->getEndTime() + mTimeOffset;
+}
+
+//==============================================================================
+void TimeShiftedTrajectory::evaluate(
+    double _t, statespace::StateSpace::State* _state) const
+{
+  mTrajectory->evaluate(_t - mTimeOffset, _state);
+}
+
+//==============================================================================
+void TimeShiftedTrajectory::evaluateDerivative(
+    double _t, int _derivative, Eigen::VectorXd& _tangentVector) const
+{
+  mTrajectory->evaluateDerivative(
+      _t - mTimeOffset, _derivative, _tangentVector);
+}
+
+//==============================================================================
+void TimeShiftedTrajectory::sample(
+    const std::vector<double>& _times,
+    Eigen::MatrixXd* _positions,
+    Eigen::MatrixXd* _velocities,
+    Eigen::MatrixXd* _accelerations) const
+{
+  std::vector<double> times;
+  times.reserve(_times.size());
+  for (const double t : _times)
+    times.push_back(t - mTimeOffset);
+
+  mTrajectory->sample(times, _positions, _velocities, _accelerations);
+}
+
+} // namespace trajectory
+} // namespace aikido
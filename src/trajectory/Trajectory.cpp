@@ -0,0 +1,57 @@
+#include <aikido/trajectory/Trajectory.hpp>
+
+#include <stdexcept>
+
+namespace aikido {
+namespace trajectory {
+
+//==============================================================================
+void Trajectory::sample(
+    const std::vector<double>& _times,
+    Eigen::MatrixXd* _positions,
+    Eigen::MatrixXd* _velocities,
+    Eigen::MatrixXd* _accelerations) const
+{
+  const auto stateSpace = getStateSpace();
+  auto state = stateSpace->createState();
+
+  sampleWith(
+      stateSpace->getDimension(),
+      _times,
+      _positions,
+      _velocities,
+      _accelerations,
+      [&](double _t, int _order, Eigen::VectorXd& _tangentVector) {
+        if (_order == 0)
+        {
+          evaluate(_t, state);
+          stateSpace->logMap(state, _tangentVector);
+        }
+        else
+        {
+          evaluateDerivative(_t, _order, _tangentVector);
+        }
+      });
+}
+
+//==============================================================================
+void Trajectory::sample(
+    double _startTime,
+    double _timeStep,
+    std::size_t _numSamples,
+    Eigen::MatrixXd* _positions,
+    Eigen::MatrixXd* _velocities,
+    Eigen::MatrixXd* _accelerations) const
+{
+  if (_timeStep < 0.)
+    throw std::invalid_argument("Time step must be non-negative.");
+
+  std::vector<double> times(_numSamples);
+  for (std::size_t i = 0; i < _numSamples; ++i)
+    times[i] = _startTime + i * _timeStep;
+
+  sample(times, _positions, _velocities, _accelerations);
+}
+
+} // namespace trajectory
+} // namespace aikido
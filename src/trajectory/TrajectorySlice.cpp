@@ -0,0 +1,102 @@
+#include <aikido/trajectory/TrajectorySlice.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace aikido {
+namespace trajectory {
+
+//==============================================================================
+TrajectorySlice::TrajectorySlice(
+    ConstTrajectoryPtr _trajectory, double _startTime, double _endTime)
+  : mTrajectory(std::move(_trajectory))
+  , mStartTime(_startTime)
+  , mEndTime(_endTime)
+{
+  if (!mTrajectory)
+    throw std::invalid_argument("Trajectory is null.");
+
+  if (mStartTime >= mEndTime)
+    throw std::invalid_argument("Slice is empty.");
+
+  if (mStartTime < mTrajectory->getStartTime()
+      || mEndTime > mTrajectory->getEndTime())
+  {
+    throw std::invalid_argument(
+        "Slice is not contained in the time range of the trajectory.");
+  }
+}
+
+//==============================================================================
+ConstTrajectoryPtr TrajectorySlice::getTrajectory() const
+{
+  return mTrajectory;
+}
+
+//==============================================================================
+statespace::ConstStateSpacePtr TrajectorySlice::getStateSpace() const
+{
+  return mTrajectory->getStateSpace();
+}
+
+//==============================================================================
+std::size_t TrajectorySlice::getNumDerivatives() const
+{
+  return mTrajectory->getNumDerivatives();
+}
+
+//==============================================================================
+double TrajectorySlice::getDuration() const
+{
+  return mEndTime - mStartTime;
+}
+
+//==============================================================================
+double TrajectorySlice::getStartTime() const
+{
+  return mStartTime;
+}
+
+//==============================================================================
+double TrajectorySlice::getEndTime() const
+{
+  return mEndTime;
+}
+
+//==============================================================================
+void TrajectorySlice::evaluate(
+    double _t, statespace::StateSpace::State* _state) const
+{
+  mTrajectory->evaluate(clampTime(_t), _state);
+}
+
+//==============================================================================
+void TrajectorySlice::evaluateDerivative(
+    double _t, int _derivative, Eigen::VectorXd& _tangentVector) const
+{
+  mTrajectory->evaluateDerivative(clampTime(_t), _derivative, _tangentVector);
+}
+
+//==============================================================================
+void TrajectorySlice::sample(
+    const std::vector<double>& _times,
+    Eigen::MatrixXd* _positions,
+    Eigen::MatrixXd* _velocities,
+    Eigen::MatrixXd* _accelerations) const
+{
+  std::vector<double> times;
+  times.reserve(_times.size());
+  for (const double t : _times)
+    times.push_back(clampTime(t));
+
+  mTrajectory->sample(times, _positions, _velocities, _accelerations);
+}
+
+//==============================================================================
+double TrajectorySlice::clampTime(double _t) const
+{
+  return std::min(std::max(_t, mStartTime), mEndTime);
+}
+
+} // namespace trajectory
+} // namespace aikido
@@ -69,3 +69,37 @@ TEST_F(SplineProblemTests, fit_ContinuityConstraints)
   EXPECT_EIGEN_EQUAL(coefficients2, spline.getCoefficients()[1], EPSILON);
 #endif
 }
+
+TEST_F(SplineProblemTests, fitLinearSegment_MatchesSplineProblem)
+{
+  const Eigen::VectorXd displacement = make_vector(1., -3.);
+  const double duration = 0.7;
+
+  SplineProblem problem(make_vector(0., duration), 2, 2);
+  problem.addConstantConstraint(0, 0, make_vector(0., 0.));
+  problem.addConstantConstraint(1, 0, displacement);
+  SplineProblem::Spline spline = problem.fit();
+
+  const Eigen::MatrixXd coefficients
+      = aikido::common::fitLinearSegment(displacement, duration);
+  EXPECT_EIGEN_EQUAL(spline.getCoefficients()[0], coefficients, EPSILON);
+}
+
+TEST_F(SplineProblemTests, fitCubicHermiteSegment_MatchesSplineProblem)
+{
+  const Eigen::VectorXd displacement = make_vector(1., -3.);
+  const Eigen::VectorXd startVelocity = make_vector(0.5, 2.);
+  const Eigen::VectorXd endVelocity = make_vector(-1., 0.);
+  const double duration = 1.3;
+
+  SplineProblem problem(make_vector(0., duration), 4, 2);
+  problem.addConstantConstraint(0, 0, make_vector(0., 0.));
+  problem.addConstantConstraint(0, 1, startVelocity);
+  problem.addConstantConstraint(1, 0, displacement);
+  problem.addConstantConstraint(1, 1, endVelocity);
+  SplineProblem::Spline spline = problem.fit();
+
+  const Eigen::MatrixXd coefficients = aikido::common::fitCubicHermiteSegment(
+      displacement, startVelocity, endVelocity, duration);
+  EXPECT_EIGEN_EQUAL(spline.getCoefficients()[0], coefficients, EPSILON);
+}
@@ -0,0 +1,125 @@
+#include <dart/dart.hpp>
+#include <gtest/gtest.h>
+#include <aikido/constraint/dart/CollisionClearance.hpp>
+#include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
+
+using aikido::statespace::dart::MetaSkeletonStateSpace;
+using aikido::statespace::dart::MetaSkeletonStateSpacePtr;
+using aikido::constraint::dart::CollisionClearance;
+
+using namespace dart::dynamics;
+using namespace dart::collision;
+
+class CollisionClearanceTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Cube that slides along the x-axis.
+    mSlider = Skeleton::create("Slider");
+    PrismaticJoint::Properties properties;
+    properties.mAxis = Eigen::Vector3d::UnitX();
+    properties.mName = "Joint1";
+    auto sliderNode
+        = mSlider
+              ->createJointAndBodyNodePair<PrismaticJoint>(nullptr, properties)
+              .second;
+    std::shared_ptr<BoxShape> sliderShape(
+        new BoxShape(Eigen::Vector3d::Constant(0.2)));
+    sliderNode
+        ->createShapeNodeWith<VisualAspect, CollisionAspect, DynamicsAspect>(
+            sliderShape);
+
+    // Fixed cube whose closest face is 0.65 away from the slider.
+    mObstacle = Skeleton::create("Obstacle");
+    WeldJoint::Properties weldProperties;
+    weldProperties.mT_ParentBodyToJoint.translation()
+        = Eigen::Vector3d(1., 0., 0.);
+    auto obstacleNode
+        = mObstacle
+              ->createJointAndBodyNodePair<WeldJoint>(nullptr, weldProperties)
+              .second;
+    std::shared_ptr<BoxShape> obstacleShape(
+        new BoxShape(Eigen::Vector3d::Constant(0.5)));
+    obstacleNode
+        ->createShapeNodeWith<VisualAspect, CollisionAspect, DynamicsAspect>(
+            obstacleShape);
+
+    mCollisionDetector = FCLCollisionDetector::create();
+    mSliderGroup = mCollisionDetector->createCollisionGroup(sliderNode);
+    mObstacleGroup = mCollisionDetector->createCollisionGroup(obstacleNode);
+
+    mStateSpace = std::make_shared<MetaSkeletonStateSpace>(mSlider.get());
+  }
+
+  SkeletonPtr mSlider, mObstacle;
+  CollisionDetectorPtr mCollisionDetector;
+  std::shared_ptr<CollisionGroup> mSliderGroup;
+  std::shared_ptr<CollisionGroup> mObstacleGroup;
+  MetaSkeletonStateSpacePtr mStateSpace;
+};
+
+TEST_F(CollisionClearanceTest, Constructor_InvalidArguments_Throws)
+{
+  const Eigen::VectorXd bounds = Eigen::VectorXd::Ones(1);
+
+  EXPECT_THROW(
+      CollisionClearance(nullptr, mSlider, mCollisionDetector, bounds),
+      std::invalid_argument);
+  EXPECT_THROW(
+      CollisionClearance(mStateSpace, nullptr, mCollisionDetector, bounds),
+      std::invalid_argument);
+  EXPECT_THROW(
+      CollisionClearance(mStateSpace, mSlider, nullptr, bounds),
+      std::invalid_argument);
+  EXPECT_THROW(
+      CollisionClearance(
+          mStateSpace, mSlider, mCollisionDetector, Eigen::VectorXd::Ones(2)),
+      std::invalid_argument);
+  EXPECT_THROW(
+      CollisionClearance(
+          mStateSpace, mSlider, mCollisionDetector, -Eigen::VectorXd::Ones(1)),
+      std::invalid_argument);
+}
+
+TEST_F(CollisionClearanceTest, NoChecks_InfiniteClearance)
+{
+  CollisionClearance clearance(
+      mStateSpace, mSlider, mCollisionDetector, Eigen::VectorXd::Ones(1));
+  EXPECT_EQ(mStateSpace, clearance.getStateSpace());
+
+  auto state = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(Eigen::VectorXd::Zero(1), state);
+  EXPECT_TRUE(std::isinf(clearance.getClearance(state)));
+}
+
+TEST_F(CollisionClearanceTest, PairwiseCheck_DistanceOverDisplacementBound)
+{
+  CollisionClearance clearance(
+      mStateSpace,
+      mSlider,
+      mCollisionDetector,
+      Eigen::VectorXd::Constant(1, 2.));
+  clearance.addPairwiseCheck(mSliderGroup, mObstacleGroup);
+
+  auto state = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(Eigen::VectorXd::Zero(1), state);
+  EXPECT_NEAR(0.65, clearance.getDistance(state), 1e-6);
+  EXPECT_NEAR(0.325, clearance.getClearance(state), 1e-6);
+
+  // Sliding by less than the clearance cannot cause a collision.
+  mStateSpace->convertPositionsToState(
+      Eigen::VectorXd::Constant(1, 0.3), state);
+  EXPECT_NEAR(0.35, clearance.getDistance(state), 1e-6);
+}
+
+TEST_F(CollisionClearanceTest, InCollision_ZeroClearance)
+{
+  CollisionClearance clearance(
+      mStateSpace, mSlider, mCollisionDetector, Eigen::VectorXd::Ones(1));
+  clearance.addPairwiseCheck(mSliderGroup, mObstacleGroup);
+
+  auto state = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(Eigen::VectorXd::Constant(1, 1.), state);
+  EXPECT_DOUBLE_EQ(0., clearance.getClearance(state));
+}
@@ -0,0 +1,198 @@
+#include <fstream>
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+#include <aikido/io/TrajectoryFile.hpp>
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SE2.hpp>
+#include <aikido/statespace/SO2.hpp>
+
+using namespace aikido::statespace;
+using aikido::io::readTrajectory;
+using aikido::io::writeTrajectory;
+using aikido::trajectory::Interpolated;
+using aikido::trajectory::Spline;
+using aikido::trajectory::Trajectory;
+using Eigen::Vector3d;
+
+class TrajectoryFileTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    mStateSpace = std::make_shared<CartesianProduct>(
+        std::vector<StateSpacePtr>{std::make_shared<R2>(),
+                                   std::make_shared<SO2>()});
+
+    mPath = (boost::filesystem::temp_directory_path()
+             / boost::filesystem::unique_path("aikido-%%%%-%%%%.traj"))
+                .string();
+  }
+
+  void TearDown() override
+  {
+    boost::filesystem::remove(mPath);
+  }
+
+  void expectEqual(
+      const Trajectory& expected,
+      const Trajectory& actual,
+      const std::vector<double>& times)
+  {
+    EXPECT_EQ(expected.getNumDerivatives(), actual.getNumDerivatives());
+    EXPECT_DOUBLE_EQ(expected.getStartTime(), actual.getStartTime());
+    EXPECT_DOUBLE_EQ(expected.getEndTime(), actual.getEndTime());
+    EXPECT_DOUBLE_EQ(expected.getDuration(), actual.getDuration());
+
+    auto expectedState = mStateSpace->createState();
+    auto actualState = mStateSpace->createState();
+    Eigen::VectorXd expectedVector, actualVector;
+
+    for (double t : times)
+    {
+      expected.evaluate(t, expectedState);
+      actual.evaluate(t, actualState);
+      mStateSpace->logMap(expectedState, expectedVector);
+      mStateSpace->logMap(actualState, actualVector);
+      EXPECT_TRUE(expectedVector.isApprox(actualVector)) << t;
+
+      for (int derivative = 1; derivative <= 3; ++derivative)
+      {
+        expected.evaluateDerivative(t, derivative, expectedVector);
+        actual.evaluateDerivative(t, derivative, actualVector);
+        EXPECT_TRUE(expectedVector.isApprox(actualVector))
+            << t << " " << derivative;
+      }
+    }
+  }
+
+  std::shared_ptr<CartesianProduct> mStateSpace;
+  std::string mPath;
+};
+
+TEST_F(TrajectoryFileTest, Spline_RoundTrip)
+{
+  Eigen::Matrix<double, 3, 3> coefficients1;
+  coefficients1 << 0., 1., 2., 1., -1., 0.5, 0.5, 0., 1.;
+  Eigen::Matrix<double, 3, 4> coefficients2;
+  coefficients2 << 1., 0., 0., 1., 0., 2., 1., -1., 0.25, 1., 0., 3.;
+
+  auto state = mStateSpace->createState();
+  mStateSpace->expMap(Vector3d(1., 2., 3.), state);
+
+  Spline spline(mStateSpace, 2.);
+  spline.addSegment(coefficients1, 1., state);
+  mStateSpace->expMap(Vector3d(-1., 0., -3.), state);
+  spline.addSegment(coefficients2, 0.5, state);
+
+  writeTrajectory(mPath, spline);
+  const auto trajectory = readTrajectory(mPath, mStateSpace);
+
+  expectEqual(spline, *trajectory, {1., 2., 2.5, 3., 3.25, 3.5, 4.});
+}
+
+TEST_F(TrajectoryFileTest, Interpolated_RoundTrip)
+{
+  Interpolated interpolated(
+      mStateSpace, std::make_shared<GeodesicInterpolator>(mStateSpace));
+
+  auto state = mStateSpace->createState();
+  mStateSpace->expMap(Vector3d(0., 0., 0.), state);
+  interpolated.addWaypoint(1., state);
+  mStateSpace->expMap(Vector3d(3., 3., 1.), state);
+  interpolated.addWaypoint(3., state);
+  mStateSpace->expMap(Vector3d(8., 1., -2.), state);
+  interpolated.addWaypoint(7., state);
+
+  writeTrajectory(mPath, interpolated);
+  const auto trajectory = readTrajectory(mPath, mStateSpace);
+
+  // The derivatives of the interpolated trajectory drop to zero at its first
+  // waypoint and outside of its waypoints.
+  expectEqual(interpolated, *trajectory, {1.5, 2., 3., 6., 7.});
+}
+
+TEST_F(TrajectoryFileTest, Interpolated_FollowsGeodesic)
+{
+  Interpolated interpolated(
+      mStateSpace, std::make_shared<GeodesicInterpolator>(mStateSpace));
+
+  // The geodesic in SO2 wraps around instead of passing through zero.
+  auto state = mStateSpace->createState();
+  mStateSpace->expMap(Vector3d(0., 0., 3.), state);
+  interpolated.addWaypoint(0., state);
+  mStateSpace->expMap(Vector3d(1., 1., -3.), state);
+  interpolated.addWaypoint(1., state);
+
+  writeTrajectory(mPath, interpolated);
+  const auto trajectory = readTrajectory(mPath, mStateSpace);
+
+  expectEqual(interpolated, *trajectory, {0.25, 0.5, 0.75, 1.});
+}
+
+TEST_F(TrajectoryFileTest, Interpolated_SingleWaypoint_Throws)
+{
+  Interpolated interpolated(
+      mStateSpace, std::make_shared<GeodesicInterpolator>(mStateSpace));
+
+  auto state = mStateSpace->createState();
+  mStateSpace->getIdentity(state);
+  interpolated.addWaypoint(1., state);
+
+  EXPECT_THROW(writeTrajectory(mPath, interpolated), std::invalid_argument);
+}
+
+TEST_F(TrajectoryFileTest, EmptySpline_RoundTrip)
+{
+  Spline spline(mStateSpace, 2.);
+
+  writeTrajectory(mPath, spline);
+  const auto trajectory = readTrajectory(mPath, mStateSpace);
+
+  auto state = mStateSpace->createState();
+  EXPECT_DOUBLE_EQ(2., trajectory->getStartTime());
+  EXPECT_DOUBLE_EQ(0., trajectory->getDuration());
+  EXPECT_THROW(trajectory->evaluate(2., state), std::logic_error);
+}
+
+TEST_F(TrajectoryFileTest, UnsupportedStateSpace_Throws)
+{
+  auto stateSpace = std::make_shared<SE2>();
+  Spline spline(stateSpace, 0.);
+
+  EXPECT_THROW(writeTrajectory(mPath, spline), std::invalid_argument);
+}
+
+TEST_F(TrajectoryFileTest, DifferentStateSpace_Throws)
+{
+  Spline spline(mStateSpace, 0.);
+  writeTrajectory(mPath, spline);
+
+  EXPECT_THROW(
+      readTrajectory(mPath, std::make_shared<R3>()), std::invalid_argument);
+  EXPECT_THROW(
+      readTrajectory(mPath, std::make_shared<R2>()), std::invalid_argument);
+}
+
+TEST_F(TrajectoryFileTest, MalformedFile_Throws)
+{
+  EXPECT_THROW(readTrajectory(mPath, mStateSpace), std::runtime_error);
+
+  {
+    std::ofstream file(mPath, std::ios::binary);
+    file << "This is not a trajectory file, but it is long enough to have a "
+            "header.";
+  }
+  EXPECT_THROW(readTrajectory(mPath, mStateSpace), std::runtime_error);
+
+  // Truncate a valid file.
+  auto state = mStateSpace->createState();
+  mStateSpace->getIdentity(state);
+  Spline spline(mStateSpace, 0.);
+  spline.addSegment(Eigen::Matrix3d::Identity(), 1., state);
+  writeTrajectory(mPath, spline);
+  const auto fileSize = boost::filesystem::file_size(mPath);
+  boost::filesystem::resize_file(mPath, fileSize - 8);
+  EXPECT_THROW(readTrajectory(mPath, mStateSpace), std::runtime_error);
+}
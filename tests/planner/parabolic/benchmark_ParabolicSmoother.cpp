@@ -0,0 +1,206 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <aikido/common/RNG.hpp>
+#include <aikido/constraint/DefaultTestableOutcome.hpp>
+#include <aikido/constraint/Testable.hpp>
+#include <aikido/planner/parabolic/ParabolicSmoother.hpp>
+#include <aikido/planner/parabolic/ParabolicTimer.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+
+// Measures how many shortcut iterations doShortcut tries per second on a
+// 7-DOF path with 200 waypoints. The constraint is cheap, so the time is
+// dominated by the smoother and its feasibility checker. Not registered as a
+// test; run it manually:
+//
+//   benchmark_ParabolicSmoother [timelimit] [threads]
+//
+// With more than one thread, the parallel overload of doShortcut is used and
+// an iteration is one sampled shortcut candidate.
+
+using aikido::constraint::DefaultTestableOutcome;
+using aikido::constraint::TestableOutcome;
+using aikido::statespace::GeodesicInterpolator;
+using aikido::statespace::Rn;
+using aikido::statespace::StateSpace;
+using aikido::statespace::StateSpacePtr;
+using aikido::trajectory::Interpolated;
+
+namespace {
+
+constexpr int kDimension = 7;
+constexpr int kNumWaypoints = 200;
+constexpr double kCheckResolution = 1e-3;
+
+/// Wall across the first axis, with openings along the second axis. The
+/// waypoints weave through the openings, so most shortcuts collide.
+class SlalomConstraint : public aikido::constraint::Testable
+{
+public:
+  explicit SlalomConstraint(StateSpacePtr _stateSpace)
+    : mStateSpace(std::move(_stateSpace)), mNumChecks(0)
+  {
+  }
+
+  bool isSatisfied(
+      const StateSpace::State* _state,
+      TestableOutcome* _outcome = nullptr) const override
+  {
+    ++mNumChecks;
+
+    mStateSpace->logMap(_state, mPosition);
+    const bool satisfied = mPosition[0] < 0.1 || mPosition[0] > 0.9
+                           || std::fmod(mPosition[1], 1.) > 0.5;
+
+    auto outcome
+        = aikido::constraint::dynamic_cast_or_throw<DefaultTestableOutcome>(
+            _outcome);
+    if (outcome)
+      outcome->setSatisfiedFlag(satisfied);
+    return satisfied;
+  }
+
+  std::unique_ptr<TestableOutcome> createOutcome() const override
+  {
+    return std::unique_ptr<TestableOutcome>(new DefaultTestableOutcome);
+  }
+
+  StateSpacePtr getStateSpace() const override
+  {
+    return mStateSpace;
+  }
+
+  std::size_t getNumChecks() const
+  {
+    return mNumChecks;
+  }
+
+private:
+  StateSpacePtr mStateSpace;
+  mutable Eigen::VectorXd mPosition;
+  mutable std::size_t mNumChecks;
+};
+
+/// Random number generator that counts how many numbers it generated.
+class CountingRNG : public aikido::common::RNGWrapper<std::mt19937>
+{
+public:
+  explicit CountingRNG(result_type _seed)
+    : aikido::common::RNGWrapper<std::mt19937>(_seed), mNumCalls(0)
+  {
+  }
+
+  result_type operator()() override
+  {
+    ++mNumCalls;
+    return aikido::common::RNGWrapper<std::mt19937>::operator()();
+  }
+
+  std::size_t getNumCalls() const
+  {
+    return mNumCalls;
+  }
+
+private:
+  std::size_t mNumCalls;
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const double timelimit = (argc > 1) ? std::atof(argv[1]) : 3.;
+  const int numThreads = (argc > 2) ? std::atoi(argv[2]) : 1;
+  if (numThreads < 1)
+  {
+    std::cerr << "threads must be positive" << std::endl;
+    return 1;
+  }
+
+  auto stateSpace = std::make_shared<Rn>(kDimension);
+  auto interpolator = std::make_shared<GeodesicInterpolator>(stateSpace);
+
+  Interpolated path(stateSpace, interpolator);
+  auto state = stateSpace->createState();
+  Eigen::VectorXd position(kDimension);
+  for (int i = 0; i < kNumWaypoints; ++i)
+  {
+    position.setConstant(0.01 * i);
+    position[0] = (i / 2) % 2;
+    position[1] = 0.5 * i + 0.75;
+    stateSpace->setValue(state, position);
+    path.addWaypoint(i, state);
+  }
+
+  const Eigen::VectorXd maxVelocity = Eigen::VectorXd::Constant(kDimension, 2.);
+  const Eigen::VectorXd maxAcceleration
+      = Eigen::VectorXd::Constant(kDimension, 2.);
+  auto timedPath = aikido::planner::parabolic::computeParabolicTiming(
+      path, maxVelocity, maxAcceleration);
+
+  // Each iteration samples the two ends of a shortcut. Find out how many
+  // numbers that takes from the generator.
+  CountingRNG probe(0);
+  std::uniform_real_distribution<> distribution(0., 1.);
+  distribution(probe);
+  distribution(probe);
+  const std::size_t numCallsPerIteration = probe.getNumCalls();
+
+  std::vector<std::shared_ptr<SlalomConstraint>> constraints;
+  std::vector<aikido::constraint::TestablePtr> testables;
+  for (int i = 0; i < numThreads; ++i)
+  {
+    constraints.emplace_back(std::make_shared<SlalomConstraint>(stateSpace));
+    testables.emplace_back(constraints.back());
+  }
+  CountingRNG rng(0);
+
+  const auto startTime = std::chrono::steady_clock::now();
+  std::unique_ptr<aikido::trajectory::Spline> smoothedPath;
+  if (numThreads == 1)
+  {
+    smoothedPath = aikido::planner::parabolic::doShortcut(
+        *timedPath,
+        testables.front(),
+        maxVelocity,
+        maxAcceleration,
+        rng,
+        timelimit,
+        kCheckResolution);
+  }
+  else
+  {
+    smoothedPath = aikido::planner::parabolic::doShortcut(
+        *timedPath,
+        testables,
+        maxVelocity,
+        maxAcceleration,
+        rng,
+        timelimit,
+        kCheckResolution);
+  }
+  const double elapsed = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - startTime)
+                             .count();
+
+  const double numIterations
+      = static_cast<double>(rng.getNumCalls()) / numCallsPerIteration;
+  std::size_t numChecks = 0;
+  for (const auto& constraint : constraints)
+    numChecks += constraint->getNumChecks();
+
+  std::cout << "threads: " << numThreads << ", timelimit: " << timelimit
+            << " s, waypoints: " << kNumWaypoints
+            << ", dimension: " << kDimension << "\n"
+            << "duration: " << timedPath->getDuration() << " s -> "
+            << smoothedPath->getDuration() << " s\n"
+            << "shortcut iterations per second: " << numIterations / elapsed
+            << "\n"
+            << "constraint checks per second: "
+            << numChecks / elapsed << std::endl;
+  return 0;
+}
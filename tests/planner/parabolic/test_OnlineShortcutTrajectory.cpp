@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+#include <aikido/constraint/Clearance.hpp>
+#include <aikido/constraint/Satisfied.hpp>
+#include <aikido/planner/parabolic/OnlineShortcutTrajectory.hpp>
+#include <aikido/planner/parabolic/ParabolicTimer.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include "../../constraint/MockConstraints.hpp"
+
+using Eigen::Vector2d;
+using aikido::trajectory::Interpolated;
+using aikido::trajectory::Spline;
+using aikido::statespace::GeodesicInterpolator;
+using aikido::statespace::R2;
+using aikido::constraint::Satisfied;
+using aikido::planner::parabolic::computeParabolicTiming;
+using aikido::planner::parabolic::OnlineShortcutTrajectory;
+
+/// Unconstrained R2 that counts how often it is queried for its clearance.
+class FreeSpace : public Satisfied, public aikido::constraint::Clearance
+{
+public:
+  explicit FreeSpace(std::shared_ptr<R2> _stateSpace)
+    : Satisfied(_stateSpace), mNumClearanceQueries(0)
+  {
+  }
+
+  double getClearance(
+      const aikido::statespace::StateSpace::State* /*_state*/) const override
+  {
+    ++mNumClearanceQueries;
+    return 1e3;
+  }
+
+  aikido::statespace::StateSpacePtr getStateSpace() const override
+  {
+    return Satisfied::getStateSpace();
+  }
+
+  mutable int mNumClearanceQueries;
+};
+
+class OnlineShortcutTrajectoryTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    mRng = aikido::common::RNGWrapper<std::mt19937>(0);
+    mStateSpace = std::make_shared<R2>();
+    mMaxVelocity = Vector2d(20., 20.);
+    mMaxAcceleration = Vector2d(10., 10.);
+
+    auto interpolator = std::make_shared<GeodesicInterpolator>(mStateSpace);
+    Interpolated path(mStateSpace, interpolator);
+
+    // Parabolic timing stops at each of these waypoints, so there is plenty
+    // of time to save by shortcutting.
+    auto state = mStateSpace->createState();
+    for (int i = 0; i < 8; ++i)
+    {
+      state.setValue(Vector2d(0.5 * i, 0.2 * (i % 2)));
+      path.addWaypoint(i, state);
+    }
+
+    mTimedPath = computeParabolicTiming(path, mMaxVelocity, mMaxAcceleration);
+    mEndValue = Vector2d(3.5, 0.2);
+  }
+
+  std::unique_ptr<OnlineShortcutTrajectory> createTrajectory(
+      aikido::constraint::TestablePtr _testable,
+      double _leadTime,
+      double _timelimit,
+      aikido::constraint::ClearancePtr _clearance = nullptr)
+  {
+    return std::unique_ptr<OnlineShortcutTrajectory>(
+        new OnlineShortcutTrajectory(
+            *mTimedPath,
+            std::move(_testable),
+            mMaxVelocity,
+            mMaxAcceleration,
+            mRng,
+            _leadTime,
+            _timelimit,
+            aikido::planner::parabolic::DEFAULT_CHECK_RESOLUTION,
+            aikido::planner::parabolic::DEFAULT_TOLERANCE,
+            std::move(_clearance)));
+  }
+
+  aikido::common::RNGWrapper<std::mt19937> mRng;
+  std::shared_ptr<R2> mStateSpace;
+  Vector2d mMaxVelocity;
+  Vector2d mMaxAcceleration;
+  std::unique_ptr<Spline> mTimedPath;
+  Vector2d mEndValue;
+};
+
+TEST_F(OnlineShortcutTrajectoryTests, InvalidArguments_Throws)
+{
+  EXPECT_THROW(createTrajectory(nullptr, 0.1, 1.), std::invalid_argument);
+
+  auto testable = std::make_shared<Satisfied>(mStateSpace);
+  EXPECT_THROW(createTrajectory(testable, -0.1, 1.), std::invalid_argument);
+  EXPECT_THROW(createTrajectory(testable, 0.1, -1.), std::invalid_argument);
+}
+
+TEST_F(OnlineShortcutTrajectoryTests, StartTwice_Throws)
+{
+  auto trajectory = createTrajectory(
+      std::make_shared<Satisfied>(mStateSpace), 0.1, 0.01);
+
+  trajectory->start();
+  EXPECT_THROW(trajectory->start(), std::logic_error);
+  trajectory->stop();
+}
+
+TEST_F(OnlineShortcutTrajectoryTests, NotStarted_MatchesInput)
+{
+  auto trajectory = createTrajectory(
+      std::make_shared<Satisfied>(mStateSpace), 0.1, 1.);
+
+  EXPECT_EQ(0u, trajectory->getNumShortcuts());
+  EXPECT_DOUBLE_EQ(mTimedPath->getStartTime(), trajectory->getStartTime());
+  EXPECT_NEAR(mTimedPath->getEndTime(), trajectory->getEndTime(), 1e-6);
+
+  auto state = mStateSpace->createState();
+  auto expected = mStateSpace->createState();
+  for (double t = mTimedPath->getStartTime(); t < mTimedPath->getEndTime();
+       t += 0.05)
+  {
+    trajectory->evaluate(t, state);
+    mTimedPath->evaluate(t, expected);
+    EXPECT_TRUE(expected.getValue().isApprox(state.getValue(), 1e-6));
+  }
+}
+
+TEST_F(OnlineShortcutTrajectoryTests, ShortcutsSuffix_PrefixUnchanged)
+{
+  const double leadTime = 1.;
+  auto trajectory = createTrajectory(
+      std::make_shared<Satisfied>(mStateSpace), leadTime, 0.2);
+
+  auto original = trajectory->getSpline();
+  trajectory->start();
+  trajectory->wait();
+
+  EXPECT_LT(0u, trajectory->getNumShortcuts());
+  EXPECT_LT(trajectory->getDuration(), original->getDuration());
+
+  // Nothing before the lead time changes, since that part of the trajectory
+  // may be executing.
+  auto state = mStateSpace->createState();
+  auto expected = mStateSpace->createState();
+  for (double t = original->getStartTime();
+       t <= original->getStartTime() + leadTime;
+       t += 0.01)
+  {
+    trajectory->evaluate(t, state);
+    original->evaluate(t, expected);
+    EXPECT_TRUE(expected.getValue().isApprox(state.getValue()));
+  }
+
+  trajectory->evaluate(trajectory->getEndTime(), state);
+  EXPECT_TRUE(mEndValue.isApprox(state.getValue()));
+
+  // Snapshots are not modified by later shortcuts.
+  EXPECT_NE(original, trajectory->getSpline());
+}
+
+TEST_F(OnlineShortcutTrajectoryTests, Clearance_ShortcutsAreContinuous)
+{
+  auto freeSpace = std::make_shared<FreeSpace>(mStateSpace);
+  auto trajectory = createTrajectory(freeSpace, 0.5, 0.2, freeSpace);
+
+  trajectory->start();
+  trajectory->wait();
+
+  EXPECT_LT(0u, trajectory->getNumShortcuts());
+  EXPECT_LT(0, freeSpace->mNumClearanceQueries);
+
+  // The segments spliced in after each shortcut join the ones they follow.
+  const double dt = 1e-3;
+  auto state = mStateSpace->createState();
+  trajectory->evaluate(trajectory->getStartTime(), state);
+  Vector2d previous = state.getValue();
+  for (double t = trajectory->getStartTime() + dt;
+       t <= trajectory->getEndTime();
+       t += dt)
+  {
+    trajectory->evaluate(t, state);
+    EXPECT_GE(
+        mMaxVelocity[0] * dt + 1e-6,
+        (state.getValue() - previous).lpNorm<Eigen::Infinity>());
+    previous = state.getValue();
+  }
+
+  trajectory->evaluate(trajectory->getEndTime(), state);
+  EXPECT_TRUE(mEndValue.isApprox(state.getValue()));
+}
+
+TEST_F(OnlineShortcutTrajectoryTests, LeadTimePastEnd_NoShortcuts)
+{
+  auto trajectory = createTrajectory(
+      std::make_shared<Satisfied>(mStateSpace),
+      mTimedPath->getDuration() + 1.,
+      1.);
+
+  trajectory->start();
+  trajectory->wait();
+
+  EXPECT_EQ(0u, trajectory->getNumShortcuts());
+  EXPECT_NEAR(mTimedPath->getDuration(), trajectory->getDuration(), 1e-6);
+}
+
+TEST_F(OnlineShortcutTrajectoryTests, InfeasibleShortcuts_NoShortcuts)
+{
+  auto trajectory = createTrajectory(
+      std::make_shared<FailingConstraint>(mStateSpace), 0., 0.05);
+
+  trajectory->start();
+  trajectory->wait();
+
+  EXPECT_EQ(0u, trajectory->getNumShortcuts());
+  EXPECT_NEAR(mTimedPath->getDuration(), trajectory->getDuration(), 1e-6);
+}
+
+TEST_F(OnlineShortcutTrajectoryTests, Stop_KeepsShortcuts)
+{
+  auto trajectory = createTrajectory(
+      std::make_shared<Satisfied>(mStateSpace), 0., 60.);
+
+  trajectory->start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  trajectory->stop();
+
+  const auto numShortcuts = trajectory->getNumShortcuts();
+  const auto duration = trajectory->getDuration();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(numShortcuts, trajectory->getNumShortcuts());
+  EXPECT_DOUBLE_EQ(duration, trajectory->getDuration());
+
+  auto state = mStateSpace->createState();
+  trajectory->evaluate(trajectory->getEndTime(), state);
+  EXPECT_TRUE(mEndValue.isApprox(state.getValue()));
+}
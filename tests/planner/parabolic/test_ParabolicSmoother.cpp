@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <aikido/common/StepSequence.hpp>
+#include <aikido/constraint/Clearance.hpp>
 #include <aikido/constraint/Satisfied.hpp>
 #include <aikido/planner/parabolic/ParabolicSmoother.hpp>
 #include <aikido/planner/parabolic/ParabolicTimer.hpp>
@@ -20,12 +21,80 @@ using aikido::statespace::SO2;
 using aikido::statespace::SO3;
 using aikido::statespace::StateSpacePtr;
 using aikido::constraint::Satisfied;
+using aikido::constraint::DefaultTestableOutcome;
+using aikido::constraint::TestableOutcome;
 using aikido::planner::parabolic::computeParabolicTiming;
 using aikido::planner::parabolic::convertToSpline;
 using aikido::planner::parabolic::doShortcut;
 using aikido::planner::parabolic::doBlend;
 using aikido::planner::parabolic::doShortcutAndBlend;
 
+/// Disk obstacle in R2 that counts how often it is tested and queried for
+/// its clearance.
+class DiskObstacle : public aikido::constraint::Testable,
+                     public aikido::constraint::Clearance
+{
+public:
+  DiskObstacle(
+      StateSpacePtr _stateSpace, const Vector2d& _center, double _radius)
+    : mNumChecks(0)
+    , mNumClearanceQueries(0)
+    , mStateSpace(std::move(_stateSpace))
+    , mCenter(_center)
+    , mRadius(_radius)
+  {
+  }
+
+  bool isSatisfied(
+      const aikido::statespace::StateSpace::State* _state,
+      TestableOutcome* _outcome = nullptr) const override
+  {
+    ++mNumChecks;
+    const bool satisfied = getDistance(_state) > 0.;
+
+    auto outcome
+        = aikido::constraint::dynamic_cast_or_throw<DefaultTestableOutcome>(
+            _outcome);
+    if (outcome)
+      outcome->setSatisfiedFlag(satisfied);
+    return satisfied;
+  }
+
+  std::unique_ptr<TestableOutcome> createOutcome() const override
+  {
+    return std::unique_ptr<TestableOutcome>(new DefaultTestableOutcome);
+  }
+
+  double getClearance(
+      const aikido::statespace::StateSpace::State* _state) const override
+  {
+    ++mNumClearanceQueries;
+
+    // The largest square centered at the state that fits outside the disk.
+    return std::max(0., getDistance(_state) / std::sqrt(2.));
+  }
+
+  StateSpacePtr getStateSpace() const override
+  {
+    return mStateSpace;
+  }
+
+  double getDistance(const aikido::statespace::StateSpace::State* _state) const
+  {
+    Eigen::VectorXd position;
+    mStateSpace->logMap(_state, position);
+    return (position - mCenter).norm() - mRadius;
+  }
+
+  mutable int mNumChecks;
+  mutable int mNumClearanceQueries;
+
+private:
+  StateSpacePtr mStateSpace;
+  Vector2d mCenter;
+  double mRadius;
+};
+
 class ParabolicSmootherTests : public ::testing::Test
 {
 public:
@@ -321,3 +390,323 @@ TEST_F(ParabolicSmootherTests, doShortcutAndBlend)
   double shortenTime = smoothedTrajectory->getDuration();
   EXPECT_TRUE(shortenTime < originTime);
 }
+
+TEST_F(ParabolicSmootherTests, doShortcutParallel)
+{
+  std::vector<aikido::constraint::TestablePtr> testables;
+  for (int i = 0; i < 4; ++i)
+    testables.emplace_back(std::make_shared<Satisfied>(mStateSpace));
+
+  auto splineTrajectory = computeParabolicTiming(
+      *mNonStraightLine, mMaxVelocity, mMaxAcceleration);
+  auto smoothedTrajectory = doShortcut(
+      *splineTrajectory.get(),
+      testables,
+      mMaxVelocity,
+      mMaxAcceleration,
+      mRng,
+      mTimelimit);
+
+  // Position.
+  auto state = mStateSpace->createState();
+  smoothedTrajectory->evaluate(smoothedTrajectory->getStartTime(), state);
+  auto startState = mStateSpace->createState();
+  mNonStraightLine->evaluate(mNonStraightLine->getStartTime(), startState);
+  EXPECT_EIGEN_EQUAL(startState.getValue(), state.getValue(), mTolerance);
+
+  smoothedTrajectory->evaluate(smoothedTrajectory->getEndTime(), state);
+  auto goalState = mStateSpace->createState();
+  mNonStraightLine->evaluate(mNonStraightLine->getEndTime(), goalState);
+  EXPECT_EIGEN_EQUAL(goalState.getValue(), state.getValue(), mTolerance);
+
+  double shortenLength = getLength(smoothedTrajectory.get());
+  EXPECT_TRUE(shortenLength < mNonStraightLineLength);
+
+  double originTime = splineTrajectory->getDuration();
+  double shortenTime = smoothedTrajectory->getDuration();
+  EXPECT_TRUE(shortenTime < originTime);
+}
+
+TEST_F(ParabolicSmootherTests, doShortcutParallel_WithObstacle_AvoidsObstacle)
+{
+  // The obstacle is off the input path, but blocks shortcuts between nearby
+  // waypoints, so some of the candidates checked concurrently are rejected.
+  const Vector2d center(2.5, 1.7);
+  const double radius = 0.2;
+
+  // Each thread gets its own testable and clearance.
+  std::vector<std::shared_ptr<DiskObstacle>> obstacles;
+  std::vector<aikido::constraint::TestablePtr> testables;
+  std::vector<aikido::constraint::ClearancePtr> clearances;
+  for (int i = 0; i < 4; ++i)
+  {
+    obstacles.emplace_back(
+        std::make_shared<DiskObstacle>(mStateSpace, center, radius));
+    testables.emplace_back(obstacles.back());
+    clearances.emplace_back(obstacles.back());
+  }
+
+  auto splineTrajectory = computeParabolicTiming(
+      *mNonStraightLine, mMaxVelocity, mMaxAcceleration);
+  auto smoothedTrajectory = doShortcut(
+      *splineTrajectory,
+      testables,
+      mMaxVelocity,
+      mMaxAcceleration,
+      mRng,
+      0.5,
+      aikido::planner::parabolic::DEFAULT_CHECK_RESOLUTION,
+      aikido::planner::parabolic::DEFAULT_TOLERANCE,
+      clearances);
+
+  EXPECT_LT(smoothedTrajectory->getDuration(), splineTrajectory->getDuration());
+  for (const auto& obstacle : obstacles)
+  {
+    EXPECT_GT(obstacle->mNumChecks, 0);
+    EXPECT_GT(obstacle->mNumClearanceQueries, 0);
+  }
+
+  auto state = mStateSpace->createState();
+  smoothedTrajectory->evaluate(smoothedTrajectory->getStartTime(), state);
+  EXPECT_EIGEN_EQUAL(Vector2d(1., 1.), state.getValue(), mTolerance);
+  smoothedTrajectory->evaluate(smoothedTrajectory->getEndTime(), state);
+  EXPECT_EIGEN_EQUAL(Vector2d(4., 3.2), state.getValue(), mTolerance);
+
+  // The spliced shortcuts keep the trajectory continuous and out of the
+  // obstacle.
+  Eigen::VectorXd previous;
+  Eigen::VectorXd current;
+  aikido::common::StepSequence seq(
+      1e-4,
+      true,
+      true,
+      smoothedTrajectory->getStartTime(),
+      smoothedTrajectory->getEndTime());
+  for (double t : seq)
+  {
+    smoothedTrajectory->evaluate(t, state);
+    EXPECT_GT(obstacles.front()->getDistance(state), 0.);
+
+    mStateSpace->logMap(state, current);
+    if (previous.size() > 0)
+      EXPECT_LT((current - previous).norm(), 1e-2);
+    previous = current;
+  }
+}
+
+TEST_F(ParabolicSmootherTests, doShortcutParallel_NoTestables_Throws)
+{
+  std::vector<aikido::constraint::TestablePtr> testables;
+
+  auto splineTrajectory = computeParabolicTiming(
+      *mNonStraightLine, mMaxVelocity, mMaxAcceleration);
+  EXPECT_THROW(
+      doShortcut(
+          *splineTrajectory.get(),
+          testables,
+          mMaxVelocity,
+          mMaxAcceleration,
+          mRng,
+          mTimelimit),
+      std::invalid_argument);
+}
+
+TEST_F(ParabolicSmootherTests, doShortcutParallel_WrongClearances_Throws)
+{
+  std::vector<aikido::constraint::TestablePtr> testables;
+  for (int i = 0; i < 2; ++i)
+    testables.emplace_back(std::make_shared<Satisfied>(mStateSpace));
+  std::vector<aikido::constraint::ClearancePtr> clearances{
+      std::make_shared<DiskObstacle>(mStateSpace, Vector2d(2.5, 1.7), 0.2)};
+
+  auto splineTrajectory = computeParabolicTiming(
+      *mNonStraightLine, mMaxVelocity, mMaxAcceleration);
+  EXPECT_THROW(
+      doShortcut(
+          *splineTrajectory,
+          testables,
+          mMaxVelocity,
+          mMaxAcceleration,
+          mRng,
+          mTimelimit,
+          aikido::planner::parabolic::DEFAULT_CHECK_RESOLUTION,
+          aikido::planner::parabolic::DEFAULT_TOLERANCE,
+          clearances),
+      std::invalid_argument);
+}
+
+TEST_F(ParabolicSmootherTests, doShortcut_ZeroTimelimit_MatchesInput)
+{
+  std::shared_ptr<Satisfied> testable
+      = std::make_shared<Satisfied>(mStateSpace);
+
+  // Segments of a path with many ramps are found by binary search.
+  Interpolated zigZag(mStateSpace, mInterpolator);
+  auto state = mStateSpace->createState();
+  for (int i = 0; i < 50; ++i)
+  {
+    state.setValue(Vector2d(0.1 * i, 0.05 * (i % 2)));
+    zigZag.addWaypoint(i, state);
+  }
+
+  auto splineTrajectory
+      = computeParabolicTiming(zigZag, mMaxVelocity, mMaxAcceleration);
+  auto convertedTrajectory = doShortcut(
+      *splineTrajectory, testable, mMaxVelocity, mMaxAcceleration, mRng, 0.);
+
+  EXPECT_NEAR(
+      splineTrajectory->getDuration(),
+      convertedTrajectory->getDuration(),
+      mTolerance);
+
+  auto convertedState = mStateSpace->createState();
+  Eigen::VectorXd tangent, convertedTangent;
+  aikido::common::StepSequence seq(
+      1e-3,
+      true,
+      true,
+      splineTrajectory->getStartTime(),
+      splineTrajectory->getEndTime());
+  for (double t : seq)
+  {
+    splineTrajectory->evaluate(t, state);
+    convertedTrajectory->evaluate(t, convertedState);
+    EXPECT_EIGEN_EQUAL(
+        state.getValue(), convertedState.getValue(), mTolerance);
+
+    splineTrajectory->evaluateDerivative(t, 1, tangent);
+    convertedTrajectory->evaluateDerivative(t, 1, convertedTangent);
+    EXPECT_EIGEN_EQUAL(tangent, convertedTangent, mTolerance);
+  }
+}
+
+TEST_F(ParabolicSmootherTests, doShortcut_ManyWaypoints_IsContinuous)
+{
+  std::shared_ptr<Satisfied> testable
+      = std::make_shared<Satisfied>(mStateSpace);
+
+  Interpolated zigZag(mStateSpace, mInterpolator);
+  auto state = mStateSpace->createState();
+  for (int i = 0; i < 50; ++i)
+  {
+    state.setValue(Vector2d(0.1 * i, 0.05 * (i % 2)));
+    zigZag.addWaypoint(i, state);
+  }
+
+  auto splineTrajectory
+      = computeParabolicTiming(zigZag, mMaxVelocity, mMaxAcceleration);
+  auto smoothedTrajectory = doShortcut(
+      *splineTrajectory, testable, mMaxVelocity, mMaxAcceleration, mRng, 0.1);
+
+  EXPECT_LT(smoothedTrajectory->getDuration(), splineTrajectory->getDuration());
+
+  smoothedTrajectory->evaluate(smoothedTrajectory->getEndTime(), state);
+  EXPECT_EIGEN_EQUAL(Vector2d(4.9, 0.05), state.getValue(), mTolerance);
+
+  // Every shortcut is spliced at the times it was sampled at, so the output
+  // has no jumps in position or velocity.
+  auto before = mStateSpace->createState();
+  auto after = mStateSpace->createState();
+  Eigen::VectorXd beforeTangent, afterTangent;
+  for (std::size_t i = 1; i < smoothedTrajectory->getNumSegments(); ++i)
+  {
+    const double t = smoothedTrajectory->getWaypointTime(i);
+    smoothedTrajectory->evaluate(t - 1e-9, before);
+    smoothedTrajectory->evaluate(t + 1e-9, after);
+    EXPECT_EIGEN_EQUAL(before.getValue(), after.getValue(), mTolerance);
+
+    smoothedTrajectory->evaluateDerivative(t - 1e-9, 1, beforeTangent);
+    smoothedTrajectory->evaluateDerivative(t + 1e-9, 1, afterTangent);
+    EXPECT_EIGEN_EQUAL(beforeTangent, afterTangent, mTolerance);
+    for (int j = 0; j < 2; ++j)
+      EXPECT_LE(std::abs(afterTangent[j]), mMaxVelocity[j] + mTolerance);
+  }
+}
+
+TEST_F(ParabolicSmootherTests, doShortcut_WithClearance_AvoidsObstacle)
+{
+  // The obstacle is off the input path, but blocks shortcuts between nearby
+  // waypoints.
+  auto obstacle
+      = std::make_shared<DiskObstacle>(mStateSpace, Vector2d(2.5, 1.7), 0.2);
+
+  auto splineTrajectory = computeParabolicTiming(
+      *mNonStraightLine, mMaxVelocity, mMaxAcceleration);
+  auto smoothedTrajectory = doShortcut(
+      *splineTrajectory,
+      obstacle,
+      mMaxVelocity,
+      mMaxAcceleration,
+      mRng,
+      0.5,
+      aikido::planner::parabolic::DEFAULT_CHECK_RESOLUTION,
+      aikido::planner::parabolic::DEFAULT_TOLERANCE,
+      obstacle);
+
+  EXPECT_LT(smoothedTrajectory->getDuration(), splineTrajectory->getDuration());
+
+  auto state = mStateSpace->createState();
+  smoothedTrajectory->evaluate(smoothedTrajectory->getEndTime(), state);
+  EXPECT_EIGEN_EQUAL(Vector2d(4., 3.2), state.getValue(), mTolerance);
+
+  aikido::common::StepSequence seq(
+      1e-4,
+      true,
+      true,
+      smoothedTrajectory->getStartTime(),
+      smoothedTrajectory->getEndTime());
+  for (double t : seq)
+  {
+    smoothedTrajectory->evaluate(t, state);
+    EXPECT_GT(obstacle->getDistance(state), 0.);
+  }
+}
+
+TEST_F(ParabolicSmootherTests, doBlend_WithClearance_FewerChecks)
+{
+  auto obstacle
+      = std::make_shared<DiskObstacle>(mStateSpace, Vector2d(2.5, 1.7), 0.2);
+
+  auto splineTrajectory = computeParabolicTiming(
+      *mNonStraightLine, mMaxVelocity, mMaxAcceleration);
+
+  const double blendRadius = 0.5;
+  const int blendIterations = 100;
+  auto withoutClearance = doBlend(
+      *splineTrajectory,
+      obstacle,
+      mMaxVelocity,
+      mMaxAcceleration,
+      blendRadius,
+      blendIterations);
+  const int numChecksWithoutClearance = obstacle->mNumChecks;
+
+  obstacle->mNumChecks = 0;
+  auto withClearance = doBlend(
+      *splineTrajectory,
+      obstacle,
+      mMaxVelocity,
+      mMaxAcceleration,
+      blendRadius,
+      blendIterations,
+      aikido::planner::parabolic::DEFAULT_CHECK_RESOLUTION,
+      aikido::planner::parabolic::DEFAULT_TOLERANCE,
+      obstacle);
+
+  EXPECT_LT(10 * obstacle->mNumChecks, numChecksWithoutClearance);
+  EXPECT_NEAR(
+      withoutClearance->getDuration(), withClearance->getDuration(), 1e-3);
+
+  auto state = mStateSpace->createState();
+  aikido::common::StepSequence seq(
+      1e-4,
+      true,
+      true,
+      withClearance->getStartTime(),
+      withClearance->getEndTime());
+  for (double t : seq)
+  {
+    withClearance->evaluate(t, state);
+    EXPECT_GT(obstacle->getDistance(state), 0.);
+  }
+}
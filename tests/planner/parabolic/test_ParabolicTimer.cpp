@@ -379,6 +379,95 @@ TEST_F(ParabolicTimerTests, SupportedCartesianProduct_DoesNotThrow)
   });
 }
 
+TEST_F(ParabolicTimerTests, Batch_MatchesIndividualTiming)
+{
+  std::vector<aikido::trajectory::ConstInterpolatedPtr> inputTrajectories;
+  auto state = mStateSpace->createState();
+  for (int i = 0; i < 20; ++i)
+  {
+    auto inputTrajectory
+        = std::make_shared<Interpolated>(mStateSpace, mInterpolator);
+    for (int j = 0; j <= 1 + i % 5; ++j)
+    {
+      state.setValue(Vector2d(0.3 * j, 0.1 * i * (j % 2)));
+      inputTrajectory->addWaypoint(0.1 * i + j, state);
+    }
+    inputTrajectories.emplace_back(std::move(inputTrajectory));
+  }
+
+  auto timedTrajectories = computeParabolicTiming(
+      inputTrajectories, mMaxVelocity, mMaxAcceleration, 4);
+  ASSERT_EQ(inputTrajectories.size(), timedTrajectories.size());
+
+  auto expectedState = mStateSpace->createState();
+  for (std::size_t i = 0; i < inputTrajectories.size(); ++i)
+  {
+    auto expected = computeParabolicTiming(
+        *inputTrajectories[i], mMaxVelocity, mMaxAcceleration);
+    const auto& timedTrajectory = timedTrajectories[i];
+
+    EXPECT_EQ(expected->getNumSegments(), timedTrajectory->getNumSegments());
+    EXPECT_DOUBLE_EQ(expected->getStartTime(), timedTrajectory->getStartTime());
+    EXPECT_DOUBLE_EQ(expected->getEndTime(), timedTrajectory->getEndTime());
+
+    for (double t = expected->getStartTime(); t <= expected->getEndTime();
+         t += 0.1)
+    {
+      expected->evaluate(t, expectedState);
+      timedTrajectory->evaluate(t, state);
+      EXPECT_TRUE(expectedState.getValue().isApprox(state.getValue()));
+    }
+  }
+}
+
+TEST_F(ParabolicTimerTests, Batch_Empty_ReturnsEmpty)
+{
+  EXPECT_TRUE(
+      computeParabolicTiming(
+          std::vector<aikido::trajectory::ConstInterpolatedPtr>(),
+          mMaxVelocity,
+          mMaxAcceleration)
+          .empty());
+}
+
+TEST_F(ParabolicTimerTests, Batch_InvalidInput_Throws)
+{
+  using Trajectories = std::vector<aikido::trajectory::ConstInterpolatedPtr>;
+
+  EXPECT_THROW(
+      computeParabolicTiming(
+          Trajectories{mStraightLine, nullptr}, mMaxVelocity, mMaxAcceleration),
+      std::invalid_argument);
+
+  auto emptyTrajectory
+      = std::make_shared<Interpolated>(mStateSpace, mInterpolator);
+  EXPECT_THROW(
+      computeParabolicTiming(
+          Trajectories{mStraightLine, emptyTrajectory},
+          mMaxVelocity,
+          mMaxAcceleration),
+      std::invalid_argument);
+
+  auto otherStateSpace = std::make_shared<R2>();
+  auto otherTrajectory = std::make_shared<Interpolated>(
+      otherStateSpace,
+      std::make_shared<GeodesicInterpolator>(otherStateSpace));
+  auto state = otherStateSpace->createState();
+  state.setValue(Vector2d::Zero());
+  otherTrajectory->addWaypoint(0., state);
+  EXPECT_THROW(
+      computeParabolicTiming(
+          Trajectories{mStraightLine, otherTrajectory},
+          mMaxVelocity,
+          mMaxAcceleration),
+      std::invalid_argument);
+
+  EXPECT_THROW(
+      computeParabolicTiming(
+          Trajectories{mStraightLine}, Vector2d(1., 0.), mMaxAcceleration),
+      std::invalid_argument);
+}
+
 // TODO: Test what happens when two waypoints are coincident.
 // TODO: Add a test for different velocity limits.
 // TODO: Add a test where DOFs have different ramp transition points.
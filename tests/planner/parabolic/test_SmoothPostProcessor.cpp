@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <aikido/common/RNG.hpp>
+#include <aikido/common/StepSequence.hpp>
+#include <aikido/constraint/Clearance.hpp>
 #include <aikido/constraint/Satisfied.hpp>
 #include <aikido/planner/parabolic/ParabolicSmoother.hpp>
 #include <aikido/statespace/GeodesicInterpolator.hpp>
@@ -13,9 +15,65 @@ using aikido::statespace::GeodesicInterpolator;
 using aikido::statespace::R2;
 using aikido::statespace::StateSpacePtr;
 using aikido::constraint::Satisfied;
+using aikido::constraint::TestableOutcome;
 using aikido::common::cloneRNGFrom;
 using aikido::planner::parabolic::ParabolicSmoother;
 
+/// Disk obstacle in R2.
+class DiskObstacle : public aikido::constraint::Testable,
+                     public aikido::constraint::Clearance
+{
+public:
+  DiskObstacle(
+      StateSpacePtr _stateSpace, const Vector2d& _center, double _radius)
+    : mStateSpace(std::move(_stateSpace)), mCenter(_center), mRadius(_radius)
+  {
+  }
+
+  bool isSatisfied(
+      const aikido::statespace::StateSpace::State* _state,
+      TestableOutcome* _outcome = nullptr) const override
+  {
+    const bool satisfied = getDistance(_state) > 0.;
+
+    auto outcome = aikido::constraint::dynamic_cast_or_throw<
+        aikido::constraint::DefaultTestableOutcome>(_outcome);
+    if (outcome)
+      outcome->setSatisfiedFlag(satisfied);
+    return satisfied;
+  }
+
+  std::unique_ptr<TestableOutcome> createOutcome() const override
+  {
+    return std::unique_ptr<TestableOutcome>(
+        new aikido::constraint::DefaultTestableOutcome);
+  }
+
+  double getClearance(
+      const aikido::statespace::StateSpace::State* _state) const override
+  {
+    // The largest square centered at the state that fits outside the disk.
+    return std::max(0., getDistance(_state) / std::sqrt(2.));
+  }
+
+  StateSpacePtr getStateSpace() const override
+  {
+    return mStateSpace;
+  }
+
+  double getDistance(const aikido::statespace::StateSpace::State* _state) const
+  {
+    Eigen::VectorXd position;
+    mStateSpace->logMap(_state, position);
+    return (position - mCenter).norm() - mRadius;
+  }
+
+private:
+  StateSpacePtr mStateSpace;
+  Vector2d mCenter;
+  double mRadius;
+};
+
 class SmoothPostProcessorTests : public ::testing::Test
 {
 public:
@@ -213,3 +271,119 @@ TEST_F(SmoothPostProcessorTests, useShortcuttingAndBlend)
   double shortenTime = smoothedTrajectory->getDuration();
   EXPECT_TRUE(shortenTime < originTime);
 }
+
+TEST_F(SmoothPostProcessorTests, useParallelShortcuttingAndBlend)
+{
+  std::shared_ptr<Satisfied> testable
+      = std::make_shared<Satisfied>(mStateSpace);
+  bool enableShortcut = true;
+  bool enableBlend = true;
+
+  ParabolicSmoother testSmoothPostProcessor(
+      mMaxVelocity,
+      mMaxAcceleration,
+      enableShortcut,
+      enableBlend,
+      mTimelimit,
+      mBlendRadius,
+      mBlendIterations,
+      mFeasibilityCheckResolution,
+      mFeasibilityApproxTolerance);
+  testSmoothPostProcessor.setShortcutFeasibilityChecks(
+      {std::make_shared<Satisfied>(mStateSpace),
+       std::make_shared<Satisfied>(mStateSpace)});
+  EXPECT_EQ(2u, testSmoothPostProcessor.getShortcutFeasibilityChecks().size());
+
+  auto smoothedTrajectory
+      = testSmoothPostProcessor.postprocess(*mTrajectory, mRng, testable);
+
+  // Position.
+  auto state = mStateSpace->createState();
+  smoothedTrajectory->evaluate(smoothedTrajectory->getStartTime(), state);
+  auto startState = mStateSpace->createState();
+  mTrajectory->evaluate(mTrajectory->getStartTime(), startState);
+  EXPECT_EIGEN_EQUAL(startState.getValue(), state.getValue(), mTolerance);
+
+  smoothedTrajectory->evaluate(smoothedTrajectory->getEndTime(), state);
+  auto goalState = mStateSpace->createState();
+  mTrajectory->evaluate(mTrajectory->getEndTime(), goalState);
+  EXPECT_EIGEN_EQUAL(goalState.getValue(), state.getValue(), mTolerance);
+
+  double shortenLength = getLength(smoothedTrajectory.get());
+  EXPECT_TRUE(shortenLength < mOriginalTrajectoryLength);
+
+  double originTime = mTrajectory->getDuration();
+  double shortenTime = smoothedTrajectory->getDuration();
+  EXPECT_TRUE(shortenTime < originTime);
+}
+
+TEST_F(SmoothPostProcessorTests, setShortcutFeasibilityChecks_Invalid_Throws)
+{
+  ParabolicSmoother testSmoothPostProcessor(mMaxVelocity, mMaxAcceleration);
+  auto obstacle
+      = std::make_shared<DiskObstacle>(mStateSpace, Vector2d(2.5, 1.7), 0.2);
+
+  EXPECT_THROW(
+      testSmoothPostProcessor.setShortcutFeasibilityChecks(
+          {obstacle, obstacle}, {obstacle}),
+      std::invalid_argument);
+  EXPECT_THROW(
+      testSmoothPostProcessor.setShortcutFeasibilityChecks(
+          {obstacle}, {nullptr}),
+      std::invalid_argument);
+}
+
+TEST_F(SmoothPostProcessorTests, useParallelShortcuttingAndBlend_WithObstacle)
+{
+  // The obstacle is off the input path, but blocks shortcuts between nearby
+  // waypoints.
+  const Vector2d center(2.5, 1.7);
+  const double radius = 0.2;
+  auto testable = std::make_shared<DiskObstacle>(mStateSpace, center, radius);
+
+  ParabolicSmoother testSmoothPostProcessor(
+      mMaxVelocity,
+      mMaxAcceleration,
+      true,
+      true,
+      0.5,
+      mBlendRadius,
+      mBlendIterations,
+      mFeasibilityCheckResolution,
+      mFeasibilityApproxTolerance);
+  std::vector<aikido::constraint::TestablePtr> shortcutChecks;
+  std::vector<aikido::constraint::ClearancePtr> shortcutClearances;
+  for (int i = 0; i < 3; ++i)
+  {
+    auto obstacle = std::make_shared<DiskObstacle>(mStateSpace, center, radius);
+    shortcutChecks.emplace_back(obstacle);
+    shortcutClearances.emplace_back(obstacle);
+  }
+  testSmoothPostProcessor.setShortcutFeasibilityChecks(
+      shortcutChecks, shortcutClearances);
+  testSmoothPostProcessor.setFeasibilityClearance(testable);
+  EXPECT_EQ(
+      3u, testSmoothPostProcessor.getShortcutFeasibilityClearances().size());
+
+  auto smoothedTrajectory
+      = testSmoothPostProcessor.postprocess(*mTrajectory, mRng, testable);
+
+  auto state = mStateSpace->createState();
+  smoothedTrajectory->evaluate(smoothedTrajectory->getStartTime(), state);
+  EXPECT_EIGEN_EQUAL(Vector2d(1., 1.), state.getValue(), mTolerance);
+  smoothedTrajectory->evaluate(smoothedTrajectory->getEndTime(), state);
+  EXPECT_EIGEN_EQUAL(Vector2d(4., 3.2), state.getValue(), mTolerance);
+  EXPECT_LT(smoothedTrajectory->getDuration(), mTrajectory->getDuration());
+
+  aikido::common::StepSequence seq(
+      1e-4,
+      true,
+      true,
+      smoothedTrajectory->getStartTime(),
+      smoothedTrajectory->getEndTime());
+  for (double t : seq)
+  {
+    smoothedTrajectory->evaluate(t, state);
+    EXPECT_GT(testable->getDistance(state), 0.);
+  }
+}
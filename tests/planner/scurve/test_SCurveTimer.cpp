@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include <aikido/planner/parabolic/ParabolicTimer.hpp>
+#include <aikido/planner/scurve/SCurveTimer.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SO3.hpp>
+
+using Eigen::Vector2d;
+using Eigen::Vector3d;
+using aikido::trajectory::Interpolated;
+using aikido::trajectory::Spline;
+using aikido::statespace::GeodesicInterpolator;
+using aikido::statespace::R2;
+using aikido::statespace::SO3;
+using aikido::planner::parabolic::computeParabolicTiming;
+using aikido::planner::scurve::computeSCurveTiming;
+using aikido::planner::scurve::SCurveTimer;
+
+class SCurveTimerTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    mStateSpace = std::make_shared<R2>();
+    mMaxVelocity = Vector2d(1., 1.);
+    mMaxAcceleration = Vector2d(1., 1.);
+    mMaxJerk = Vector2d(2., 2.);
+
+    mInterpolator = std::make_shared<GeodesicInterpolator>(mStateSpace);
+    mStraightLine = std::make_shared<Interpolated>(mStateSpace, mInterpolator);
+
+    auto state = mStateSpace->createState();
+    state.setValue(Vector2d(0., 0.));
+    mStraightLine->addWaypoint(0., state);
+    state.setValue(Vector2d(10., 0.));
+    mStraightLine->addWaypoint(1., state);
+  }
+
+  /// Checks velocity, acceleration, and jerk of a timed trajectory on a fine
+  /// time grid.
+  void expectWithinLimits(const Spline& _trajectory)
+  {
+    Eigen::VectorXd tangentVector;
+    for (double t = _trajectory.getStartTime(); t <= _trajectory.getEndTime();
+         t += 1e-3)
+    {
+      _trajectory.evaluateDerivative(t, 1, tangentVector);
+      for (int i = 0; i < 2; ++i)
+        EXPECT_LE(std::abs(tangentVector[i]), mMaxVelocity[i] + 1e-9);
+
+      _trajectory.evaluateDerivative(t, 2, tangentVector);
+      for (int i = 0; i < 2; ++i)
+        EXPECT_LE(std::abs(tangentVector[i]), mMaxAcceleration[i] + 1e-9);
+
+      _trajectory.evaluateDerivative(t, 3, tangentVector);
+      for (int i = 0; i < 2; ++i)
+        EXPECT_LE(std::abs(tangentVector[i]), mMaxJerk[i] + 1e-9);
+    }
+  }
+
+  std::shared_ptr<R2> mStateSpace;
+  Vector2d mMaxVelocity;
+  Vector2d mMaxAcceleration;
+  Vector2d mMaxJerk;
+
+  std::shared_ptr<GeodesicInterpolator> mInterpolator;
+  std::shared_ptr<Interpolated> mStraightLine;
+};
+
+TEST_F(SCurveTimerTests, InputTrajectoryIsEmpty_Throws)
+{
+  Interpolated emptyTrajectory(mStateSpace, mInterpolator);
+
+  EXPECT_THROW(
+      {
+        computeSCurveTiming(
+            emptyTrajectory, mMaxVelocity, mMaxAcceleration, mMaxJerk);
+      },
+      std::invalid_argument);
+}
+
+TEST_F(SCurveTimerTests, InvalidLimits_Throws)
+{
+  EXPECT_THROW(
+      {
+        computeSCurveTiming(
+            *mStraightLine, Vector2d(1., 0.), mMaxAcceleration, mMaxJerk);
+      },
+      std::invalid_argument);
+  EXPECT_THROW(
+      {
+        computeSCurveTiming(
+            *mStraightLine, mMaxVelocity, Vector2d(-1., 1.), mMaxJerk);
+      },
+      std::invalid_argument);
+  EXPECT_THROW(
+      {
+        computeSCurveTiming(
+            *mStraightLine, mMaxVelocity, mMaxAcceleration, Vector2d(1., 0.));
+      },
+      std::invalid_argument);
+  EXPECT_THROW(
+      {
+        computeSCurveTiming(
+            *mStraightLine, mMaxVelocity, mMaxAcceleration, Vector3d::Ones());
+      },
+      std::invalid_argument);
+}
+
+TEST_F(SCurveTimerTests, StraightLine_SevenPhases)
+{
+  // Each jerk phase lasts a / j = 0.5 s and each constant acceleration phase
+  // lasts v / a - a / j = 0.5 s, covering 1.5 m per acceleration phase. The
+  // remaining 8.5 m are covered at 1 m/s.
+  auto timedTrajectory = computeSCurveTiming(
+      *mStraightLine, mMaxVelocity, mMaxAcceleration, mMaxJerk);
+
+  EXPECT_EQ(7, timedTrajectory->getNumSegments());
+  EXPECT_NEAR(11.5, timedTrajectory->getDuration(), 1e-9);
+
+  auto state = mStateSpace->createState();
+  timedTrajectory->evaluate(0., state);
+  EXPECT_TRUE(Vector2d(0., 0.).isApprox(state.getValue()));
+
+  timedTrajectory->evaluate(5.75, state);
+  EXPECT_TRUE(Vector2d(5., 0.).isApprox(state.getValue()));
+
+  timedTrajectory->evaluate(11.5, state);
+  EXPECT_TRUE(Vector2d(10., 0.).isApprox(state.getValue()));
+
+  Eigen::VectorXd tangentVector;
+  timedTrajectory->evaluateDerivative(5.75, 1, tangentVector);
+  EXPECT_TRUE(Vector2d(1., 0.).isApprox(tangentVector));
+
+  timedTrajectory->evaluateDerivative(0.75, 2, tangentVector);
+  EXPECT_TRUE(Vector2d(1., 0.).isApprox(tangentVector));
+
+  timedTrajectory->evaluateDerivative(10.75, 2, tangentVector);
+  EXPECT_TRUE(Vector2d(-1., 0.).isApprox(tangentVector));
+
+  expectWithinLimits(*timedTrajectory);
+}
+
+TEST_F(SCurveTimerTests, ShortLine_JerkLimitedOnly)
+{
+  Interpolated inputTrajectory(mStateSpace, mInterpolator);
+
+  auto state = mStateSpace->createState();
+  state.setValue(Vector2d(0., 0.));
+  inputTrajectory.addWaypoint(0., state);
+  state.setValue(Vector2d(0.1, 0.1));
+  inputTrajectory.addWaypoint(1., state);
+
+  // Neither the velocity nor the acceleration limit is reached, so the profile
+  // consists of four jerk phases of (d / 2j)^(1/3) s each.
+  auto timedTrajectory = computeSCurveTiming(
+      inputTrajectory, mMaxVelocity, mMaxAcceleration, mMaxJerk);
+
+  EXPECT_EQ(4, timedTrajectory->getNumSegments());
+  EXPECT_NEAR(
+      4. * std::cbrt(0.1 / (2. * 2.)), timedTrajectory->getDuration(), 1e-9);
+
+  expectWithinLimits(*timedTrajectory);
+}
+
+TEST_F(SCurveTimerTests, MultipleWaypoints_StopsWithContinuousAcceleration)
+{
+  Interpolated inputTrajectory(mStateSpace, mInterpolator);
+
+  auto state = mStateSpace->createState();
+  state.setValue(Vector2d(0., 0.));
+  inputTrajectory.addWaypoint(0., state);
+  state.setValue(Vector2d(1., 0.5));
+  inputTrajectory.addWaypoint(1., state);
+  inputTrajectory.addWaypoint(2., state);
+  state.setValue(Vector2d(2., -1.));
+  inputTrajectory.addWaypoint(3., state);
+
+  auto timedTrajectory = computeSCurveTiming(
+      inputTrajectory, mMaxVelocity, mMaxAcceleration, mMaxJerk);
+
+  timedTrajectory->evaluate(timedTrajectory->getEndTime(), state);
+  EXPECT_TRUE(Vector2d(2., -1.).isApprox(state.getValue()));
+
+  expectWithinLimits(*timedTrajectory);
+
+  // Acceleration is continuous, including across waypoints.
+  Eigen::VectorXd before, after;
+  for (double t = timedTrajectory->getStartTime() + 1e-3;
+       t < timedTrajectory->getEndTime();
+       t += 1e-3)
+  {
+    timedTrajectory->evaluateDerivative(t - 1e-6, 2, before);
+    timedTrajectory->evaluateDerivative(t + 1e-6, 2, after);
+    EXPECT_LE((after - before).norm(), 1e-5);
+  }
+
+  Eigen::VectorXd tangentVector;
+  timedTrajectory->evaluateDerivative(
+      timedTrajectory->getEndTime(), 2, tangentVector);
+  EXPECT_NEAR(0., tangentVector.norm(), 1e-9);
+}
+
+TEST_F(SCurveTimerTests, LargeJerkLimit_ApproachesParabolicTiming)
+{
+  auto timedTrajectory = computeSCurveTiming(
+      *mStraightLine, mMaxVelocity, mMaxAcceleration, Vector2d::Constant(1e6));
+  auto parabolicTrajectory
+      = computeParabolicTiming(*mStraightLine, mMaxVelocity, mMaxAcceleration);
+
+  EXPECT_NEAR(
+      parabolicTrajectory->getDuration(), timedTrajectory->getDuration(), 1e-5);
+}
+
+TEST_F(SCurveTimerTests, SO3_FollowsGeodesic)
+{
+  auto stateSpace = std::make_shared<SO3>();
+  auto interpolator = std::make_shared<GeodesicInterpolator>(stateSpace);
+  Interpolated inputTrajectory(stateSpace, interpolator);
+
+  auto state = stateSpace->createState();
+  state.setQuaternion(Eigen::Quaterniond::Identity());
+  inputTrajectory.addWaypoint(0., state);
+
+  const Eigen::Quaterniond goal(Eigen::AngleAxisd(M_PI_2, Vector3d::UnitX()));
+  state.setQuaternion(goal);
+  inputTrajectory.addWaypoint(1., state);
+
+  auto timedTrajectory = computeSCurveTiming(
+      inputTrajectory, Vector3d::Ones(), Vector3d::Ones(), Vector3d::Ones());
+
+  timedTrajectory->evaluate(timedTrajectory->getEndTime(), state);
+  EXPECT_TRUE(goal.isApprox(state.getQuaternion()));
+}
+
+TEST_F(SCurveTimerTests, PostProcessorMatchesFunction)
+{
+  SCurveTimer timer(mMaxVelocity, mMaxAcceleration, mMaxJerk);
+  aikido::common::RNGWrapper<std::mt19937> rng;
+
+  auto postprocessed = timer.postprocess(*mStraightLine, rng);
+  auto computed = computeSCurveTiming(
+      *mStraightLine, mMaxVelocity, mMaxAcceleration, mMaxJerk);
+
+  EXPECT_EQ(computed->getNumSegments(), postprocessed->getNumSegments());
+  EXPECT_DOUBLE_EQ(computed->getDuration(), postprocessed->getDuration());
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <aikido/planner/TrajectoryCompression.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include "../constraint/MockConstraints.hpp"
+
+using aikido::planner::compressTrajectory;
+using aikido::statespace::GeodesicInterpolator;
+using aikido::statespace::R2;
+using aikido::trajectory::Interpolated;
+using aikido::trajectory::Spline;
+using aikido::trajectory::Trajectory;
+using Eigen::Vector2d;
+
+class TrajectoryCompressionTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    mStateSpace = std::make_shared<R2>();
+    mInterpolator = std::make_shared<GeodesicInterpolator>(mStateSpace);
+    mTolerance = Vector2d(1e-3, 1e-2);
+  }
+
+  /// Expects that two trajectories deviate by at most mTolerance.
+  void expectWithinTolerance(
+      const Trajectory& original, const Trajectory& compressed)
+  {
+    EXPECT_DOUBLE_EQ(original.getStartTime(), compressed.getStartTime());
+    EXPECT_NEAR(original.getEndTime(), compressed.getEndTime(), 1e-9);
+
+    Eigen::MatrixXd originalPositions, compressedPositions;
+    original.sample(
+        original.getStartTime(),
+        original.getDuration() / 1000,
+        1001,
+        &originalPositions);
+    compressed.sample(
+        original.getStartTime(),
+        original.getDuration() / 1000,
+        1001,
+        &compressedPositions);
+
+    const Eigen::MatrixXd deviation
+        = (originalPositions - compressedPositions).cwiseAbs();
+    for (Eigen::Index i = 0; i < deviation.cols(); ++i)
+    {
+      EXPECT_LE(deviation(0, i), mTolerance[0] + 1e-9);
+      EXPECT_LE(deviation(1, i), mTolerance[1] + 1e-9);
+    }
+  }
+
+  /// Returns a densely sampled interpolated trajectory along a curve.
+  std::shared_ptr<Interpolated> createCurve(std::size_t numWaypoints)
+  {
+    auto trajectory
+        = std::make_shared<Interpolated>(mStateSpace, mInterpolator);
+    auto state = mStateSpace->createState();
+    for (std::size_t i = 0; i < numWaypoints; ++i)
+    {
+      const double t = 0.01 * i;
+      state.setValue(Vector2d(std::sin(t), 0.5 * t));
+      trajectory->addWaypoint(t, state);
+    }
+    return trajectory;
+  }
+
+  std::shared_ptr<R2> mStateSpace;
+  std::shared_ptr<GeodesicInterpolator> mInterpolator;
+  Eigen::VectorXd mTolerance;
+};
+
+TEST_F(TrajectoryCompressionTest, InvalidArguments_Throws)
+{
+  auto trajectory = createCurve(3);
+
+  EXPECT_THROW(
+      compressTrajectory(*trajectory, Eigen::Vector3d::Zero()),
+      std::invalid_argument);
+  EXPECT_THROW(
+      compressTrajectory(*trajectory, Vector2d(1., -1.)),
+      std::invalid_argument);
+  EXPECT_THROW(
+      compressTrajectory(
+          *trajectory,
+          mTolerance,
+          std::make_shared<PassingConstraint>(std::make_shared<R2>())),
+      std::invalid_argument);
+  EXPECT_THROW(
+      compressTrajectory(*trajectory, mTolerance, nullptr, 0.),
+      std::invalid_argument);
+}
+
+TEST_F(TrajectoryCompressionTest, Interpolated_DropsCollinearWaypoints)
+{
+  Interpolated trajectory(mStateSpace, mInterpolator);
+  auto state = mStateSpace->createState();
+  for (int i = 0; i <= 4; ++i)
+  {
+    state.setValue(Vector2d(i, 2. * i));
+    trajectory.addWaypoint(i, state);
+  }
+  state.setValue(Vector2d(4., 0.));
+  trajectory.addWaypoint(5., state);
+
+  auto compressed = compressTrajectory(trajectory, mTolerance);
+  ASSERT_EQ(3u, compressed->getNumWaypoints());
+  EXPECT_DOUBLE_EQ(0., compressed->getWaypointTime(0));
+  EXPECT_DOUBLE_EQ(4., compressed->getWaypointTime(1));
+  EXPECT_DOUBLE_EQ(5., compressed->getWaypointTime(2));
+  expectWithinTolerance(trajectory, *compressed);
+}
+
+TEST_F(TrajectoryCompressionTest, Interpolated_StaysWithinTolerance)
+{
+  auto trajectory = createCurve(300);
+
+  auto compressed = compressTrajectory(*trajectory, mTolerance);
+  EXPECT_LT(compressed->getNumWaypoints(), trajectory->getNumWaypoints() / 4);
+  expectWithinTolerance(*trajectory, *compressed);
+}
+
+TEST_F(TrajectoryCompressionTest, Interpolated_ConstraintFails_KeepsWaypoints)
+{
+  auto trajectory = createCurve(20);
+
+  auto failingConstraint = std::make_shared<FailingConstraint>(mStateSpace);
+  auto compressed
+      = compressTrajectory(*trajectory, mTolerance, failingConstraint);
+  EXPECT_EQ(trajectory->getNumWaypoints(), compressed->getNumWaypoints());
+
+  auto passingConstraint = std::make_shared<PassingConstraint>(mStateSpace);
+  compressed = compressTrajectory(*trajectory, mTolerance, passingConstraint);
+  EXPECT_LT(compressed->getNumWaypoints(), trajectory->getNumWaypoints());
+}
+
+TEST_F(TrajectoryCompressionTest, Spline_MergesSegmentsOfOnePolynomial)
+{
+  // Segments of the cubic p(t) = (t^3 - t, 2t^2 + 1) over [0, 2].
+  Spline trajectory(mStateSpace, 1.);
+  auto state = mStateSpace->createState();
+  for (int i = 0; i < 8; ++i)
+  {
+    const double t = 0.25 * i;
+    state.setValue(Vector2d(t * t * t - t, 2. * t * t + 1.));
+
+    Eigen::Matrix<double, 2, 4> coefficients;
+    coefficients << 0., 3. * t * t - 1., 3. * t, 1., 0., 4. * t, 2., 0.;
+    trajectory.addSegment(coefficients, 0.25, state);
+  }
+
+  auto compressed = compressTrajectory(trajectory, mTolerance);
+  EXPECT_EQ(1u, compressed->getNumSegments());
+  expectWithinTolerance(trajectory, *compressed);
+
+  // The velocity at the ends is preserved.
+  Eigen::VectorXd velocity;
+  compressed->evaluateDerivative(3., 1, velocity);
+  EXPECT_TRUE(velocity.isApprox(Vector2d(11., 8.)));
+}
+
+TEST_F(TrajectoryCompressionTest, Spline_StaysWithinTolerance)
+{
+  // Piecewise linear segments along a curve.
+  Spline trajectory(mStateSpace);
+  auto state = mStateSpace->createState();
+  for (int i = 0; i < 200; ++i)
+  {
+    const double t = 0.01 * i;
+    const Vector2d start(std::sin(t), 0.5 * t);
+    const Vector2d end(std::sin(t + 0.01), 0.5 * (t + 0.01));
+    state.setValue(start);
+
+    Eigen::Matrix<double, 2, 2> coefficients;
+    coefficients.col(0).setZero();
+    coefficients.col(1) = (end - start) / 0.01;
+    trajectory.addSegment(coefficients, 0.01, state);
+  }
+
+  auto compressed = compressTrajectory(trajectory, mTolerance);
+  EXPECT_LT(compressed->getNumSegments(), trajectory.getNumSegments() / 4);
+  expectWithinTolerance(trajectory, *compressed);
+
+  compressed = compressTrajectory(
+      trajectory, mTolerance, std::make_shared<FailingConstraint>(mStateSpace));
+  EXPECT_EQ(trajectory.getNumSegments(), compressed->getNumSegments());
+}
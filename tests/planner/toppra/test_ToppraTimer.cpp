@@ -0,0 +1,433 @@
+#include <gtest/gtest.h>
+#include <aikido/constraint/Testable.hpp>
+#include <aikido/planner/parabolic/ParabolicTimer.hpp>
+#include <aikido/planner/toppra/ToppraTimer.hpp>
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SO2.hpp>
+#include <aikido/statespace/SO3.hpp>
+
+using Eigen::Vector2d;
+using Eigen::Vector3d;
+using aikido::trajectory::Interpolated;
+using aikido::trajectory::Spline;
+using aikido::statespace::GeodesicInterpolator;
+using aikido::statespace::R2;
+using aikido::statespace::CartesianProduct;
+using aikido::statespace::SO2;
+using aikido::statespace::SO3;
+using aikido::statespace::StateSpace;
+using aikido::statespace::StateSpacePtr;
+using aikido::planner::parabolic::computeParabolicTiming;
+using aikido::planner::toppra::computeToppraTiming;
+using aikido::planner::toppra::ToppraTimer;
+using aikido::constraint::TestableOutcome;
+
+/// Returns the distance from \c _point to the polyline through \c _vertices.
+double distanceToPolyline(
+    const std::vector<Vector2d>& _vertices, const Eigen::VectorXd& _point)
+{
+  double distance = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i + 1 < _vertices.size(); ++i)
+  {
+    const Vector2d segment = _vertices[i + 1] - _vertices[i];
+    const double ratio = std::max(
+        0.,
+        std::min(
+            1., segment.dot(_point - _vertices[i]) / segment.squaredNorm()));
+    distance = std::min(
+        distance, (_vertices[i] + ratio * segment - _point).norm());
+  }
+  return distance;
+}
+
+/// Constraint in R2 that only accepts states on a polyline.
+class PolylineConstraint : public aikido::constraint::Testable
+{
+public:
+  PolylineConstraint(StateSpacePtr _stateSpace, std::vector<Vector2d> _vertices)
+    : mStateSpace(std::move(_stateSpace)), mVertices(std::move(_vertices))
+  {
+  }
+
+  bool isSatisfied(
+      const StateSpace::State* _state,
+      TestableOutcome* _outcome = nullptr) const override
+  {
+    Eigen::VectorXd position;
+    mStateSpace->logMap(_state, position);
+    const bool satisfied = distanceToPolyline(mVertices, position) < 1e-6;
+
+    auto outcome = aikido::constraint::dynamic_cast_or_throw<
+        aikido::constraint::DefaultTestableOutcome>(_outcome);
+    if (outcome)
+      outcome->setSatisfiedFlag(satisfied);
+    return satisfied;
+  }
+
+  std::unique_ptr<TestableOutcome> createOutcome() const override
+  {
+    return std::unique_ptr<TestableOutcome>(
+        new aikido::constraint::DefaultTestableOutcome);
+  }
+
+  StateSpacePtr getStateSpace() const override
+  {
+    return mStateSpace;
+  }
+
+private:
+  StateSpacePtr mStateSpace;
+  std::vector<Vector2d> mVertices;
+};
+
+class ToppraTimerTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    mStateSpace = std::make_shared<R2>();
+    mMaxVelocity = Eigen::Vector2d(1., 1.);
+    mMaxAcceleration = Eigen::Vector2d(1., 1.);
+
+    mInterpolator = std::make_shared<GeodesicInterpolator>(mStateSpace);
+
+    mStraightLine = std::make_shared<Interpolated>(mStateSpace, mInterpolator);
+    auto state = mStateSpace->createState();
+    state.setValue(Vector2d(1., 2.));
+    mStraightLine->addWaypoint(0., state);
+    state.setValue(Vector2d(3., 4.));
+    mStraightLine->addWaypoint(1., state);
+
+    mZigZag = std::make_shared<Interpolated>(mStateSpace, mInterpolator);
+    for (int i = 0; i < 9; ++i)
+    {
+      mZigZagVertices.emplace_back(0.5 * i, 0.1 * (i % 2));
+      state.setValue(mZigZagVertices.back());
+      mZigZag->addWaypoint(i, state);
+    }
+  }
+
+  /// Checks the velocity and acceleration of a timed trajectory on a fine
+  /// time grid. The limits are only enforced on the grid used by the retimer,
+  /// so a small tolerance is allowed in between.
+  void expectWithinLimits(const Spline& _trajectory, double _tolerance)
+  {
+    Eigen::VectorXd tangentVector;
+    for (double t = _trajectory.getStartTime(); t <= _trajectory.getEndTime();
+         t += 1e-3)
+    {
+      _trajectory.evaluateDerivative(t, 1, tangentVector);
+      for (int i = 0; i < 2; ++i)
+        EXPECT_LE(std::abs(tangentVector[i]), mMaxVelocity[i] + _tolerance);
+
+      _trajectory.evaluateDerivative(t, 2, tangentVector);
+      for (int i = 0; i < 2; ++i)
+        EXPECT_LE(
+            std::abs(tangentVector[i]), mMaxAcceleration[i] + _tolerance);
+    }
+  }
+
+  /// Returns the largest distance of a timed trajectory from the zigzag path,
+  /// sampled on a fine time grid.
+  double computeDeviationFromZigZag(const Spline& _trajectory)
+  {
+    auto state = mStateSpace->createState();
+    double deviation = 0.;
+    for (double t = _trajectory.getStartTime(); t <= _trajectory.getEndTime();
+         t += 1e-3)
+    {
+      _trajectory.evaluate(t, state);
+      deviation = std::max(
+          deviation, distanceToPolyline(mZigZagVertices, state.getValue()));
+    }
+    return deviation;
+  }
+
+  std::shared_ptr<R2> mStateSpace;
+  Eigen::Vector2d mMaxVelocity;
+  Eigen::Vector2d mMaxAcceleration;
+
+  std::shared_ptr<GeodesicInterpolator> mInterpolator;
+  std::shared_ptr<Interpolated> mStraightLine;
+  std::shared_ptr<Interpolated> mZigZag;
+  std::vector<Vector2d> mZigZagVertices;
+};
+
+TEST_F(ToppraTimerTests, InputTrajectoryIsEmpty_Throws)
+{
+  Interpolated emptyTrajectory(mStateSpace, mInterpolator);
+
+  EXPECT_THROW(
+      {
+        computeToppraTiming(emptyTrajectory, mMaxVelocity, mMaxAcceleration);
+      },
+      std::invalid_argument);
+}
+
+TEST_F(ToppraTimerTests, InputTrajectoryHasOneDistinctWaypoint_Throws)
+{
+  Interpolated inputTrajectory(mStateSpace, mInterpolator);
+
+  auto state = mStateSpace->createState();
+  state.setValue(Vector2d(1., 2.));
+  inputTrajectory.addWaypoint(0., state);
+  inputTrajectory.addWaypoint(1., state);
+
+  EXPECT_THROW(
+      {
+        computeToppraTiming(inputTrajectory, mMaxVelocity, mMaxAcceleration);
+      },
+      std::invalid_argument);
+}
+
+TEST_F(ToppraTimerTests, InvalidLimits_Throws)
+{
+  EXPECT_THROW(
+      {
+        computeToppraTiming(
+            *mStraightLine, Vector2d(1., 0.), mMaxAcceleration);
+      },
+      std::invalid_argument);
+  EXPECT_THROW(
+      {
+        computeToppraTiming(*mStraightLine, mMaxVelocity, Vector2d(1., -1.));
+      },
+      std::invalid_argument);
+  EXPECT_THROW(
+      {
+        computeToppraTiming(
+            *mStraightLine, Vector3d::Ones(), mMaxAcceleration);
+      },
+      std::invalid_argument);
+  EXPECT_THROW(
+      {
+        computeToppraTiming(
+            *mStraightLine, mMaxVelocity, mMaxAcceleration, 0.);
+      },
+      std::invalid_argument);
+  EXPECT_THROW(
+      {
+        computeToppraTiming(
+            *mStraightLine, mMaxVelocity, mMaxAcceleration, 1e-2, -1.);
+      },
+      std::invalid_argument);
+}
+
+TEST_F(ToppraTimerTests, UnsupportedStateSpace_Throws)
+{
+  auto stateSpace = std::make_shared<SO3>();
+  auto state = stateSpace->createState();
+
+  auto interpolator = std::make_shared<GeodesicInterpolator>(stateSpace);
+  Interpolated inputTrajectory(stateSpace, interpolator);
+
+  state.setQuaternion(Eigen::Quaterniond::Identity());
+  inputTrajectory.addWaypoint(0., state);
+
+  state.setQuaternion(
+      Eigen::Quaterniond(Eigen::AngleAxisd(M_PI_2, Vector3d::UnitX())));
+  inputTrajectory.addWaypoint(1., state);
+
+  EXPECT_THROW(
+      {
+        computeToppraTiming(
+            inputTrajectory, Vector3d::Ones(), Vector3d::Ones());
+      },
+      std::invalid_argument);
+}
+
+TEST_F(ToppraTimerTests, StraightLine_TrapezoidalProfile)
+{
+  // Each axis accelerates at 1 rad/s^2 for 1 s, coasts at 1 rad/s for 1 s,
+  // then decelerates at -1 rad/s^2 for 1 s.
+  auto timedTrajectory
+      = computeToppraTiming(*mStraightLine, mMaxVelocity, mMaxAcceleration);
+
+  EXPECT_NEAR(3., timedTrajectory->getDuration(), 1e-2);
+
+  auto state = mStateSpace->createState();
+  timedTrajectory->evaluate(timedTrajectory->getStartTime(), state);
+  EXPECT_TRUE(Vector2d(1., 2.).isApprox(state.getValue()));
+  timedTrajectory->evaluate(timedTrajectory->getEndTime(), state);
+  EXPECT_TRUE(Vector2d(3., 4.).isApprox(state.getValue()));
+
+  timedTrajectory->evaluate(1.5, state);
+  EXPECT_TRUE(Vector2d(2., 3.).isApprox(state.getValue(), 1e-2));
+
+  Eigen::VectorXd tangentVector;
+  timedTrajectory->evaluateDerivative(1.5, 1, tangentVector);
+  EXPECT_TRUE(Vector2d(1., 1.).isApprox(tangentVector, 1e-2));
+
+  expectWithinLimits(*timedTrajectory, 1e-6);
+}
+
+TEST_F(ToppraTimerTests, ZigZag_DoesNotStopAtWaypoints)
+{
+  auto timedTrajectory
+      = computeToppraTiming(*mZigZag, mMaxVelocity, mMaxAcceleration);
+  auto parabolicTrajectory
+      = computeParabolicTiming(*mZigZag, mMaxVelocity, mMaxAcceleration);
+
+  EXPECT_LT(timedTrajectory->getDuration(), parabolicTrajectory->getDuration());
+  expectWithinLimits(*timedTrajectory, 1e-2);
+
+  // The output only stops at the start and the end of the path.
+  timedTrajectory->visitWaypoints([&](
+      std::size_t index,
+      double /*time*/,
+      const StateSpace::State* /*state*/,
+      const Eigen::VectorXd& velocity) {
+    if (index > 0 && index < timedTrajectory->getNumSegments())
+      EXPECT_GT(velocity.norm(), 0.);
+  });
+
+  Eigen::VectorXd tangentVector;
+  timedTrajectory->evaluateDerivative(
+      timedTrajectory->getStartTime(), 1, tangentVector);
+  EXPECT_NEAR(0., tangentVector.norm(), 1e-9);
+  timedTrajectory->evaluateDerivative(
+      timedTrajectory->getEndTime(), 1, tangentVector);
+  EXPECT_NEAR(0., tangentVector.norm(), 1e-9);
+}
+
+TEST_F(ToppraTimerTests, ZigZag_StaysWithinMaxDeviation)
+{
+  for (const double maxDeviation : {0.05, 0.01, 0.})
+  {
+    auto timedTrajectory = computeToppraTiming(
+        *mZigZag,
+        mMaxVelocity,
+        mMaxAcceleration,
+        aikido::planner::toppra::DEFAULT_GRID_RESOLUTION,
+        maxDeviation);
+
+    EXPECT_LE(
+        computeDeviationFromZigZag(*timedTrajectory), maxDeviation + 1e-9);
+    expectWithinLimits(*timedTrajectory, 1e-2);
+
+    auto state = mStateSpace->createState();
+    timedTrajectory->evaluate(timedTrajectory->getEndTime(), state);
+    EXPECT_TRUE(mZigZagVertices.back().isApprox(state.getValue()));
+  }
+}
+
+TEST_F(ToppraTimerTests, VeryShortPath_ReachesEnd)
+{
+  for (const double length : {0.005, 0.01})
+  {
+    Interpolated inputTrajectory(mStateSpace, mInterpolator);
+
+    auto state = mStateSpace->createState();
+    state.setValue(Vector2d(1., 2.));
+    inputTrajectory.addWaypoint(0., state);
+    state.setValue(Vector2d(1. + length, 2.));
+    inputTrajectory.addWaypoint(1., state);
+
+    std::unique_ptr<Spline> timedTrajectory;
+    EXPECT_NO_THROW({
+      timedTrajectory = computeToppraTiming(
+          inputTrajectory, mMaxVelocity, mMaxAcceleration);
+    });
+    ASSERT_TRUE(timedTrajectory != nullptr);
+
+    EXPECT_GT(timedTrajectory->getDuration(), 0.);
+    timedTrajectory->evaluate(timedTrajectory->getStartTime(), state);
+    EXPECT_TRUE(Vector2d(1., 2.).isApprox(state.getValue()));
+    timedTrajectory->evaluate(timedTrajectory->getEndTime(), state);
+    EXPECT_TRUE(Vector2d(1. + length, 2.).isApprox(state.getValue()));
+  }
+}
+
+TEST_F(ToppraTimerTests, InterpolatedSplineEquivalence)
+{
+  auto spline = aikido::planner::parabolic::convertToSpline(*mZigZag);
+
+  auto timedInterpolated
+      = computeToppraTiming(*mZigZag, mMaxVelocity, mMaxAcceleration);
+  auto timedSpline
+      = computeToppraTiming(*spline, mMaxVelocity, mMaxAcceleration);
+
+  EXPECT_DOUBLE_EQ(timedInterpolated->getDuration(), timedSpline->getDuration());
+
+  auto state = mStateSpace->createState();
+  auto state2 = mStateSpace->createState();
+  for (double t = 0.; t < timedSpline->getEndTime(); t += 0.5)
+  {
+    timedInterpolated->evaluate(t, state);
+    timedSpline->evaluate(t, state2);
+    EXPECT_TRUE(state2.getValue().isApprox(state.getValue()));
+  }
+}
+
+TEST_F(ToppraTimerTests, SupportedCartesianProduct_FollowsGeodesic)
+{
+  auto stateSpace = std::make_shared<CartesianProduct>(
+      std::vector<StateSpacePtr>{
+          std::make_shared<R2>(), std::make_shared<SO2>(),
+      });
+  auto state = stateSpace->createState();
+
+  auto interpolator = std::make_shared<GeodesicInterpolator>(stateSpace);
+  Interpolated inputTrajectory(stateSpace, interpolator);
+
+  state.getSubStateHandle<R2>(0).setValue(Vector2d::Zero());
+  state.getSubStateHandle<SO2>(1).setAngle(3.);
+  inputTrajectory.addWaypoint(0., state);
+
+  state.getSubStateHandle<R2>(0).setValue(Vector2d::Zero());
+  state.getSubStateHandle<SO2>(1).setAngle(-3.);
+  inputTrajectory.addWaypoint(1., state);
+
+  auto timedTrajectory = computeToppraTiming(
+      inputTrajectory, Vector3d::Ones(), Vector3d::Ones());
+  auto parabolicTrajectory = computeParabolicTiming(
+      inputTrajectory, Vector3d::Ones(), Vector3d::Ones());
+
+  EXPECT_NEAR(
+      parabolicTrajectory->getDuration(), timedTrajectory->getDuration(), 1e-2);
+
+  timedTrajectory->evaluate(timedTrajectory->getEndTime(), state);
+  EXPECT_NEAR(-3., state.getSubStateHandle<SO2>(1).getAngle(), 1e-9);
+}
+
+TEST_F(ToppraTimerTests, PostProcessorMatchesFunction)
+{
+  ToppraTimer timer(mMaxVelocity, mMaxAcceleration);
+  aikido::common::RNGWrapper<std::mt19937> rng;
+
+  auto postprocessed = timer.postprocess(*mZigZag, rng);
+  auto computed
+      = computeToppraTiming(*mZigZag, mMaxVelocity, mMaxAcceleration);
+
+  EXPECT_EQ(computed->getNumSegments(), postprocessed->getNumSegments());
+  EXPECT_DOUBLE_EQ(computed->getDuration(), postprocessed->getDuration());
+}
+
+TEST_F(ToppraTimerTests, PostProcessorWithConstraint_FollowsGeodesic)
+{
+  ToppraTimer timer(mMaxVelocity, mMaxAcceleration);
+  aikido::common::RNGWrapper<std::mt19937> rng;
+  auto constraint
+      = std::make_shared<PolylineConstraint>(mStateSpace, mZigZagVertices);
+
+  auto blended = timer.postprocess(*mZigZag, rng);
+  auto postprocessed = timer.postprocess(*mZigZag, rng, constraint);
+
+  EXPECT_GT(computeDeviationFromZigZag(*blended), 1e-3);
+  EXPECT_LT(computeDeviationFromZigZag(*postprocessed), 1e-9);
+  EXPECT_GT(postprocessed->getDuration(), blended->getDuration());
+
+  // The output stops at the waypoints instead of blending them.
+  std::size_t numStops = 0;
+  postprocessed->visitWaypoints([&](
+      std::size_t /*index*/,
+      double /*time*/,
+      const StateSpace::State* /*state*/,
+      const Eigen::VectorXd& velocity) {
+    if (velocity.norm() < 1e-6)
+      ++numStops;
+  });
+  EXPECT_EQ(mZigZagVertices.size(), numStops);
+}
@@ -0,0 +1,108 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <dart/dart.hpp>
+#include <aikido/constraint/Satisfied.hpp>
+#include <aikido/planner/vectorfield/VectorFieldPlanner.hpp>
+#include <aikido/statespace/dart/MetaSkeletonStateSpace.hpp>
+
+// Measures how many integration steps planToEndEffectorOffset takes per
+// second on a 7-DOF arm. Not registered as a test; run it manually.
+
+using dart::dynamics::BodyNode;
+using dart::dynamics::BoxShape;
+using dart::dynamics::CollisionAspect;
+using dart::dynamics::DynamicsAspect;
+using dart::dynamics::RevoluteJoint;
+using dart::dynamics::Skeleton;
+using dart::dynamics::SkeletonPtr;
+using dart::dynamics::VisualAspect;
+using aikido::statespace::dart::MetaSkeletonStateSpace;
+
+namespace {
+
+SkeletonPtr createArm()
+{
+  const Eigen::Vector3d linkSize(0.1, 0.1, 0.2);
+
+  auto arm = Skeleton::create("arm");
+  BodyNode* parent = nullptr;
+  for (int i = 0; i < 7; ++i)
+  {
+    RevoluteJoint::Properties properties;
+    properties.mName = "joint" + std::to_string(i);
+    properties.mAxis
+        = (i % 2 == 0) ? Eigen::Vector3d::UnitX() : Eigen::Vector3d::UnitY();
+    properties.mPositionLowerLimits[0] = -M_PI;
+    properties.mPositionUpperLimits[0] = M_PI;
+    properties.mVelocityLowerLimits[0] = -4.0;
+    properties.mVelocityUpperLimits[0] = 4.0;
+    if (parent)
+      properties.mT_ParentBodyToJoint.translation()
+          = Eigen::Vector3d(0.0, 0.0, 0.5 * linkSize[2]);
+    properties.mT_ChildBodyToJoint.translation()
+        = Eigen::Vector3d(0.0, 0.0, -0.5 * linkSize[2]);
+
+    auto body = arm->createJointAndBodyNodePair<RevoluteJoint>(
+                       parent, properties)
+                    .second;
+    body->createShapeNodeWith<VisualAspect, CollisionAspect, DynamicsAspect>(
+        std::make_shared<BoxShape>(linkSize));
+    parent = body;
+  }
+  return arm;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  const int numPlans = (argc > 1) ? std::atoi(argv[1]) : 100;
+
+  auto arm = createArm();
+  auto stateSpace = std::make_shared<MetaSkeletonStateSpace>(arm.get());
+  auto endEffector = arm->getBodyNodes().back();
+  auto constraint = std::make_shared<aikido::constraint::Satisfied>(stateSpace);
+
+  Eigen::VectorXd startConfiguration(7);
+  startConfiguration << 2.13746, -0.663612, 1.77876, 1.87515, 2.58646,
+      -1.90034, -1.03533;
+  const Eigen::Vector3d direction = Eigen::Vector3d(1., 1., 0.).normalized();
+
+  std::size_t numSteps = 0;
+  int numFailures = 0;
+  const auto startTime = std::chrono::steady_clock::now();
+  for (int i = 0; i < numPlans; ++i)
+  {
+    arm->setPositions(startConfiguration);
+    auto trajectory = aikido::planner::vectorfield::planToEndEffectorOffset(
+        stateSpace,
+        arm,
+        endEffector,
+        constraint,
+        direction,
+        0.4,
+        0.42,
+        0.01,
+        0.15,
+        0.001,
+        1e-3,
+        1e-3,
+        std::chrono::duration<double>(5.));
+
+    if (trajectory)
+      numSteps += trajectory->getNumSegments();
+    else
+      ++numFailures;
+  }
+  const double elapsed = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - startTime)
+                             .count();
+
+  std::cout << "plans: " << numPlans << " (" << numFailures << " failed)\n"
+            << "time per plan: " << 1e3 * elapsed / numPlans << " ms\n"
+            << "steps per second: " << numSteps / elapsed << std::endl;
+  return 0;
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include <aikido/planner/vectorfield/BoundedLeastSquaresSolver.hpp>
+
+using aikido::planner::vectorfield::BoundedLeastSquaresSolver;
+
+namespace {
+
+double computeObjective(
+    const Eigen::MatrixXd& A,
+    const Eigen::VectorXd& b,
+    double damping,
+    const Eigen::VectorXd& x)
+{
+  return 0.5 * (A * x - b).squaredNorm()
+         + 0.5 * damping * damping * x.squaredNorm();
+}
+
+/// Finds the optimum by trying every assignment of variables to the lower
+/// bound, the upper bound, or neither.
+Eigen::VectorXd solveByEnumeration(
+    const Eigen::MatrixXd& A,
+    const Eigen::VectorXd& b,
+    double damping,
+    const Eigen::VectorXd& lower,
+    const Eigen::VectorXd& upper)
+{
+  const int n = A.cols();
+  int numAssignments = 1;
+  for (int i = 0; i < n; ++i)
+    numAssignments *= 3;
+
+  Eigen::MatrixXd H = A.transpose() * A;
+  H.diagonal().array() += damping * damping;
+  const Eigen::VectorXd g = A.transpose() * b;
+
+  Eigen::VectorXd best;
+  double bestObjective = std::numeric_limits<double>::infinity();
+  for (int assignment = 0; assignment < numAssignments; ++assignment)
+  {
+    Eigen::VectorXd x = Eigen::VectorXd::Zero(n);
+    std::vector<int> freeIndices;
+    int code = assignment;
+    for (int i = 0; i < n; ++i, code /= 3)
+    {
+      if (code % 3 == 0)
+        freeIndices.push_back(i);
+      else
+        x[i] = (code % 3 == 1) ? lower[i] : upper[i];
+    }
+
+    const int numFree = freeIndices.size();
+    Eigen::MatrixXd Hf(numFree, numFree);
+    Eigen::VectorXd gf(numFree);
+    for (int j = 0; j < numFree; ++j)
+    {
+      gf[j] = g[freeIndices[j]] - H.row(freeIndices[j]).dot(x);
+      for (int k = 0; k < numFree; ++k)
+        Hf(j, k) = H(freeIndices[j], freeIndices[k]);
+    }
+    if (numFree > 0)
+    {
+      const Eigen::VectorXd xf = Hf.ldlt().solve(gf);
+      for (int j = 0; j < numFree; ++j)
+        x[freeIndices[j]] = xf[j];
+    }
+
+    if ((x.array() < lower.array() - 1e-12).any()
+        || (x.array() > upper.array() + 1e-12).any())
+      continue;
+
+    const double objective = computeObjective(A, b, damping, x);
+    if (objective < bestObjective)
+    {
+      bestObjective = objective;
+      best = x;
+    }
+  }
+  return best;
+}
+
+} // namespace
+
+TEST(BoundedLeastSquaresSolver, NonPositiveDamping_Throws)
+{
+  EXPECT_THROW(BoundedLeastSquaresSolver(0.0), std::invalid_argument);
+  EXPECT_THROW(BoundedLeastSquaresSolver(-1.0), std::invalid_argument);
+}
+
+TEST(BoundedLeastSquaresSolver, InvalidArguments_Throws)
+{
+  BoundedLeastSquaresSolver solver;
+  const Eigen::MatrixXd A = Eigen::MatrixXd::Identity(3, 2);
+  const Eigen::VectorXd ones = Eigen::VectorXd::Ones(2);
+  Eigen::VectorXd x;
+
+  EXPECT_THROW(
+      solver.solve(A, Eigen::VectorXd::Ones(2), -ones, ones, x),
+      std::invalid_argument);
+  EXPECT_THROW(
+      solver.solve(
+          A, Eigen::VectorXd::Ones(3), -ones, Eigen::VectorXd::Ones(3), x),
+      std::invalid_argument);
+  EXPECT_THROW(
+      solver.solve(A, Eigen::VectorXd::Ones(3), ones, -ones, x),
+      std::invalid_argument);
+}
+
+TEST(BoundedLeastSquaresSolver, Unbounded_MatchesDampedPseudoinverse)
+{
+  BoundedLeastSquaresSolver solver(1e-2);
+  Eigen::MatrixXd A(6, 7);
+  A.setRandom();
+  const Eigen::VectorXd b = Eigen::VectorXd::LinSpaced(6, -1., 1.);
+  const double inf = std::numeric_limits<double>::infinity();
+
+  Eigen::VectorXd x;
+  ASSERT_TRUE(
+      solver.solve(
+          A,
+          b,
+          Eigen::VectorXd::Constant(7, -inf),
+          Eigen::VectorXd::Constant(7, inf),
+          x));
+
+  const Eigen::VectorXd expected
+      = A.transpose() * (A * A.transpose()
+                         + 1e-4 * Eigen::MatrixXd::Identity(6, 6))
+                            .ldlt()
+                            .solve(b);
+  EXPECT_TRUE(expected.isApprox(x, 1e-9));
+}
+
+TEST(BoundedLeastSquaresSolver, FixedVariable_StaysFixed)
+{
+  BoundedLeastSquaresSolver solver;
+  const Eigen::MatrixXd A = Eigen::MatrixXd::Identity(2, 2);
+  const Eigen::VectorXd b(Eigen::Vector2d(1., 1.));
+
+  Eigen::VectorXd x;
+  ASSERT_TRUE(
+      solver.solve(
+          A,
+          b,
+          Eigen::Vector2d(-1., 0.),
+          Eigen::Vector2d(1., 0.),
+          x));
+  EXPECT_NEAR(1., x[0], 1e-5);
+  EXPECT_DOUBLE_EQ(0., x[1]);
+}
+
+TEST(BoundedLeastSquaresSolver, RandomProblems_MatchEnumeration)
+{
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> distribution(-1., 1.);
+
+  // The same solver is reused across problem sizes.
+  BoundedLeastSquaresSolver solver(1e-2);
+  for (int trial = 0; trial < 200; ++trial)
+  {
+    const int numRows = 2 + trial % 5;
+    const int numVariables = 1 + trial % 6;
+
+    Eigen::MatrixXd A(numRows, numVariables);
+    Eigen::VectorXd b(numRows);
+    Eigen::VectorXd lower(numVariables);
+    Eigen::VectorXd upper(numVariables);
+    for (int i = 0; i < numRows; ++i)
+    {
+      b[i] = 3. * distribution(rng);
+      for (int j = 0; j < numVariables; ++j)
+        A(i, j) = distribution(rng);
+    }
+    for (int j = 0; j < numVariables; ++j)
+    {
+      // Bounds do not always contain the origin.
+      lower[j] = distribution(rng) - 0.5;
+      upper[j] = lower[j] + std::abs(distribution(rng));
+    }
+
+    Eigen::VectorXd x;
+    ASSERT_TRUE(solver.solve(A, b, lower, upper, x));
+    EXPECT_TRUE((x.array() >= lower.array()).all());
+    EXPECT_TRUE((x.array() <= upper.array()).all());
+
+    const Eigen::VectorXd expected
+        = solveByEnumeration(A, b, 1e-2, lower, upper);
+    EXPECT_NEAR(
+        computeObjective(A, b, 1e-2, expected),
+        computeObjective(A, b, 1e-2, x),
+        1e-9);
+    EXPECT_TRUE(expected.isApprox(x, 1e-6));
+  }
+}
@@ -3,8 +3,10 @@
 #include <dart/dart.hpp>
 #include <aikido/constraint/Testable.hpp>
 #include <aikido/distance/defaults.hpp>
+#include <aikido/planner/vectorfield/CompositeBodyNodePoseVectorField.hpp>
 #include <aikido/planner/vectorfield/MoveEndEffectorOffsetVectorField.hpp>
 #include <aikido/planner/vectorfield/VectorFieldPlanner.hpp>
+#include <aikido/planner/vectorfield/VectorFieldStream.hpp>
 #include <aikido/planner/vectorfield/VectorFieldUtil.hpp>
 #include <aikido/statespace/GeodesicInterpolator.hpp>
 #include <aikido/statespace/SO2.hpp>
@@ -141,13 +143,22 @@ public:
   /// the specified type
   SkeletonPtr createNLinkRobot()
   {
-    Vector3d dim(0.1, 0.1, 0.2);
-
     SkeletonPtr robot = Skeleton::create();
     // robot->disableSelfCollision();
 
+    addNLinkArm(robot, "");
+    return robot;
+  }
+
+  //==============================================================================
+  /// Adds a N link manipulator to a skeleton, as a new tree whose link and
+  /// joint names start with the given prefix. Returns its last link.
+  BodyNode* addNLinkArm(SkeletonPtr robot, const std::string& prefix)
+  {
+    Vector3d dim(0.1, 0.1, 0.2);
+
     // Create the first link, the joint with the ground and its shape
-    BodyNode::Properties node(BodyNode::AspectProperties("link0"));
+    BodyNode::Properties node(BodyNode::AspectProperties(prefix + "link0"));
     //  node.mInertia.setLocalCOM(Vector3d(0.0, 0.0, dim(2)/2.0));
     std::shared_ptr<Shape> shape(new BoxShape(dim));
 
@@ -156,7 +167,7 @@ public:
         robot,
         nullptr,
         node,
-        "joint0",
+        prefix + "joint0",
         0.0,
         -constantsd::pi(),
         constantsd::pi(),
@@ -182,8 +193,8 @@ public:
     {
       std::ostringstream ssLink;
       std::ostringstream ssJoint;
-      ssLink << "link" << i;
-      ssJoint << "joint" << i;
+      ssLink << prefix << "link" << i;
+      ssJoint << prefix << "joint" << i;
 
       node = BodyNode::Properties(BodyNode::AspectProperties(ssLink.str()));
       //    node.mInertia.setLocalCOM(Vector3d(0.0, 0.0, dim(2)/2.0));
@@ -225,7 +236,7 @@ public:
     // If finished, initialize the skeleton
     // addEndEffector(robot, parentNode, dim);
 
-    return robot;
+    return parentNode;
   }
 
   // Parameters
@@ -401,6 +412,83 @@ TEST_F(VectorFieldPlannerTest, PlanToEndEffectorOffsetTest)
   EXPECT_LE(movedDistance, maxDistance);
 }
 
+TEST_F(VectorFieldPlannerTest, StreamEndEffectorOffsetTest)
+{
+  using aikido::planner::vectorfield::MoveEndEffectorOffsetVectorField;
+  using aikido::planner::vectorfield::VectorFieldStream;
+
+  Eigen::Vector3d direction;
+  direction << 1., 1., 0.;
+  direction.normalize();
+  double minDistance = 0.4;
+  double maxDistance = 0.42;
+  double stepSize = 0.005;
+
+  mSkel->setPositions(mStartConfig);
+  auto startState = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(mStartConfig, startState);
+  Eigen::Vector3d startVec = mBodynode->getTransform().translation();
+
+  auto vectorField = std::make_shared<MoveEndEffectorOffsetVectorField>(
+      mStateSpace,
+      mSkel,
+      mBodynode,
+      direction,
+      minDistance,
+      maxDistance,
+      0.01,
+      0.15,
+      stepSize,
+      1e-3);
+
+  EXPECT_THROW(
+      VectorFieldStream(
+          vectorField, startState, mPassingConstraint, 0., 0.05, 1e-3),
+      std::invalid_argument);
+  EXPECT_THROW(
+      VectorFieldStream(
+          vectorField, startState, mPassingConstraint, stepSize, -1., 1e-3),
+      std::invalid_argument);
+
+  VectorFieldStream stream(
+      vectorField,
+      startState,
+      mPassingConstraint,
+      stepSize,
+      0.05,
+      1e-3,
+      VectorFieldStream::Method::RK4);
+
+  aikido::planner::PlanningResult result;
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd previousEnd = mStartConfig;
+  double previousEndTime = 0.0;
+  Eigen::VectorXd positions(mNumDof);
+  while (auto segment = stream.next(&result))
+  {
+    // Segments are released in order and join up.
+    EXPECT_DOUBLE_EQ(previousEndTime, segment->getStartTime());
+    segment->evaluate(segment->getStartTime(), state);
+    mStateSpace->convertStateToPositions(state, positions);
+    EXPECT_TRUE(previousEnd.isApprox(positions, 1e-6));
+
+    segment->evaluate(segment->getEndTime(), state);
+    mStateSpace->convertStateToPositions(state, previousEnd);
+    previousEndTime = segment->getEndTime();
+  }
+
+  EXPECT_TRUE(stream.isDone());
+  EXPECT_FALSE(stream.hasFailed());
+  EXPECT_LT(0u, stream.getNumSegments());
+  EXPECT_EQ(nullptr, stream.next());
+
+  mSkel->setPositions(previousEnd);
+  double movedDistance
+      = (mBodynode->getTransform().translation() - startVec).norm();
+  EXPECT_GE(movedDistance, minDistance);
+  EXPECT_LE(movedDistance, maxDistance);
+}
+
 TEST_F(VectorFieldPlannerTest, DirectionZeroVector)
 {
   using aikido::planner::vectorfield::MoveEndEffectorOffsetVectorField;
@@ -435,6 +523,260 @@ TEST_F(VectorFieldPlannerTest, DirectionZeroVector)
       std::runtime_error);
 }
 
+TEST_F(VectorFieldPlannerTest, EvaluateVelocity_IndependentOfSkeletonState)
+{
+  using aikido::planner::vectorfield::MoveEndEffectorOffsetVectorField;
+
+  MoveEndEffectorOffsetVectorField vectorField(
+      mStateSpace,
+      mSkel,
+      mBodynode,
+      Eigen::Vector3d::UnitZ(),
+      0.1,
+      0.2,
+      0.01,
+      0.15,
+      0.05,
+      1e-3);
+
+  auto startState = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(mStartConfig, startState);
+  auto otherState = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(
+      mStartConfig + Eigen::VectorXd::Constant(mNumDof, 0.1), otherState);
+
+  Eigen::VectorXd expected;
+  ASSERT_TRUE(vectorField.evaluateVelocity(startState, expected));
+
+  // Kinematics are cached between evaluations, so moving the skeleton behind
+  // the vector field's back must not change the result.
+  mSkel->setPositions(Eigen::VectorXd::Zero(mNumDof));
+  Eigen::VectorXd qd;
+  ASSERT_TRUE(vectorField.evaluateVelocity(startState, qd));
+  EXPECT_TRUE(expected.isApprox(qd));
+
+  ASSERT_TRUE(vectorField.evaluateVelocity(otherState, qd));
+  EXPECT_FALSE(expected.isApprox(qd));
+
+  ASSERT_TRUE(vectorField.evaluateVelocity(startState, qd));
+  EXPECT_TRUE(expected.isApprox(qd));
+}
+
+TEST_F(VectorFieldPlannerTest, CompositeVectorField_InvalidArguments_Throws)
+{
+  using aikido::planner::vectorfield::BodyNodePoseVectorFieldPtr;
+  using aikido::planner::vectorfield::CompositeBodyNodePoseVectorField;
+
+  std::vector<BodyNodePoseVectorFieldPtr> vectorFields;
+  EXPECT_THROW(
+      CompositeBodyNodePoseVectorField(vectorFields, 0.05, 1e-3),
+      std::invalid_argument);
+
+  vectorFields.push_back(nullptr);
+  EXPECT_THROW(
+      CompositeBodyNodePoseVectorField(vectorFields, 0.05, 1e-3),
+      std::invalid_argument);
+}
+
+TEST_F(VectorFieldPlannerTest, CompositeVectorField_JointLimitPadding)
+{
+  using aikido::planner::vectorfield::CompositeBodyNodePoseVectorField;
+  using aikido::planner::vectorfield::MoveEndEffectorOffsetVectorField;
+
+  mSkel->setPositions(mStartConfig);
+  auto vectorField = std::make_shared<MoveEndEffectorOffsetVectorField>(
+      mStateSpace,
+      mSkel,
+      mBodynode,
+      Eigen::Vector3d::UnitZ(),
+      0.1,
+      0.2,
+      0.01,
+      0.15,
+      0.05,
+      1e-3);
+
+  EXPECT_NO_THROW(CompositeBodyNodePoseVectorField({vectorField}, 0.05, 0.));
+  EXPECT_THROW(
+      CompositeBodyNodePoseVectorField({vectorField}, 0.05, -1e-3),
+      std::invalid_argument);
+}
+
+TEST_F(VectorFieldPlannerTest, CompositeVectorField_SingleField_MatchesField)
+{
+  using aikido::planner::vectorfield::CompositeBodyNodePoseVectorField;
+  using aikido::planner::vectorfield::MoveEndEffectorOffsetVectorField;
+
+  mSkel->setPositions(mStartConfig);
+  auto vectorField = std::make_shared<MoveEndEffectorOffsetVectorField>(
+      mStateSpace,
+      mSkel,
+      mBodynode,
+      Eigen::Vector3d::UnitZ(),
+      0.1,
+      0.2,
+      0.01,
+      0.15,
+      0.05,
+      1e-3);
+  CompositeBodyNodePoseVectorField composite({vectorField}, 0.05, 1e-3);
+  EXPECT_EQ(1u, composite.getNumVectorFields());
+  EXPECT_EQ(vectorField, composite.getVectorField(0));
+
+  auto state = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(mStartConfig, state);
+
+  Eigen::VectorXd expected;
+  Eigen::VectorXd qd;
+  ASSERT_TRUE(vectorField->evaluateVelocity(state, expected));
+  ASSERT_TRUE(composite.evaluateVelocity(state, qd));
+  EXPECT_TRUE(expected.isApprox(qd));
+  EXPECT_EQ(
+      vectorField->evaluateStatus(state), composite.evaluateStatus(state));
+}
+
+TEST_F(VectorFieldPlannerTest, CompositeVectorField_FollowVectorField)
+{
+  using aikido::planner::vectorfield::BodyNodePoseVectorFieldPtr;
+  using aikido::planner::vectorfield::CompositeBodyNodePoseVectorField;
+  using aikido::planner::vectorfield::MoveEndEffectorOffsetVectorField;
+
+  Eigen::Vector3d direction(1., 1., 0.);
+  direction.normalize();
+  double minDistance = 0.2;
+  double maxDistance = 0.22;
+  double initialStepSize = 0.001;
+
+  mSkel->setPositions(mStartConfig);
+  Eigen::Vector3d startVec = mBodynode->getTransform().translation();
+
+  // Both fields want the same motion, so they agree on every twist.
+  std::vector<BodyNodePoseVectorFieldPtr> vectorFields;
+  for (int i = 0; i < 2; ++i)
+  {
+    vectorFields.push_back(
+        std::make_shared<MoveEndEffectorOffsetVectorField>(
+            mStateSpace,
+            mSkel,
+            mBodynode,
+            direction,
+            minDistance,
+            maxDistance,
+            0.01,
+            0.15,
+            initialStepSize,
+            1e-3));
+  }
+  CompositeBodyNodePoseVectorField composite(
+      vectorFields, initialStepSize, 1e-3);
+
+  auto startState = mStateSpace->createState();
+  mStateSpace->convertPositionsToState(mStartConfig, startState);
+  aikido::planner::PlanningResult result;
+  auto traj = aikido::planner::vectorfield::followVectorField(
+      composite,
+      *startState,
+      *mPassingConstraint,
+      std::chrono::duration<double>(5.),
+      initialStepSize,
+      1e-3,
+      &result);
+  ASSERT_FALSE(traj == nullptr) << result.message;
+
+  auto endState = mStateSpace->createState();
+  traj->evaluate(traj->getEndTime(), endState);
+  mStateSpace->setState(mSkel.get(), endState);
+  double movedDistance
+      = (mBodynode->getTransform().translation() - startVec).norm();
+  EXPECT_GE(movedDistance, minDistance);
+  EXPECT_LE(movedDistance, maxDistance);
+}
+
+TEST_F(VectorFieldPlannerTest, CompositeVectorField_DifferentDistances)
+{
+  using aikido::planner::vectorfield::BodyNodePoseVectorFieldPtr;
+  using aikido::planner::vectorfield::CompositeBodyNodePoseVectorField;
+  using aikido::planner::vectorfield::MoveEndEffectorOffsetVectorField;
+
+  // Two arms that do not share joints, each moved by its own vector field.
+  SkeletonPtr robot = Skeleton::create();
+  BodyNodePtr leftHand = addNLinkArm(robot, "left_");
+  BodyNodePtr rightHand = addNLinkArm(robot, "right_");
+  auto stateSpace = std::make_shared<MetaSkeletonStateSpace>(robot.get());
+
+  Eigen::VectorXd startConfig(2 * mNumDof);
+  startConfig << mStartConfig, mStartConfig;
+  robot->setPositions(startConfig);
+  const Eigen::Vector3d leftStart = leftHand->getTransform().translation();
+  const Eigen::Vector3d rightStart = rightHand->getTransform().translation();
+
+  Eigen::Vector3d direction(1., 1., 0.);
+  direction.normalize();
+  const double leftMinDistance = 0.1;
+  const double leftMaxDistance = 0.12;
+  const double rightMinDistance = 0.2;
+  const double rightMaxDistance = 0.22;
+  const double initialStepSize = 0.001;
+
+  // The left arm reaches its goal region first and has to wait there for the
+  // right arm, instead of moving past it.
+  std::vector<BodyNodePoseVectorFieldPtr> vectorFields;
+  vectorFields.push_back(
+      std::make_shared<MoveEndEffectorOffsetVectorField>(
+          stateSpace,
+          robot,
+          leftHand,
+          direction,
+          leftMinDistance,
+          leftMaxDistance,
+          0.01,
+          0.15,
+          initialStepSize,
+          1e-3));
+  vectorFields.push_back(
+      std::make_shared<MoveEndEffectorOffsetVectorField>(
+          stateSpace,
+          robot,
+          rightHand,
+          direction,
+          rightMinDistance,
+          rightMaxDistance,
+          0.01,
+          0.15,
+          initialStepSize,
+          1e-3));
+  CompositeBodyNodePoseVectorField composite(
+      vectorFields, initialStepSize, 0.);
+
+  auto startState = stateSpace->createState();
+  stateSpace->convertPositionsToState(startConfig, startState);
+  PassingConstraint constraint(stateSpace);
+  aikido::planner::PlanningResult result;
+  auto traj = aikido::planner::vectorfield::followVectorField(
+      composite,
+      *startState,
+      constraint,
+      std::chrono::duration<double>(5.),
+      initialStepSize,
+      1e-3,
+      &result);
+  ASSERT_FALSE(traj == nullptr) << result.message;
+
+  auto endState = stateSpace->createState();
+  traj->evaluate(traj->getEndTime(), endState);
+  stateSpace->setState(robot.get(), endState);
+
+  const double leftDistance
+      = (leftHand->getTransform().translation() - leftStart).dot(direction);
+  EXPECT_GE(leftDistance, leftMinDistance);
+  EXPECT_LE(leftDistance, leftMaxDistance);
+
+  const double rightDistance
+      = (rightHand->getTransform().translation() - rightStart).dot(direction);
+  EXPECT_GE(rightDistance, rightMinDistance);
+  EXPECT_LE(rightDistance, rightMaxDistance);
+}
+
 TEST_F(VectorFieldPlannerTest, PlanToEndEffectorPoseTest)
 {
   using dart::math::eulerXYXToMatrix;
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/trajectory/ConcatenatedTrajectory.hpp>
+#include <aikido/trajectory/Spline.hpp>
+
+using aikido::statespace::R1;
+using aikido::trajectory::ConcatenatedTrajectory;
+using aikido::trajectory::ConstTrajectoryPtr;
+using aikido::trajectory::Spline;
+
+class ConcatenatedTrajectoryTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    mStateSpace = std::make_shared<R1>();
+    auto state = mStateSpace->createState();
+
+    Eigen::Matrix<double, 1, 2> linear;
+    linear << 0., 1.;
+    Eigen::Matrix<double, 1, 3> quadratic;
+    quadratic << 0., 0., 1.;
+
+    // Starts at time 1 and ends at time 3, in state 2.
+    state.setValue(Eigen::Matrix<double, 1, 1>(0.));
+    mFirst = std::make_shared<Spline>(mStateSpace, 1.);
+    mFirst->addSegment(linear, 2., state);
+
+    // Starts at time 10 and ends at time 11, in state 3.
+    state.setValue(Eigen::Matrix<double, 1, 1>(2.));
+    mSecond = std::make_shared<Spline>(mStateSpace, 10.);
+    mSecond->addSegment(quadratic, 1., state);
+  }
+
+  std::shared_ptr<R1> mStateSpace;
+  std::shared_ptr<Spline> mFirst;
+  std::shared_ptr<Spline> mSecond;
+};
+
+TEST_F(ConcatenatedTrajectoryTest, Constructor_InvalidTrajectories_Throws)
+{
+  EXPECT_THROW(
+      ConcatenatedTrajectory(std::vector<ConstTrajectoryPtr>{}),
+      std::invalid_argument);
+  EXPECT_THROW(
+      ConcatenatedTrajectory(std::vector<ConstTrajectoryPtr>{mFirst, nullptr}),
+      std::invalid_argument);
+
+  auto other = std::make_shared<Spline>(std::make_shared<R1>());
+  EXPECT_THROW(
+      ConcatenatedTrajectory(std::vector<ConstTrajectoryPtr>{mFirst, other}),
+      std::invalid_argument);
+}
+
+TEST_F(ConcatenatedTrajectoryTest, Evaluate_ShiftsLaterTrajectories)
+{
+  ConcatenatedTrajectory trajectory({mFirst, mSecond, mFirst});
+
+  EXPECT_EQ(3u, trajectory.getNumTrajectories());
+  EXPECT_EQ(mSecond, trajectory.getTrajectory(1));
+  EXPECT_THROW(trajectory.getTrajectory(3), std::domain_error);
+  EXPECT_DOUBLE_EQ(3., trajectory.getTrajectoryStartTime(1));
+  EXPECT_DOUBLE_EQ(4., trajectory.getTrajectoryStartTime(2));
+  EXPECT_EQ(mStateSpace, trajectory.getStateSpace());
+  EXPECT_EQ(2u, trajectory.getNumDerivatives());
+  EXPECT_DOUBLE_EQ(1., trajectory.getStartTime());
+  EXPECT_DOUBLE_EQ(6., trajectory.getEndTime());
+  EXPECT_DOUBLE_EQ(5., trajectory.getDuration());
+
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd tangentVector;
+
+  trajectory.evaluate(2., state);
+  EXPECT_DOUBLE_EQ(1., state.getValue()[0]);
+
+  // The boundary belongs to the earlier trajectory.
+  trajectory.evaluate(3., state);
+  EXPECT_DOUBLE_EQ(2., state.getValue()[0]);
+  trajectory.evaluateDerivative(3., 1, tangentVector);
+  EXPECT_DOUBLE_EQ(1., tangentVector[0]);
+
+  trajectory.evaluate(3.5, state);
+  EXPECT_DOUBLE_EQ(2.25, state.getValue()[0]);
+  trajectory.evaluateDerivative(3.5, 1, tangentVector);
+  EXPECT_DOUBLE_EQ(1., tangentVector[0]);
+  trajectory.evaluateDerivative(3.5, 2, tangentVector);
+  EXPECT_DOUBLE_EQ(2., tangentVector[0]);
+
+  trajectory.evaluate(5., state);
+  EXPECT_DOUBLE_EQ(1., state.getValue()[0]);
+  trajectory.evaluate(6., state);
+  EXPECT_DOUBLE_EQ(2., state.getValue()[0]);
+}
+
+TEST_F(ConcatenatedTrajectoryTest, Sample_MatchesEvaluate)
+{
+  ConcatenatedTrajectory trajectory({mFirst, mSecond});
+
+  Eigen::MatrixXd positions;
+  trajectory.sample(1., 0.5, 9, &positions);
+  ASSERT_EQ(9, positions.cols());
+
+  auto state = mStateSpace->createState();
+  for (Eigen::Index i = 0; i < positions.cols(); ++i)
+  {
+    trajectory.evaluate(1. + 0.5 * i, state);
+    EXPECT_DOUBLE_EQ(state.getValue()[0], positions(0, i));
+  }
+}
@@ -84,3 +84,62 @@ TEST_F(InterpolatedTest, EvaluateDerivative)
   traj->evaluateDerivative(6, 1, tangentVector);
   EXPECT_TRUE(tangentVector.isApprox(Eigen::Vector2d(5. / 4, -2. / 4)));
 }
+
+TEST_F(InterpolatedTest, EvaluateDerivative_OutsideTrajectory_ReturnsZero)
+{
+  Eigen::VectorXd tangentVector;
+
+  traj->evaluateDerivative(0.5, 1, tangentVector);
+  EXPECT_TRUE(tangentVector.isApprox(Eigen::Vector2d::Zero()));
+
+  traj->evaluateDerivative(1, 1, tangentVector);
+  EXPECT_TRUE(tangentVector.isApprox(Eigen::Vector2d::Zero()));
+
+  traj->evaluateDerivative(8, 1, tangentVector);
+  EXPECT_TRUE(tangentVector.isApprox(Eigen::Vector2d::Zero()));
+
+  traj->evaluateDerivative(7, 1, tangentVector);
+  EXPECT_TRUE(tangentVector.isApprox(Eigen::Vector2d(5. / 4, -2. / 4)));
+}
+
+TEST_F(InterpolatedTest, Evaluate_IsEmpty_Throws)
+{
+  Interpolated empty(rvss, interpolator);
+  auto istate = rvss->createState();
+  Eigen::VectorXd tangentVector;
+
+  EXPECT_THROW(empty.evaluate(0, istate), std::invalid_argument);
+  EXPECT_THROW(
+      empty.evaluateDerivative(0, 1, tangentVector), std::invalid_argument);
+}
+
+TEST_F(InterpolatedTest, Sample_MatchesEvaluate)
+{
+  const std::vector<double> times{0, 1, 1.5, 3, 4, 6.5, 7, 8, 2, 1.5};
+  Eigen::MatrixXd positions, velocities, accelerations;
+  traj->sample(times, &positions, &velocities, &accelerations);
+
+  ASSERT_EQ(2, positions.rows());
+  ASSERT_EQ(static_cast<Eigen::Index>(times.size()), positions.cols());
+  ASSERT_EQ(positions.rows(), velocities.rows());
+  ASSERT_EQ(positions.cols(), velocities.cols());
+  ASSERT_EQ(positions.rows(), accelerations.rows());
+  ASSERT_EQ(positions.cols(), accelerations.cols());
+
+  auto istate = rvss->createState();
+  Eigen::VectorXd tangentVector;
+  for (std::size_t i = 0; i < times.size(); ++i)
+  {
+    traj->evaluate(times[i], istate);
+    EXPECT_TRUE(positions.col(i).isApprox(rvss->getValue(istate)));
+
+    traj->evaluateDerivative(times[i], 1, tangentVector);
+    EXPECT_TRUE(velocities.col(i).isApprox(tangentVector));
+  }
+  EXPECT_TRUE(accelerations.isZero());
+
+  traj->sample(1, 0.5, 13, &positions);
+  EXPECT_EQ(13, positions.cols());
+  EXPECT_TRUE(positions.col(1).isApprox(Eigen::Vector2d(.75, .75)));
+  EXPECT_TRUE(positions.col(12).isApprox(Eigen::Vector2d(8, 1)));
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/GeodesicInterpolator.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SO2.hpp>
+#include <aikido/trajectory/InterpolatedBuilder.hpp>
+
+using namespace aikido::statespace;
+using aikido::trajectory::Interpolated;
+using aikido::trajectory::InterpolatedBuilder;
+using Eigen::Vector3d;
+
+class InterpolatedBuilderTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    mStateSpace = std::make_shared<CartesianProduct>(
+        std::vector<StateSpacePtr>{std::make_shared<R2>(),
+                                   std::make_shared<SO2>()});
+    mInterpolator = std::make_shared<GeodesicInterpolator>(mStateSpace);
+  }
+
+  Vector3d getWaypointPosition(std::size_t _index)
+  {
+    return Vector3d(_index, 2. * _index, 0.01 * _index);
+  }
+
+  std::shared_ptr<CartesianProduct> mStateSpace;
+  std::shared_ptr<GeodesicInterpolator> mInterpolator;
+};
+
+TEST_F(InterpolatedBuilderTest, AddWaypoint_NotIncreasing_Throws)
+{
+  InterpolatedBuilder builder(mStateSpace, mInterpolator);
+  auto state = mStateSpace->createState();
+  mStateSpace->getIdentity(state);
+
+  builder.addWaypoint(1., state);
+  EXPECT_THROW(builder.addWaypoint(1., state), std::invalid_argument);
+  EXPECT_THROW(builder.addWaypoint(0., state), std::invalid_argument);
+  EXPECT_EQ(1u, builder.getNumWaypoints());
+}
+
+TEST_F(InterpolatedBuilderTest, Finalize_MatchesAddWaypoint)
+{
+  InterpolatedBuilder builder(mStateSpace, mInterpolator, 4);
+  Interpolated expected(mStateSpace, mInterpolator);
+  auto state = mStateSpace->createState();
+
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    mStateSpace->expMap(getWaypointPosition(i), state);
+    builder.addWaypoint(0.5 * i, state);
+    expected.addWaypoint(0.5 * i, state);
+  }
+
+  auto trajectory = builder.finalize();
+  EXPECT_EQ(0u, builder.getNumWaypoints());
+  ASSERT_EQ(4u, trajectory->getNumWaypoints());
+  EXPECT_EQ(mStateSpace, trajectory->getStateSpace());
+  EXPECT_EQ(mInterpolator, trajectory->getInterpolator());
+
+  Eigen::VectorXd expectedPosition, position;
+  auto expectedState = mStateSpace->createState();
+  for (double t = 0.; t <= 1.5; t += 0.1)
+  {
+    expected.evaluate(t, expectedState);
+    trajectory->evaluate(t, state);
+    mStateSpace->logMap(expectedState, expectedPosition);
+    mStateSpace->logMap(state, position);
+    EXPECT_TRUE(expectedPosition.isApprox(position));
+  }
+}
+
+TEST_F(InterpolatedBuilderTest, AddWaypoint_BeyondReserved_KeepsWaypoints)
+{
+  InterpolatedBuilder builder(mStateSpace, mInterpolator, 3);
+  auto state = mStateSpace->createState();
+
+  const std::size_t numWaypoints = 100;
+  for (std::size_t i = 0; i < numWaypoints; ++i)
+  {
+    mStateSpace->expMap(getWaypointPosition(i), state);
+    builder.addWaypoint(i, state);
+  }
+
+  auto trajectory = builder.finalize();
+  ASSERT_EQ(numWaypoints, trajectory->getNumWaypoints());
+
+  // Waypoints added out of order are stored with the built ones.
+  mStateSpace->expMap(getWaypointPosition(numWaypoints), state);
+  trajectory->addWaypoint(-1., state);
+  EXPECT_DOUBLE_EQ(-1., trajectory->getWaypointTime(0));
+
+  Eigen::VectorXd position;
+  for (std::size_t i = 0; i < numWaypoints; ++i)
+  {
+    EXPECT_DOUBLE_EQ(i, trajectory->getWaypointTime(i + 1));
+    mStateSpace->logMap(trajectory->getWaypoint(i + 1), position);
+    EXPECT_TRUE(getWaypointPosition(i).isApprox(position));
+  }
+}
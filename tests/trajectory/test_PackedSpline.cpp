@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <aikido/statespace/CartesianProduct.hpp>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/statespace/SE2.hpp>
+#include <aikido/statespace/SO2.hpp>
+#include <aikido/trajectory/PackedSpline.hpp>
+
+using namespace aikido::statespace;
+using aikido::trajectory::PackedSpline;
+using aikido::trajectory::Spline;
+using Eigen::Vector3d;
+
+class PackedSplineTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    mStateSpace = std::make_shared<CartesianProduct>(
+        std::vector<StateSpacePtr>{std::make_shared<R2>(),
+                                   std::make_shared<SO2>()});
+
+    // Discontinuous at the segment boundaries, so evaluating the wrong segment
+    // at a boundary would be detected.
+    Eigen::Matrix<double, 3, 3> coefficients1;
+    coefficients1 << 0., 1., 2., 1., -1., 0.5, 0.5, 0., 1.;
+    Eigen::Matrix<double, 3, 4> coefficients2;
+    coefficients2 << 1., 0., 0., 1., 0., 2., 1., -1., 0.25, 1., 0., 3.;
+
+    auto state = mStateSpace->createState();
+    mStateSpace->expMap(Vector3d(1., 2., 3.), state);
+
+    mSpline = std::make_shared<Spline>(mStateSpace, 2.);
+    mSpline->addSegment(coefficients1, 1., state);
+    mStateSpace->expMap(Vector3d(-1., 0., -3.), state);
+    mSpline->addSegment(coefficients2, 0.5, state);
+    mSpline->addSegment(coefficients1, 2., state);
+  }
+
+  std::shared_ptr<CartesianProduct> mStateSpace;
+  std::shared_ptr<Spline> mSpline;
+};
+
+TEST_F(PackedSplineTest, Constructor_UnsupportedStateSpace_Throws)
+{
+  EXPECT_THROW(PackedSpline(nullptr), std::invalid_argument);
+  EXPECT_THROW(
+      PackedSpline(std::make_shared<SE2>(), 0.), std::invalid_argument);
+}
+
+TEST_F(PackedSplineTest, IsEmpty)
+{
+  PackedSpline trajectory(mStateSpace, 1.);
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd tangentVector;
+
+  EXPECT_EQ(0u, trajectory.getNumSegments());
+  EXPECT_DOUBLE_EQ(1., trajectory.getStartTime());
+  EXPECT_DOUBLE_EQ(1., trajectory.getEndTime());
+  EXPECT_DOUBLE_EQ(0., trajectory.getDuration());
+  EXPECT_THROW(trajectory.evaluate(1., state), std::logic_error);
+  EXPECT_THROW(
+      trajectory.evaluateDerivative(1., 1, tangentVector), std::logic_error);
+}
+
+TEST_F(PackedSplineTest, FromSpline_MatchesSpline)
+{
+  PackedSpline trajectory(*mSpline);
+
+  EXPECT_EQ(mSpline->getNumSegments(), trajectory.getNumSegments());
+  EXPECT_EQ(mSpline->getNumDerivatives(), trajectory.getNumDerivatives());
+  EXPECT_DOUBLE_EQ(mSpline->getStartTime(), trajectory.getStartTime());
+  EXPECT_DOUBLE_EQ(mSpline->getEndTime(), trajectory.getEndTime());
+  EXPECT_DOUBLE_EQ(mSpline->getDuration(), trajectory.getDuration());
+
+  auto state = mStateSpace->createState();
+  auto expectedState = mStateSpace->createState();
+  Eigen::VectorXd position, expectedPosition;
+  Eigen::VectorXd tangentVector, expectedTangentVector;
+
+  for (double t : {1., 2., 2.5, 3., 3.25, 3.5, 4., 5.5, 6.})
+  {
+    trajectory.evaluate(t, state);
+    mSpline->evaluate(t, expectedState);
+    mStateSpace->logMap(state, position);
+    mStateSpace->logMap(expectedState, expectedPosition);
+    EXPECT_TRUE(expectedPosition.isApprox(position)) << t;
+
+    for (int derivative = 1; derivative <= 4; ++derivative)
+    {
+      trajectory.evaluateDerivative(t, derivative, tangentVector);
+      mSpline->evaluateDerivative(t, derivative, expectedTangentVector);
+      EXPECT_TRUE(expectedTangentVector.isApprox(tangentVector))
+          << t << " " << derivative;
+    }
+  }
+}
+
+TEST_F(PackedSplineTest, ToSpline_MatchesSpline)
+{
+  const auto spline = PackedSpline(*mSpline).toSpline();
+
+  EXPECT_EQ(mSpline->getNumSegments(), spline->getNumSegments());
+  EXPECT_DOUBLE_EQ(mSpline->getStartTime(), spline->getStartTime());
+  EXPECT_DOUBLE_EQ(mSpline->getEndTime(), spline->getEndTime());
+
+  Eigen::MatrixXd positions, velocities, expectedPositions, expectedVelocities;
+  mSpline->sample(2., 0.1, 41, &expectedPositions, &expectedVelocities);
+  spline->sample(2., 0.1, 41, &positions, &velocities);
+  EXPECT_TRUE(expectedPositions.isApprox(positions));
+  EXPECT_TRUE(expectedVelocities.isApprox(velocities));
+}
+
+TEST_F(PackedSplineTest, View_MatchesSpline)
+{
+  const PackedSpline packed(*mSpline);
+  const auto numSegments = packed.getNumSegments();
+
+  std::vector<double> knotTimes;
+  std::vector<std::uint64_t> columnOffsets{0};
+  std::vector<double> coefficients;
+  for (std::size_t isegment = 0; isegment < numSegments; ++isegment)
+  {
+    const auto segment = packed.getSegmentCoefficients(isegment);
+    knotTimes.push_back(packed.getWaypointTime(isegment));
+    columnOffsets.push_back(columnOffsets.back() + segment.cols());
+    coefficients.insert(
+        coefficients.end(), segment.data(), segment.data() + segment.size());
+  }
+  knotTimes.push_back(packed.getEndTime());
+
+  PackedSpline trajectory(
+      mStateSpace,
+      knotTimes.data(),
+      columnOffsets.data(),
+      coefficients.data(),
+      numSegments);
+
+  EXPECT_EQ(numSegments, trajectory.getNumSegments());
+  EXPECT_EQ(mSpline->getNumDerivatives(), trajectory.getNumDerivatives());
+  EXPECT_DOUBLE_EQ(mSpline->getStartTime(), trajectory.getStartTime());
+  EXPECT_DOUBLE_EQ(mSpline->getEndTime(), trajectory.getEndTime());
+
+  auto expectedState = mStateSpace->createState();
+  auto actualState = mStateSpace->createState();
+  Eigen::VectorXd expected, actual;
+  for (double t = 1.5; t <= 6.; t += 0.25)
+  {
+    mSpline->evaluate(t, expectedState);
+    trajectory.evaluate(t, actualState);
+    mStateSpace->logMap(expectedState, expected);
+    mStateSpace->logMap(actualState, actual);
+    EXPECT_TRUE(expected.isApprox(actual)) << t;
+
+    mSpline->evaluateDerivative(t, 1, expected);
+    trajectory.evaluateDerivative(t, 1, actual);
+    EXPECT_TRUE(expected.isApprox(actual)) << t;
+  }
+
+  EXPECT_THROW(
+      trajectory.addSegment(Eigen::MatrixXd::Zero(3, 2), 1., actualState),
+      std::logic_error);
+  EXPECT_THROW(trajectory.reserve(1, 1), std::logic_error);
+}
+
+TEST_F(PackedSplineTest, View_InvalidArrays_Throws)
+{
+  const double knotTimes[] = {0., 1., 1.};
+  const std::uint64_t columnOffsets[] = {0, 1, 1};
+  const double coefficients[] = {0., 0., 0.};
+
+  EXPECT_THROW(
+      PackedSpline(mStateSpace, nullptr, columnOffsets, coefficients, 1),
+      std::invalid_argument);
+  EXPECT_THROW(
+      PackedSpline(mStateSpace, knotTimes, columnOffsets, coefficients, 2),
+      std::invalid_argument);
+
+  const double increasingKnotTimes[] = {0., 1., 2.};
+  EXPECT_THROW(
+      PackedSpline(
+          mStateSpace, increasingKnotTimes, columnOffsets, coefficients, 2),
+      std::invalid_argument);
+}
+
+TEST_F(PackedSplineTest, Sample_MatchesSpline)
+{
+  PackedSpline trajectory(*mSpline);
+
+  const std::vector<double> times = {1., 2., 2.5, 3., 3.25, 3.5, 6., 2.75};
+  Eigen::MatrixXd positions, velocities, accelerations;
+  Eigen::MatrixXd expectedPositions, expectedVelocities, expectedAccelerations;
+  trajectory.sample(times, &positions, &velocities, &accelerations);
+  mSpline->sample(
+      times, &expectedPositions, &expectedVelocities, &expectedAccelerations);
+
+  EXPECT_TRUE(expectedPositions.isApprox(positions));
+  EXPECT_TRUE(expectedVelocities.isApprox(velocities));
+  EXPECT_TRUE(expectedAccelerations.isApprox(accelerations));
+}
@@ -1,9 +1,11 @@
 #include <gtest/gtest.h>
 #include <aikido/statespace/Rn.hpp>
 #include <aikido/trajectory/Spline.hpp>
+#include <aikido/trajectory/SplineCursor.hpp>
 
 using namespace aikido::statespace;
 using aikido::trajectory::Spline;
+using aikido::trajectory::SplineCursor;
 using Eigen::Matrix2d;
 using Eigen::Vector2d;
 
@@ -199,6 +201,43 @@ TEST_F(SplineTest, getDuration_IsNotEmpty_ReturnsDuration)
   EXPECT_DOUBLE_EQ(24., trajectory.getDuration());
 }
 
+TEST_F(SplineTest, removeSegments_OutOfBounds_Throws)
+{
+  Spline trajectory(mStateSpace, 3.);
+  trajectory.addSegment(Vector2d(4., 5.), 11., mStartState);
+
+  EXPECT_THROW(trajectory.removeSegments(2), std::domain_error);
+}
+
+TEST_F(SplineTest, removeSegments_RemovesSuffix)
+{
+  Spline trajectory(mStateSpace, 3.);
+  trajectory.addSegment(Vector2d(4., 5.), 11., mStartState);
+  trajectory.addSegment(Vector2d(6., 7.), 13.);
+  trajectory.addSegment(Vector2d(8., 9.), 17.);
+
+  // Leave the segment hint on the last segment.
+  auto state = mStateSpace->createState();
+  trajectory.evaluate(trajectory.getEndTime(), state);
+
+  trajectory.removeSegments(1);
+  EXPECT_EQ(1u, trajectory.getNumSegments());
+  EXPECT_DOUBLE_EQ(11., trajectory.getDuration());
+  EXPECT_DOUBLE_EQ(14., trajectory.getEndTime());
+
+  trajectory.evaluate(20., state);
+  EXPECT_TRUE(Vector2d(5., 7.).isApprox(state.getValue()));
+
+  trajectory.addSegment(Vector2d(6., 7.), 2.);
+  EXPECT_DOUBLE_EQ(16., trajectory.getEndTime());
+  trajectory.evaluate(15., state);
+  EXPECT_TRUE(Vector2d(11., 14.).isApprox(state.getValue()));
+
+  trajectory.removeSegments(0);
+  EXPECT_EQ(0u, trajectory.getNumSegments());
+  EXPECT_DOUBLE_EQ(0., trajectory.getDuration());
+}
+
 TEST_F(SplineTest, evaluate_IsEmpty_Throws)
 {
   Spline trajectory(mStateSpace, 3.);
@@ -354,3 +393,278 @@ TEST_F(SplineTest, EvaluateDerivative_HigherOrder_ReturnsZero)
   trajectory.evaluateDerivative(7.5, 3, tangentVector);
   EXPECT_TRUE(Vector2d::Zero().isApprox(tangentVector));
 }
+
+TEST_F(SplineTest, visitWaypoints_IsEmpty_Throws)
+{
+  Spline trajectory(mStateSpace, 0.);
+
+  EXPECT_THROW(
+      {
+        trajectory.visitWaypoints(
+            [](std::size_t,
+               double,
+               const StateSpace::State*,
+               const Eigen::VectorXd&) {});
+      },
+      std::logic_error);
+}
+
+TEST_F(SplineTest, visitWaypoints_MatchesGetWaypoint)
+{
+  Eigen::Matrix<double, 2, 3> coefficients1, coefficients2, coefficients3;
+  coefficients1 << 0., 0., 1., 0., 1., 1.;
+  coefficients2 << 0., 1., 2., 0., 2., 2.;
+  coefficients3 << 0., 2., 3., 0., 3., 3.;
+
+  Spline trajectory(mStateSpace, 3.);
+  trajectory.addSegment(coefficients1, 1., mStartState);
+  trajectory.addSegment(coefficients2, 2.);
+  trajectory.addSegment(coefficients3, 3.);
+
+  auto expectedState = mStateSpace->createState();
+  Eigen::VectorXd expectedVelocity;
+  std::size_t numVisited = 0;
+
+  trajectory.visitWaypoints([&](
+      std::size_t index,
+      double time,
+      const StateSpace::State* state,
+      const Eigen::VectorXd& velocity) {
+    EXPECT_EQ(numVisited, index);
+    EXPECT_DOUBLE_EQ(trajectory.getWaypointTime(index), time);
+
+    trajectory.getWaypoint(index, expectedState);
+    EXPECT_TRUE(
+        mStateSpace->getValue(expectedState)
+            .isApprox(
+                mStateSpace->getValue(static_cast<const R2::State*>(state))));
+
+    trajectory.getWaypointDerivative(index, 1, expectedVelocity);
+    EXPECT_TRUE(expectedVelocity.isApprox(velocity));
+
+    ++numVisited;
+  });
+
+  EXPECT_EQ(trajectory.getNumWaypoints(), numVisited);
+}
+
+TEST_F(SplineTest, SplineCursor_IsEmpty_Throws)
+{
+  Spline trajectory(mStateSpace, 0.);
+  SplineCursor cursor(trajectory);
+
+  auto state = mStateSpace->createState();
+  EXPECT_THROW(cursor.evaluate(0., state), std::logic_error);
+}
+
+TEST_F(SplineTest, SplineCursor_MatchesEvaluate)
+{
+  // Discontinuous at the segment boundaries, so evaluating the wrong segment
+  // at a boundary would be detected.
+  Eigen::Matrix<double, 2, 3> coefficients1, coefficients2, coefficients3;
+  coefficients1 << 0., 0., 1., 0., 1., 1.;
+  coefficients2 << 1., 1., 2., 1., 2., 2.;
+  coefficients3 << 2., 2., 3., 2., 3., 3.;
+
+  Spline trajectory(mStateSpace, 3.);
+  trajectory.addSegment(coefficients1, 1., mStartState);
+  trajectory.addSegment(coefficients2, 2., mStartState);
+  trajectory.addSegment(coefficients3, 3., mStartState);
+
+  auto state = mStateSpace->createState();
+  auto expectedState = mStateSpace->createState();
+  Eigen::VectorXd tangentVector;
+  Eigen::VectorXd expectedTangentVector;
+
+  // Increasing times, including the boundaries and times outside of the
+  // trajectory.
+  const std::vector<double> times
+      = {2.5, 3., 3.5, 4., 4., 5.25, 6., 6.01, 8.5, 9., 10.};
+  SplineCursor cursor(trajectory);
+  for (double t : times)
+  {
+    cursor.evaluate(t, state);
+    trajectory.evaluate(t, expectedState);
+    EXPECT_TRUE(expectedState.getValue().isApprox(state.getValue())) << t;
+
+    cursor.evaluateDerivative(t, 1, tangentVector);
+    trajectory.evaluateDerivative(t, 1, expectedTangentVector);
+    EXPECT_TRUE(expectedTangentVector.isApprox(tangentVector)) << t;
+  }
+
+  // Going back restarts the search.
+  for (auto it = times.rbegin(); it != times.rend(); ++it)
+  {
+    cursor.evaluate(*it, state);
+    trajectory.evaluate(*it, expectedState);
+    EXPECT_TRUE(expectedState.getValue().isApprox(state.getValue())) << *it;
+  }
+
+  cursor.reset();
+  cursor.evaluate(6., state);
+  trajectory.evaluate(6., expectedState);
+  EXPECT_TRUE(expectedState.getValue().isApprox(state.getValue()));
+}
+
+TEST_F(SplineTest, SplineCursor_Reset_EvaluatesOtherSpline)
+{
+  Eigen::Matrix<double, 2, 2> coefficients1, coefficients2;
+  coefficients1 << 0., 1., 0., 1.;
+  coefficients2 << 2., 1., 3., 1.;
+
+  Spline trajectory1(mStateSpace, 0.);
+  trajectory1.addSegment(coefficients1, 1., mStartState);
+  trajectory1.addSegment(coefficients2, 1., mStartState);
+
+  Spline trajectory2(mStateSpace, 0.);
+  trajectory2.addSegment(coefficients2, 3., mStartState);
+
+  auto state = mStateSpace->createState();
+  auto expectedState = mStateSpace->createState();
+
+  SplineCursor cursor(trajectory1);
+  cursor.evaluate(1.5, state);
+  trajectory1.evaluate(1.5, expectedState);
+  EXPECT_TRUE(expectedState.getValue().isApprox(state.getValue()));
+
+  cursor.reset(trajectory2);
+  cursor.evaluate(0.5, state);
+  trajectory2.evaluate(0.5, expectedState);
+  EXPECT_TRUE(expectedState.getValue().isApprox(state.getValue()));
+
+  Spline otherSpaceTrajectory(std::make_shared<R2>(), 0.);
+  EXPECT_THROW(cursor.reset(otherSpaceTrajectory), std::invalid_argument);
+}
+
+TEST_F(SplineTest, evaluate_ManySegments_AnyOrder)
+{
+  // Follows x(t) = (t, -t) with segments of varying durations.
+  Spline trajectory(mStateSpace, 1.);
+  auto state = mStateSpace->createState();
+  Eigen::Matrix2d coefficients;
+  coefficients << 0., 1., 0., -1.;
+
+  double time = 1.;
+  std::vector<double> waypointTimes{time};
+  for (int i = 0; i < 1000; ++i)
+  {
+    const double duration = 0.01 * (1 + i % 7);
+    state.setValue(Vector2d(time, -time));
+    trajectory.addSegment(coefficients, duration, state);
+    time += duration;
+    waypointTimes.push_back(time);
+  }
+
+  EXPECT_EQ(1000u, trajectory.getNumSegments());
+  EXPECT_NEAR(time - 1., trajectory.getDuration(), 1e-9);
+  EXPECT_NEAR(time, trajectory.getEndTime(), 1e-9);
+  for (std::size_t i = 0; i < waypointTimes.size(); i += 97)
+    EXPECT_NEAR(waypointTimes[i], trajectory.getWaypointTime(i), 1e-9);
+
+  // Forwards, backwards and jumping around.
+  std::vector<double> times;
+  for (double t = 1.; t <= time; t += 0.0037)
+    times.push_back(t);
+  for (double t = time; t >= 1.; t -= 0.0051)
+    times.push_back(t);
+  for (int i = 0; i < 200; ++i)
+    times.push_back(1. + std::fmod(i * 7.123, time - 1.));
+
+  for (double t : times)
+  {
+    trajectory.evaluate(t, state);
+    EXPECT_TRUE(Vector2d(t, -t).isApprox(state.getValue(), 1e-9)) << t;
+  }
+}
+
+TEST_F(SplineTest, sample_MatchesEvaluate)
+{
+  Eigen::Matrix<double, 2, 4> coefficients1, coefficients2;
+  coefficients1 << 0., 0., 1., 1., 0., 1., 1., 0.;
+  coefficients2 << 1., 1., 2., 0., 1., 2., 2., 0.;
+
+  Spline trajectory(mStateSpace, 3.);
+  trajectory.addSegment(coefficients1, 1., mStartState);
+  trajectory.addSegment(coefficients2, 2., mStartState);
+
+  const std::vector<double> times = {2.5, 3., 3.5, 4., 5.25, 6., 7., 3.25};
+  Eigen::MatrixXd positions, velocities, accelerations;
+  trajectory.sample(times, &positions, &velocities, &accelerations);
+
+  ASSERT_EQ(2, positions.rows());
+  ASSERT_EQ(static_cast<Eigen::Index>(times.size()), positions.cols());
+
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd tangentVector;
+  for (std::size_t i = 0; i < times.size(); ++i)
+  {
+    trajectory.evaluate(times[i], state);
+    EXPECT_TRUE(state.getValue().isApprox(positions.col(i))) << times[i];
+
+    trajectory.evaluateDerivative(times[i], 1, tangentVector);
+    EXPECT_TRUE(tangentVector.isApprox(velocities.col(i))) << times[i];
+
+    trajectory.evaluateDerivative(times[i], 2, tangentVector);
+    EXPECT_TRUE(tangentVector.isApprox(accelerations.col(i))) << times[i];
+  }
+
+  Eigen::MatrixXd fixedRatePositions;
+  trajectory.sample(3., 0.5, 7, &fixedRatePositions, nullptr, nullptr);
+  ASSERT_EQ(7, fixedRatePositions.cols());
+  for (int i = 0; i < 7; ++i)
+  {
+    trajectory.evaluate(3. + 0.5 * i, state);
+    EXPECT_TRUE(state.getValue().isApprox(fixedRatePositions.col(i)));
+  }
+
+  EXPECT_THROW(
+      trajectory.sample(3., -0.5, 7, &fixedRatePositions),
+      std::invalid_argument);
+}
+
+TEST_F(SplineTest, sample_IsEmpty_Throws)
+{
+  Spline trajectory(mStateSpace, 0.);
+  Eigen::MatrixXd positions;
+  EXPECT_THROW(trajectory.sample(0., 0.1, 3, &positions), std::logic_error);
+}
+
+TEST_F(SplineTest, evaluateDerivative_Quintic_MatchesAnalytic)
+{
+  Eigen::Matrix<double, 2, 6> coefficients;
+  coefficients << 1., -2., 3., -4., 5., -6., 0.5, 0.25, -1., 2., 0.5, 1.;
+
+  Spline trajectory(mStateSpace, 1.);
+  trajectory.addSegment(coefficients, 2., mStartState);
+
+  const double t = 2.25;
+  const double s = t - 1.;
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd tangentVector;
+
+  // Sums d^n/ds^n (c_i s^i) = i! / (i - n)! c_i s^(i - n) term by term.
+  for (int derivative = 0; derivative <= 6; ++derivative)
+  {
+    Vector2d expected = Vector2d::Zero();
+    for (int i = derivative; i < coefficients.cols(); ++i)
+    {
+      double factor = std::pow(s, i - derivative);
+      for (int j = i - derivative + 1; j <= i; ++j)
+        factor *= j;
+      expected += factor * coefficients.col(i);
+    }
+
+    if (derivative == 0)
+    {
+      trajectory.evaluate(t, state);
+      EXPECT_TRUE(
+          (START_VALUE + expected).isApprox(state.getValue(), 1e-12));
+    }
+    else
+    {
+      trajectory.evaluateDerivative(t, derivative, tangentVector);
+      ASSERT_EQ(2, tangentVector.size());
+      EXPECT_TRUE(expected.isApprox(tangentVector, 1e-12)) << derivative;
+    }
+  }
+}
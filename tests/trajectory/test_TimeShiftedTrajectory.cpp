@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/trajectory/Spline.hpp>
+#include <aikido/trajectory/TimeShiftedTrajectory.hpp>
+
+using aikido::statespace::R1;
+using aikido::trajectory::Spline;
+using aikido::trajectory::TimeShiftedTrajectory;
+
+class TimeShiftedTrajectoryTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    mStateSpace = std::make_shared<R1>();
+    auto state = mStateSpace->createState();
+    state.setValue(Eigen::Matrix<double, 1, 1>(1.));
+
+    Eigen::Matrix<double, 1, 3> coefficients;
+    coefficients << 0., 2., 1.;
+
+    mSpline = std::make_shared<Spline>(mStateSpace, 1.);
+    mSpline->addSegment(coefficients, 2., state);
+  }
+
+  std::shared_ptr<R1> mStateSpace;
+  std::shared_ptr<Spline> mSpline;
+};
+
+TEST_F(TimeShiftedTrajectoryTest, Constructor_NullTrajectory_Throws)
+{
+  EXPECT_THROW(TimeShiftedTrajectory(nullptr, 1.), std::invalid_argument);
+}
+
+TEST_F(TimeShiftedTrajectoryTest, Evaluate_MatchesShiftedTrajectory)
+{
+  TimeShiftedTrajectory trajectory(mSpline, 3.);
+
+  EXPECT_EQ(mSpline, trajectory.getTrajectory());
+  EXPECT_EQ(mStateSpace, trajectory.getStateSpace());
+  EXPECT_EQ(2u, trajectory.getNumDerivatives());
+  EXPECT_DOUBLE_EQ(4., trajectory.getStartTime());
+  EXPECT_DOUBLE_EQ(6., trajectory.getEndTime());
+  EXPECT_DOUBLE_EQ(2., trajectory.getDuration());
+
+  auto expectedState = mStateSpace->createState();
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd expectedTangent, tangent;
+
+  for (double t = 1.; t <= 3.; t += 0.25)
+  {
+    mSpline->evaluate(t, expectedState);
+    trajectory.evaluate(t + 3., state);
+    EXPECT_DOUBLE_EQ(expectedState.getValue()[0], state.getValue()[0]);
+
+    mSpline->evaluateDerivative(t, 1, expectedTangent);
+    trajectory.evaluateDerivative(t + 3., 1, tangent);
+    EXPECT_TRUE(expectedTangent.isApprox(tangent));
+  }
+}
+
+TEST_F(TimeShiftedTrajectoryTest, Sample_MatchesShiftedTrajectory)
+{
+  TimeShiftedTrajectory trajectory(mSpline, -1.);
+
+  Eigen::MatrixXd expectedPositions, expectedVelocities;
+  mSpline->sample(1., 0.5, 5, &expectedPositions, &expectedVelocities);
+
+  Eigen::MatrixXd positions, velocities;
+  trajectory.sample(0., 0.5, 5, &positions, &velocities);
+
+  EXPECT_TRUE(expectedPositions.isApprox(positions));
+  EXPECT_TRUE(expectedVelocities.isApprox(velocities));
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <aikido/statespace/Rn.hpp>
+#include <aikido/trajectory/Spline.hpp>
+#include <aikido/trajectory/TrajectorySlice.hpp>
+
+using aikido::statespace::R1;
+using aikido::trajectory::Spline;
+using aikido::trajectory::TrajectorySlice;
+
+class TrajectorySliceTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    mStateSpace = std::make_shared<R1>();
+    auto state = mStateSpace->createState();
+    state.setValue(Eigen::Matrix<double, 1, 1>(1.));
+
+    Eigen::Matrix<double, 1, 3> coefficients;
+    coefficients << 0., 2., 1.;
+
+    mSpline = std::make_shared<Spline>(mStateSpace, 1.);
+    mSpline->addSegment(coefficients, 2., state);
+    mSpline->addSegment(coefficients, 1., state);
+  }
+
+  std::shared_ptr<R1> mStateSpace;
+  std::shared_ptr<Spline> mSpline;
+};
+
+TEST_F(TrajectorySliceTest, Constructor_InvalidWindow_Throws)
+{
+  EXPECT_THROW(TrajectorySlice(nullptr, 1., 2.), std::invalid_argument);
+  EXPECT_THROW(TrajectorySlice(mSpline, 2., 1.5), std::invalid_argument);
+  EXPECT_THROW(TrajectorySlice(mSpline, 2., 2.), std::invalid_argument);
+  EXPECT_THROW(TrajectorySlice(mSpline, 0.5, 2.), std::invalid_argument);
+  EXPECT_THROW(TrajectorySlice(mSpline, 1.5, 4.5), std::invalid_argument);
+}
+
+TEST_F(TrajectorySliceTest, Evaluate_InsideWindow_MatchesTrajectory)
+{
+  TrajectorySlice trajectory(mSpline, 2., 3.5);
+
+  EXPECT_EQ(mSpline, trajectory.getTrajectory());
+  EXPECT_EQ(mStateSpace, trajectory.getStateSpace());
+  EXPECT_EQ(2u, trajectory.getNumDerivatives());
+  EXPECT_DOUBLE_EQ(2., trajectory.getStartTime());
+  EXPECT_DOUBLE_EQ(3.5, trajectory.getEndTime());
+  EXPECT_DOUBLE_EQ(1.5, trajectory.getDuration());
+
+  auto expectedState = mStateSpace->createState();
+  auto state = mStateSpace->createState();
+  Eigen::VectorXd expectedTangent, tangent;
+
+  for (double t = 2.; t <= 3.5; t += 0.25)
+  {
+    mSpline->evaluate(t, expectedState);
+    trajectory.evaluate(t, state);
+    EXPECT_DOUBLE_EQ(expectedState.getValue()[0], state.getValue()[0]);
+
+    mSpline->evaluateDerivative(t, 1, expectedTangent);
+    trajectory.evaluateDerivative(t, 1, tangent);
+    EXPECT_TRUE(expectedTangent.isApprox(tangent));
+  }
+}
+
+TEST_F(TrajectorySliceTest, Evaluate_OutsideWindow_ClampsToWindow)
+{
+  TrajectorySlice trajectory(mSpline, 2., 3.5);
+
+  auto expectedState = mStateSpace->createState();
+  auto state = mStateSpace->createState();
+
+  mSpline->evaluate(2., expectedState);
+  trajectory.evaluate(1., state);
+  EXPECT_DOUBLE_EQ(expectedState.getValue()[0], state.getValue()[0]);
+
+  mSpline->evaluate(3.5, expectedState);
+  trajectory.evaluate(4., state);
+  EXPECT_DOUBLE_EQ(expectedState.getValue()[0], state.getValue()[0]);
+
+  Eigen::MatrixXd expectedPositions;
+  mSpline->sample(std::vector<double>{2., 3., 3.5}, &expectedPositions);
+
+  Eigen::MatrixXd positions;
+  trajectory.sample(std::vector<double>{0., 3., 5.}, &positions);
+  EXPECT_TRUE(expectedPositions.isApprox(positions));
+}